@@ -1,10 +1,166 @@
 #include <iostream>
 #include <chrono>
+#include <map>
+#include <set>
 #include <string>
+#include "AutoTuner.hpp"
+#include "Mesh.hpp"
 #include "SceneLoader.hpp"
+#include "SceneStats.hpp"
+
+/**
+ * Arguments: scène, image de sortie (optionnelle), puis options qui remplacent
+ * les clés de la scène pour comparer les structures sans éditer le fichier
+ *   --accelerator none|aabb|bvh|grid|kdtree   --mesh-accelerator ...
+ *   --builder median|sah|lbvh|sbvh   --bvh-width 2|4|8   --bvh-quantization 0|8|16
+ * maillages aplatis dans la structure de la scène (voir Scene::flattenMeshes)
+ *   --flatten-meshes
+ * sphères regroupées et testées par 4 (voir Scene::packSpheres)
+ *   --pack-spheres
+ * objets rangés par type, sans appel virtuel (voir Scene::typedPrimitives)
+ *   --typed-primitives
+ * et réglage automatique des structures (voir AutoTuner)
+ *   --autotune   --tune-cache <fichier>
+ */
+struct Arguments
+{
+  std::string path;
+  std::string outpath = "image.png";
+  std::map<std::string, std::string> overrides;
+  bool autotune = false;
+  std::string tuneCache = "autotune-cache.json";
+};
+
+static Arguments parseArguments(int argc, char *argv[], int first)
+{
+  Arguments args;
+  const std::map<std::string, std::string> optionKeys = {
+      {"--accelerator", "accelerator"},
+      {"--mesh-accelerator", "meshAccelerator"},
+      {"--builder", "builder"},
+      {"--bvh-width", "bvhWidth"},
+      {"--bvh-quantization", "bvhQuantization"}};
+
+  int positional = 0;
+  for (int i = first; i < argc; ++i)
+  {
+    std::string arg = argv[i];
+    auto option = optionKeys.find(arg);
+    if (option != optionKeys.end())
+    {
+      if (i + 1 >= argc)
+      {
+        std::cerr << "[ERROR] Missing value for " << arg << std::endl;
+        exit(1);
+      }
+      args.overrides[option->second] = argv[++i];
+    }
+    else if (arg == "--flatten-meshes")
+    {
+      args.overrides["flattenMeshes"] = "true";
+    }
+    else if (arg == "--pack-spheres")
+    {
+      args.overrides["packSpheres"] = "true";
+    }
+    else if (arg == "--typed-primitives")
+    {
+      args.overrides["typedPrimitives"] = "true";
+    }
+    else if (arg == "--autotune")
+    {
+      args.autotune = true;
+    }
+    else if (arg == "--tune-cache")
+    {
+      if (i + 1 >= argc)
+      {
+        std::cerr << "[ERROR] Missing value for " << arg << std::endl;
+        exit(1);
+      }
+      args.tuneCache = argv[++i];
+    }
+    else if (arg.rfind("--", 0) == 0)
+    {
+      // Option mal orthographiée: ne pas la prendre pour l'image de sortie
+      std::cerr << "[ERROR] Unknown option " << arg << std::endl;
+      exit(1);
+    }
+    else if (positional++ == 0)
+    {
+      args.path = arg;
+    }
+    else
+    {
+      args.outpath = arg;
+    }
+  }
+  return args;
+}
+
+/**
+ * Durée cumulée des constructions des structures des meshes, une fois par géométrie partagée
+ */
+static double meshBuildTime(Scene &scene)
+{
+  double seconds = 0;
+  std::set<MeshGeometry *> seen;
+  for (SceneObject *object : scene.getObjects())
+  {
+    Mesh *mesh = dynamic_cast<Mesh *>(object);
+    if (mesh != nullptr && mesh->getGeometry() && seen.insert(mesh->getGeometry().get()).second)
+    {
+      seconds += mesh->getGeometry()->getBuildTime();
+    }
+  }
+  return seconds;
+}
+
+/**
+ * raytracer stats <scene.json> [options]
+ * Construit les structures de la scène sans rendre l'image et écrit leurs
+ * statistiques en JSON sur la sortie standard (voir SceneStats)
+ */
+static int printStats(int argc, char *argv[])
+{
+  Arguments args = parseArguments(argc, argv, 2);
+  if (args.path.empty())
+  {
+    std::cerr << "[ERROR] Usage: " << argv[0] << " stats <scene.json> [options]" << std::endl;
+    return 1;
+  }
+
+  auto [scene, camera, image] = SceneLoader::Load(args.path, args.overrides);
+  if (args.autotune)
+  {
+    AutoTuner::tune(args.path, *scene, *camera, *image, args.tuneCache);
+  }
+  scene->prepare();
+
+  // Les structures des meshes ne sont construites qu'au premier rayon: toutes ici, pour les décrire
+  for (SceneObject *object : scene->getObjects())
+  {
+    Mesh *mesh = dynamic_cast<Mesh *>(object);
+    if (mesh != nullptr && mesh->getGeometry() && !scene->flattenMeshes)
+    {
+      mesh->getGeometry()->build();
+    }
+  }
+  std::cout << SceneStats::toJson(*scene) << std::endl;
+
+  delete scene;
+  delete camera;
+  delete image;
+  return 0;
+}
 
 int main(int argc, char *argv[])
 {
+  if (argc >= 2 && std::string(argv[1]) == "stats")
+  {
+    return printStats(argc, argv);  // JSON seul sur la sortie standard
+  }
+
   std::cout << std::endl;
   std::cout << "*********************************" << std::endl;
   std::cout << "*** Kevin's Awesome Raytracer ***" << std::endl;
@@ -18,15 +174,26 @@ int main(int argc, char *argv[])
     exit(0);
   }
 
-  std::string path = argv[1];
-  auto [scene, camera, image] = SceneLoader::Load(path);
+  Arguments args = parseArguments(argc, argv, 1);
 
-  std::string outpath = "image.png";
+  auto [scene, camera, image] = SceneLoader::Load(args.path, args.overrides);
 
-  // Parser les arguments optionnels pour le chemin de sortie
-  if (argc >= 3)
+  if (args.autotune)
   {
-    outpath = argv[2];
+    // Hors du temps de rendu: les essais construisent et rendent déjà chaque candidat
+    auto tuneBegin = std::chrono::high_resolution_clock::now();
+    AutoTuneResult tuned = AutoTuner::tune(args.path, *scene, *camera, *image, args.tuneCache);
+    auto tuneEnd = std::chrono::high_resolution_clock::now();
+    std::printf("Autotune: %s in %.3f seconds (%s), %.0f primary rays/s on the probe.\n",
+                tuned.cached ? "cached" : "measured",
+                std::chrono::duration_cast<std::chrono::nanoseconds>(tuneEnd - tuneBegin).count() * 1e-9,
+                args.tuneCache.c_str(), tuned.raysPerSecond);
+    std::cout << "Mesh accelerator: " << acceleratorName(tuned.mesh.type);
+    if (tuned.mesh.type == ACCELERATOR_BVH)
+    {
+      std::cout << " (" << builderName(tuned.mesh.builder) << ", width " << tuned.mesh.bvhWidth << ")";
+    }
+    std::cout << std::endl;
   }
 
 #ifdef USE_MULTITHREADING
@@ -35,24 +202,44 @@ int main(int argc, char *argv[])
   std::cout << "Mode: Single-threaded" << std::endl;
 #endif
 
-#ifdef USE_AABB
-  std::cout << "AABB Optimization: ON" << std::endl;
-#else
-  std::cout << "AABB Optimization: OFF" << std::endl;
-#endif
+  std::cout << "Accelerator: " << acceleratorName(scene->accelerator.type);
+  if (scene->accelerator.type == ACCELERATOR_BVH)
+  {
+    std::cout << " (" << builderName(scene->accelerator.builder) << ", width " << scene->accelerator.bvhWidth << ")";
+  }
+  std::cout << std::endl;
+  if (scene->flattenMeshes)
+  {
+    std::cout << "Meshes: flattened into the scene structure" << std::endl;
+  }
+  if (scene->packSpheres)
+  {
+    std::cout << "Spheres: packed into a SIMD sphere set" << std::endl;
+  }
+  if (scene->typedPrimitives)
+  {
+    std::cout << "Primitives: stored per type, no virtual calls in leaves" << std::endl;
+  }
 
   std::cout << "Rendering " << image->width << "x" << image->height << " pixels..." << std::endl;
 
+  // Structures des meshes construites au premier rayon qui les atteint, pendant le rendu:
+  // leur durée est retirée du temps de rendu (l'autotune a pu en construire avant)
+  const double meshBuildBefore = meshBuildTime(*scene);
   auto begin = std::chrono::high_resolution_clock::now();
   camera->render(*image, *scene);
   auto end = std::chrono::high_resolution_clock::now();
   auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin);
+  const double meshBuild = meshBuildTime(*scene) - meshBuildBefore;
 
   std::cout << "Done." << std::endl;
+  std::printf("Build time: %.3f seconds.\n", scene->buildTime);
+  std::printf("Mesh build time: %.3f seconds (on first hit).\n", meshBuild);
+  std::printf("Render time: %.3f seconds.\n", elapsed.count() * 1e-9 - scene->buildTime - meshBuild);
   std::printf("Total time: %.3f seconds.\n", elapsed.count() * 1e-9);
 
-  std::cout << "Writing file: " << outpath << std::endl;
-  image->writeFile(outpath);
+  std::cout << "Writing file: " << args.outpath << std::endl;
+  image->writeFile(args.outpath);
 
   delete scene;
   delete camera;
@@ -1,4 +1,7 @@
 #include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include "AABB.hpp"
 
 AABB::AABB() : Min(Vector3()), Max(Vector3()) {}
@@ -25,36 +28,86 @@ void AABB::subsume(AABB const &other)
     Max.z = std::max(Max.z, other.Max.z);
 }
 
+// Marge relative sur la distance de sortie (Ize, "Robust BVH Ray Traversal", 2013): un rayon
+// visant exactement un coin de la boîte (sommet du triangle qu'elle contient) ne la manque pas par un arrondi
+static const double SLAB_FAR_SCALE = 1.0 + 4 * std::numeric_limits<double>::epsilon();
+
+// Décalage de chaque plan de face vers l'extérieur de la boîte, voir AABB::intersects
+static const double SLAB_PLANE_OFFSET = std::numeric_limits<double>::min();
+
 bool AABB::intersects(Ray &r)
 {
     /**
      * Optimised implementation of ray-AABB intersection, taken from: https://tavianator.com/2011/ray_box.html
+     *
+     * Un rayon parallèle à un axe dont l'origine est dans le plan d'une face calculait
+     * 0 * inf = NaN et manquait la boîte: les rayons le long de l'arête commune de deux
+     * triangles passaient entre les deux. Chaque plan est repoussé vers l'extérieur du plus
+     * petit double normal: cette face donne -inf à l'entrée et +inf à la sortie et ne coupe
+     * plus le rayon (boîte fermée). Toute autre distance est inchangée par l'arrondi.
      */
 
     Vector3 o = r.GetPosition();
     Vector3 dInv = r.GetDirection().inverse();
 
-    double tx1 = (Min.x - o.x) * dInv.x;
-    double tx2 = (Max.x - o.x) * dInv.x;
+    double tx1 = (Min.x - o.x - SLAB_PLANE_OFFSET) * dInv.x;
+    double tx2 = (Max.x - o.x + SLAB_PLANE_OFFSET) * dInv.x;
 
     double tmin = std::min(tx1, tx2);
     double tmax = std::max(tx1, tx2);
 
-    double ty1 = (Min.y - o.y) * dInv.y;
-    double ty2 = (Max.y - o.y) * dInv.y;
+    double ty1 = (Min.y - o.y - SLAB_PLANE_OFFSET) * dInv.y;
+    double ty2 = (Max.y - o.y + SLAB_PLANE_OFFSET) * dInv.y;
 
     tmin = std::max(tmin, std::min(ty1, ty2));
     tmax = std::min(tmax, std::max(ty1, ty2));
 
-    double tz1 = (Min.z - o.z) * dInv.z;
-    double tz2 = (Max.z - o.z) * dInv.z;
+    double tz1 = (Min.z - o.z - SLAB_PLANE_OFFSET) * dInv.z;
+    double tz2 = (Max.z - o.z + SLAB_PLANE_OFFSET) * dInv.z;
 
     tmin = std::max(tmin, std::min(tz1, tz2));
     tmax = std::min(tmax, std::max(tz1, tz2));
 
+    tmax *= SLAB_FAR_SCALE;
     return tmax >= tmin && tmax > 0;
 }
 
+double AABB::surfaceArea() const
+{
+    double dx = Max.x - Min.x;
+    double dy = Max.y - Min.y;
+    double dz = Max.z - Min.z;
+    return 2.0 * (dx * dy + dy * dz + dz * dx);
+}
+
+bool AABB::isFinite() const
+{
+    return std::isfinite(Min.x) && std::isfinite(Min.y) && std::isfinite(Min.z) &&
+           std::isfinite(Max.x) && std::isfinite(Max.y) && std::isfinite(Max.z);
+}
+
+AABB AABB::intersection(AABB const &other) const
+{
+    Vector3 min(std::max(Min.x, other.Min.x), std::max(Min.y, other.Min.y), std::max(Min.z, other.Min.z));
+    Vector3 max(std::min(Max.x, other.Max.x), std::min(Max.y, other.Max.y), std::min(Max.z, other.Max.z));
+    return AABB(min, max);
+}
+
+AABB AABB::slice(int axis, double lo, double hi) const
+{
+    AABB result = *this;
+    double &min = axis == 0 ? result.Min.x : (axis == 1 ? result.Min.y : result.Min.z);
+    double &max = axis == 0 ? result.Max.x : (axis == 1 ? result.Max.y : result.Max.z);
+    min = std::max(min, lo);
+    max = std::min(max, hi);
+    return result;
+}
+
+bool AABB::isEmpty() const
+{
+    return Min.x > Max.x || Min.y > Max.y || Min.z > Max.z;
+}
+
 std::ostream &operator<<(std::ostream &_stream, AABB const &box)
 {
     return _stream << "Min(" << box.Min << ")-Max(" << box.Max << ")";
@@ -20,6 +20,31 @@ public:
   void subsume(AABB const &other);
 
   bool intersects(Ray &r);
+
+  /**
+   * Surface de la boîte, utilisée par l'heuristique SAH du BSP Tree
+   */
+  double surfaceArea() const;
+
+  /**
+   * Faux pour les boîtes infinies (plans) ou non initialisées (NaN)
+   */
+  bool isFinite() const;
+
+  /**
+   * Partie commune des deux boîtes, vide (isEmpty) si elles ne se touchent pas
+   */
+  AABB intersection(AABB const &other) const;
+
+  /**
+   * Tranche [lo, hi] de la boîte sur un axe (0 = x, 1 = y, 2 = z)
+   */
+  AABB slice(int axis, double lo, double hi) const;
+
+  /**
+   * Vrai si min > max sur un axe (boîte sans volume ni surface)
+   */
+  bool isEmpty() const;
   
   // Getters pour BSP Tree
   Vector3 getMin() const { return Min; }
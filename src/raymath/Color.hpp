@@ -1,22 +1,66 @@
 #pragma once
 
+#include <algorithm>
 #include <iostream>
+#include <type_traits>
 
+/**
+ * Couleur RVB, composantes entre 0 et 1
+ *
+ * Entièrement dans l'en-tête et trivialement copiable, comme Vector3: les
+ * opérations sont inline (et constexpr) dans les boucles d'ombrage.
+ */
 class Color
 {
 public:
-  Color();
-  Color(float r, float g, float b);
-  ~Color();
+  constexpr Color() = default;
+  constexpr Color(float iR, float iG, float iB) : r(iR), b(iB), g(iG)
+  {
+  }
 
   float r = 0;
   float b = 0;
   float g = 0;
 
-  Color operator+(Color const &col);
-  Color &operator=(Color const &col);
-  Color operator*(float const &f);
-  Color operator*(Color const &col);
-  Color operator/(float const &f);
-  friend std::ostream &operator<<(std::ostream &_stream, Color const &col);
+  /**
+   * Implementation of the + operator :
+   * Adding two colors is done by just adding the different components together :
+   * (r1, g1, b1) + (r2, g2, b2) = (r1 + r2, g1 + g2, b1 + b2)
+   */
+  constexpr Color operator+(Color const &col) const
+  {
+    return Color(clamp(r + col.r), clamp(g + col.g), clamp(b + col.b));
+  }
+
+  constexpr Color operator*(float const &f) const
+  {
+    return Color(clamp(r * f), clamp(g * f), clamp(b * f));
+  }
+
+  constexpr Color operator*(Color const &col) const
+  {
+    return Color(clamp(r * col.r), clamp(g * col.g), clamp(b * col.b));
+  }
+
+  constexpr Color operator/(float const &f) const
+  {
+    return Color(clamp(r / f), clamp(g / f), clamp(b / f));
+  }
+
+  /**
+   * Here we implement the << operator :
+   * We take each component and append it to he stream, giving it a nice form on the console
+   */
+  friend std::ostream &operator<<(std::ostream &_stream, Color const &col)
+  {
+    return _stream << "(" << col.r << "," << col.g << "," << col.b << ")";
+  }
+
+private:
+  static constexpr float clamp(float value)
+  {
+    return std::max(std::min(value, 1.0f), 0.0f);
+  }
 };
+
+static_assert(std::is_trivially_copyable<Color>::value, "Color doit rester trivialement copiable");
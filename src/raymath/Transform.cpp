@@ -62,20 +62,62 @@ void Transform::setMatrix()
   Matrix mrot = getRoll(rotation.z) * (getPitch(rotation.y) * getYaw(rotation.x));
 
   this->matrix = mpos * mrot;
+  this->rotationMatrix = mrot;
+
+  // Inverse : rotations opposées dans l'ordre inverse, puis translation opposée
+  double invPosMat[4][4] = {
+      {1, 0, 0, -position.x},
+      {0, 1, 0, -position.y},
+      {0, 0, 1, -position.z},
+      {0, 0, 0, 1}};
+  Matrix minvpos(&invPosMat);
+  Matrix minvrot = getYaw(-rotation.x) * (getPitch(-rotation.y) * getRoll(-rotation.z));
+
+  this->inverseMatrix = minvrot * minvpos;
+  this->inverseRotationMatrix = minvrot;
 }
 
+/*
+ * OPTIMISATION : Matrices recalculées uniquement quand la transformation change
+ *
+ * CODE AVANT :
+ *   Vector3 Transform::apply(Vector3 const &pos) {
+ *     this->setMatrix();  // 3 matrices de rotation + 3 produits à CHAQUE point !
+ *     return this->matrix * pos;
+ *   }
+ *
+ * CODE APRÈS : setMatrix() est appelé par setPosition()/setRotation()
+ * Amélioration : indispensable pour transformer chaque rayon entrant dans une instance de mesh
+ */
 void Transform::setPosition(Vector3 const &pos)
 {
   this->position = pos;
+  this->setMatrix();
 }
 
 void Transform::setRotation(Vector3 const &rot)
 {
   this->rotation = rot;
+  this->setMatrix();
 }
 
 Vector3 Transform::apply(Vector3 const &pos)
 {
-  this->setMatrix();
   return this->matrix * pos;
+}
+
+Vector3 Transform::applyInverse(Vector3 const &pos) const
+{
+  return this->inverseMatrix * pos;
+}
+
+Vector3 Transform::applyDirection(Vector3 const &dir) const
+{
+  // Pas de translation dans la matrice de rotation : w = 1 est sans effet
+  return this->rotationMatrix * dir;
+}
+
+Vector3 Transform::applyInverseDirection(Vector3 const &dir) const
+{
+  return this->inverseRotationMatrix * dir;
 }
\ No newline at end of file
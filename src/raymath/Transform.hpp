@@ -9,6 +9,9 @@ private:
   Vector3 position;
   Vector3 rotation;
   Matrix matrix;
+  Matrix inverseMatrix;          // Monde -> objet
+  Matrix rotationMatrix;         // Pour les directions et normales
+  Matrix inverseRotationMatrix;
 
   void setMatrix();
 
@@ -21,4 +24,13 @@ public:
   Vector3 getPosition() const { return position; }  // Pour BSP Tree
 
   Vector3 apply(Vector3 const &pos);
+
+  /**
+   * Transformations utilisées par les instances de mesh :
+   * les rayons passent de l'espace monde à l'espace objet, les impacts en sens inverse.
+   * La transformation étant rigide (rotation + translation), les distances sont conservées.
+   */
+  Vector3 applyInverse(Vector3 const &pos) const;
+  Vector3 applyDirection(Vector3 const &dir) const;
+  Vector3 applyInverseDirection(Vector3 const &dir) const;
 };
@@ -1,35 +1,244 @@
 #pragma once
 
+#include <cmath>
 #include <iostream>
+#include <type_traits>
 
 #define COMPARE_ERROR_CONSTANT 0.000001
 
+// Stockage vectoriel optionnel (option CMake RAYMATH_SIMD): AVX sur x86 si disponible,
+// sinon SSE2 ou NEON par paires de coordonnées; calcul scalaire par défaut
+#if defined(RAYMATH_SIMD) && defined(__AVX__)
+#include <immintrin.h>
+#define VECTOR3_AVX
+#elif defined(RAYMATH_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define VECTOR3_SSE
+#elif defined(RAYMATH_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VECTOR3_NEON
+#endif
+
+#if defined(VECTOR3_AVX) || defined(VECTOR3_SSE) || defined(VECTOR3_NEON)
+#define VECTOR3_SIMD
+// Les intrinsèques ne sont pas constexpr: les expressions constantes prennent la voie scalaire
+#define VECTOR3_RUNTIME() (!__builtin_is_constant_evaluated())
+#endif
+
+/*
+ * OPTIMISATION : Vector3 entièrement dans l'en-tête, trivialement copiable
+ *
+ * CODE AVANT :
+ *   Vector3 Vector3::operator+(...) const { ... }  // Défini dans Vector3.cpp: un appel
+ *   Vector3::~Vector3() {}                          // de fonction par opération, pas
+ *   Vector3 &operator=(Vector3 const &vec);         // d'inlining hors de raymath;
+ *                                                   // copie et destruction non triviales
+ * CODE APRÈS :
+ *   - Toutes les opérations inline et constexpr (sauf celles qui utilisent sqrt)
+ *   - Copie, affectation et destruction implicites: Vector3 se copie comme
+ *     3 doubles (memcpy, registres) dans les tableaux et les structures des noyaux
+ *   - Mêmes calculs, dans le même ordre: résultats identiques bit à bit
+ *   - Avec RAYMATH_SIMD: quatrième coordonnée de remplissage (w), alignée, et
+ *     +, -, *, / en une instruction AVX (ou deux SSE2/NEON)
+ */
 class Vector3
 {
 private:
 public:
+#if defined(VECTOR3_AVX)
+  alignas(32) double x = 0;
+#elif defined(VECTOR3_SIMD)
+  alignas(16) double x = 0;
+#else
   double x = 0;
+#endif
   double y = 0;
   double z = 0;
+#if defined(VECTOR3_SIMD)
+  double w = 0;  // Remplissage: complète le registre vectoriel, jamais lu
+#endif
+
+  constexpr Vector3() = default;
+  constexpr Vector3(double iX, double iY, double iZ) : x(iX), y(iY), z(iZ)
+  {
+  }
+
+  constexpr const Vector3 operator+(Vector3 const &vec) const
+  {
+#if defined(VECTOR3_SIMD)
+    if (VECTOR3_RUNTIME())
+    {
+      return simdAdd(*this, vec);
+    }
+#endif
+    return Vector3(x + vec.x, y + vec.y, z + vec.z);
+  }
+
+  constexpr const Vector3 operator-(Vector3 const &vec) const
+  {
+#if defined(VECTOR3_SIMD)
+    if (VECTOR3_RUNTIME())
+    {
+      return simdSub(*this, vec);
+    }
+#endif
+    return Vector3(x - vec.x, y - vec.y, z - vec.z);
+  }
+
+  constexpr const Vector3 operator*(double const &f) const
+  {
+#if defined(VECTOR3_SIMD)
+    if (VECTOR3_RUNTIME())
+    {
+      return simdMul(*this, f);
+    }
+#endif
+    return Vector3(x * f, y * f, z * f);
+  }
+
+  /*
+   * OPTIMISATION : Opérateur de division
+   * CODE AVANT :
+   *   c.x = x / f;  // 3 divisions
+   *
+   * CODE APRÈS :
+   *   double inv = 1.0 / f;  // 1 division + 3 multiplications
+   */
+  constexpr const Vector3 operator/(double const &f) const
+  {
+    return *this * (1.0 / f);
+  }
+
+  double length() const
+  {
+    return std::sqrt(lengthSquared());
+  }
+
+  constexpr double lengthSquared() const
+  {
+    return x * x + y * y + z * z;
+  }
+
+  /*
+   * OPTIMISATION : normalize() utilisant lengthSquared()
+   * Un seul sqrt(), puis une multiplication par l'inverse de la longueur
+   */
+  const Vector3 normalize() const
+  {
+    double lengthSq = lengthSquared();
+    if (lengthSq == 0)
+    {
+      return Vector3();
+    }
+    double invLength = 1.0 / std::sqrt(lengthSq);
+    return *this * invLength;
+  }
+
+  constexpr double dot(Vector3 const &vec) const
+  {
+    return x * vec.x + y * vec.y + z * vec.z;
+  }
+
+  constexpr const Vector3 projectOn(Vector3 const &vec) const
+  {
+    return vec * dot(vec);
+  }
 
-  Vector3();
-  Vector3(double x, double y, double z);
-  ~Vector3();
-
-  const Vector3 operator+(Vector3 const &vec) const;
-  const Vector3 operator-(Vector3 const &vec) const;
-  const Vector3 operator*(double const &f) const;
-  const Vector3 operator/(double const &f) const;
-  Vector3 &operator=(Vector3 const &vec);
-
-  double length() const;
-  double lengthSquared() const;
-  const Vector3 normalize() const;
-  double dot(Vector3 const &vec) const;
-  const Vector3 projectOn(Vector3 const &vec) const;
-  const Vector3 reflect(Vector3 const &normal) const;
-  const Vector3 cross(Vector3 const &vec) const;
-  const Vector3 inverse() const;
-
-  friend std::ostream &operator<<(std::ostream &_stream, Vector3 const &vec);
+  constexpr const Vector3 reflect(Vector3 const &normal) const
+  {
+    return projectOn(normal) * -2 + *this;
+  }
+
+  constexpr const Vector3 cross(Vector3 const &b) const
+  {
+    return Vector3(y * b.z - z * b.y, z * b.x - x * b.z, x * b.y - y * b.x);
+  }
+
+  constexpr const Vector3 inverse() const
+  {
+    return Vector3(1.0 / x, 1.0 / y, 1.0 / z);
+  }
+
+  friend std::ostream &operator<<(std::ostream &_stream, Vector3 const &vec)
+  {
+    return _stream << "(" << vec.x << "," << vec.y << "," << vec.z << ")";
+  }
+
+private:
+#if defined(VECTOR3_AVX)
+  static Vector3 simdAdd(Vector3 const &a, Vector3 const &b)
+  {
+    Vector3 c;
+    _mm256_store_pd(&c.x, _mm256_add_pd(_mm256_load_pd(&a.x), _mm256_load_pd(&b.x)));
+    return c;
+  }
+
+  static Vector3 simdSub(Vector3 const &a, Vector3 const &b)
+  {
+    Vector3 c;
+    _mm256_store_pd(&c.x, _mm256_sub_pd(_mm256_load_pd(&a.x), _mm256_load_pd(&b.x)));
+    return c;
+  }
+
+  static Vector3 simdMul(Vector3 const &a, double f)
+  {
+    Vector3 c;
+    _mm256_store_pd(&c.x, _mm256_mul_pd(_mm256_load_pd(&a.x), _mm256_set1_pd(f)));
+    return c;
+  }
+#elif defined(VECTOR3_SSE)
+  // Deux registres: (x, y) puis (z, w)
+  static Vector3 simdAdd(Vector3 const &a, Vector3 const &b)
+  {
+    Vector3 c;
+    _mm_store_pd(&c.x, _mm_add_pd(_mm_load_pd(&a.x), _mm_load_pd(&b.x)));
+    _mm_store_pd(&c.z, _mm_add_pd(_mm_load_pd(&a.z), _mm_load_pd(&b.z)));
+    return c;
+  }
+
+  static Vector3 simdSub(Vector3 const &a, Vector3 const &b)
+  {
+    Vector3 c;
+    _mm_store_pd(&c.x, _mm_sub_pd(_mm_load_pd(&a.x), _mm_load_pd(&b.x)));
+    _mm_store_pd(&c.z, _mm_sub_pd(_mm_load_pd(&a.z), _mm_load_pd(&b.z)));
+    return c;
+  }
+
+  static Vector3 simdMul(Vector3 const &a, double f)
+  {
+    Vector3 c;
+    const __m128d scale = _mm_set1_pd(f);
+    _mm_store_pd(&c.x, _mm_mul_pd(_mm_load_pd(&a.x), scale));
+    _mm_store_pd(&c.z, _mm_mul_pd(_mm_load_pd(&a.z), scale));
+    return c;
+  }
+#elif defined(VECTOR3_NEON)
+  // Deux registres: (x, y) puis (z, w)
+  static Vector3 simdAdd(Vector3 const &a, Vector3 const &b)
+  {
+    Vector3 c;
+    vst1q_f64(&c.x, vaddq_f64(vld1q_f64(&a.x), vld1q_f64(&b.x)));
+    vst1q_f64(&c.z, vaddq_f64(vld1q_f64(&a.z), vld1q_f64(&b.z)));
+    return c;
+  }
+
+  static Vector3 simdSub(Vector3 const &a, Vector3 const &b)
+  {
+    Vector3 c;
+    vst1q_f64(&c.x, vsubq_f64(vld1q_f64(&a.x), vld1q_f64(&b.x)));
+    vst1q_f64(&c.z, vsubq_f64(vld1q_f64(&a.z), vld1q_f64(&b.z)));
+    return c;
+  }
+
+  static Vector3 simdMul(Vector3 const &a, double f)
+  {
+    Vector3 c;
+    const float64x2_t scale = vdupq_n_f64(f);
+    vst1q_f64(&c.x, vmulq_f64(vld1q_f64(&a.x), scale));
+    vst1q_f64(&c.z, vmulq_f64(vld1q_f64(&a.z), scale));
+    return c;
+  }
+#endif
 };
+
+static_assert(std::is_trivially_copyable<Vector3>::value, "Vector3 doit rester trivialement copiable");
@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <numeric>
+#include "Accelerator.hpp"
+#include "BSPTree.hpp"
+#include "KdTree.hpp"
+#include "UniformGrid.hpp"
+
+AcceleratorType AcceleratorSettings::defaultType() {
+#if defined(USE_BSPTREE)
+    return ACCELERATOR_BVH;
+#elif defined(USE_AABB)
+    return ACCELERATOR_AABB;
+#else
+    return ACCELERATOR_NONE;
+#endif
+}
+
+static const char* const ACCELERATOR_NAMES[] = {"none", "aabb", "bvh", "grid", "kdtree"};
+
+std::string acceleratorName(AcceleratorType type) {
+    return ACCELERATOR_NAMES[type];
+}
+
+static const char* const BUILDER_NAMES[] = {"median", "sah", "lbvh", "sbvh"};
+
+std::string builderName(BSPBuildStrategy builder) {
+    return BUILDER_NAMES[builder];
+}
+
+bool parseBuilderName(const std::string& name, BSPBuildStrategy& builder) {
+    for (int i = BUILD_MEDIAN; i <= BUILD_SBVH; ++i) {
+        if (name == BUILDER_NAMES[i]) {
+            builder = static_cast<BSPBuildStrategy>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseAcceleratorName(const std::string& name, AcceleratorType& type) {
+    for (int i = ACCELERATOR_NONE; i <= ACCELERATOR_KDTREE; ++i) {
+        if (name == ACCELERATOR_NAMES[i]) {
+            type = static_cast<AcceleratorType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::unique_ptr<Accelerator> Accelerator::create(const AcceleratorSettings& settings) {
+    std::unique_ptr<Accelerator> accelerator;
+    switch (settings.type) {
+    case ACCELERATOR_NONE:
+        accelerator.reset(new LinearAccelerator(false));
+        break;
+    case ACCELERATOR_AABB:
+        accelerator.reset(new LinearAccelerator(true));
+        break;
+    case ACCELERATOR_GRID:
+        accelerator.reset(new UniformGrid());
+        break;
+    case ACCELERATOR_KDTREE:
+        accelerator.reset(new KdTree());
+        break;
+    case ACCELERATOR_BVH:
+    default:
+        accelerator.reset(new BSPTree());
+        break;
+    }
+    accelerator->configure(settings);
+    return accelerator;
+}
+
+LinearAccelerator::LinearAccelerator(bool testBoxes) : testBoxes(testBoxes) {}
+
+void LinearAccelerator::build(std::vector<SceneObject*>& objects) {
+    this->objects = objects;
+    primitives = nullptr;
+    primIndices.clear();
+}
+
+void LinearAccelerator::build(const PrimitiveSet& primitives) {
+    objects.clear();
+    this->primitives = &primitives;
+    primIndices.resize(primitives.size());
+    std::iota(primIndices.begin(), primIndices.end(), 0);
+}
+
+bool LinearAccelerator::insert(SceneObject* object) {
+    if (primitives) {
+        return false;
+    }
+    objects.push_back(object);
+    return true;
+}
+
+bool LinearAccelerator::remove(SceneObject* object) {
+    auto it = std::find(objects.begin(), objects.end(), object);
+    if (it == objects.end()) {
+        return false;
+    }
+    objects.erase(it);
+    return true;
+}
+
+/*
+ * OPTIMISATION : Trouver l'intersection la plus proche avec lengthSquared()
+ *
+ * CODE AVANT :
+ *   intersection.Distance = (intersection.Position - r.GetPosition()).length();  // sqrt() !
+ *
+ * CODE APRÈS :
+ *   intersection.Distance = (...).lengthSquared();  // PAS de sqrt !
+ *
+ * Pour comparer a < b, on peut comparer a² < b² (valeurs positives)
+ */
+bool LinearAccelerator::closestIntersection(Ray& ray, Intersection& closest, CullingType culling) {
+    Intersection intersection;
+    Intersection closestInter;
+    double closestDistanceSquared = -1;
+    const Vector3 o = ray.GetPosition();
+
+    if (primitives) {
+        primitives->intersect(primIndices.data(), static_cast<uint32_t>(primIndices.size()), ray, culling,
+                              closestInter, closestDistanceSquared);
+    }
+
+    const int objectCount = objects.size();
+    for (int i = 0; i < objectCount; ++i) {
+        // OPTIMISATION AABB : Vérifier d'abord si le rayon intersecte la bounding box
+        if (testBoxes && !objects[i]->boundingBox.intersects(ray)) {
+            continue;
+        }
+        if (objects[i]->intersects(ray, intersection, culling)) {
+            intersection.Distance = (intersection.Position - o).lengthSquared();
+            if (closestDistanceSquared < 0 || intersection.Distance < closestDistanceSquared) {
+                closestDistanceSquared = intersection.Distance;
+                closestInter = intersection;
+            }
+        }
+    }
+
+    closest = closestInter;
+    return closestDistanceSquared > -1;
+}
+
+bool LinearAccelerator::occluded(Ray& ray, double maxDistance) {
+    if (primitives && primitives->occluded(primIndices.data(), static_cast<uint32_t>(primIndices.size()), ray, maxDistance)) {
+        return true;
+    }
+    const int objectCount = objects.size();
+    for (int i = 0; i < objectCount; ++i) {
+        if (testBoxes && !objects[i]->boundingBox.intersects(ray)) {
+            continue;
+        }
+        if (objects[i]->occluded(ray, maxDistance)) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,169 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include "../raymath/Ray.hpp"
+#include "PrimitiveSet.hpp"
+#include "SceneObject.hpp"
+
+/**
+ * Structures d'accélération des requêtes rayon-objets
+ *
+ * Toutes les structures (test linéaire, BSPTree, grille, kd-tree) partagent
+ * l'interface Accelerator: la scène et les meshes choisissent la leur à
+ * l'exécution (clé "accelerator" du fichier de scène ou ligne de commande),
+ * au lieu des anciens #ifdef USE_AABB / USE_BSPTREE. Un même exécutable peut
+ * ainsi comparer toutes les structures sur une même scène.
+ */
+
+/**
+ * Type de structure
+ */
+enum AcceleratorType
+{
+    ACCELERATOR_NONE,   // Test de tous les objets
+    ACCELERATOR_AABB,   // Test de tous les objets, filtrés par leur AABB
+    ACCELERATOR_BVH,    // BSPTree (hiérarchie de boîtes)
+    ACCELERATOR_GRID,   // UniformGrid: nuages denses d'objets de tailles voisines
+    ACCELERATOR_KDTREE  // KdTree: partition de l'espace, construction plus longue, parcours d'avant en arrière
+};
+
+/**
+ * Stratégie de construction du BSPTree
+ */
+enum BSPBuildStrategy
+{
+    BUILD_MEDIAN, // Tri selon l'axe le plus long et coupe au milieu de la liste
+    BUILD_SAH,    // Surface Area Heuristic par casiers (binned SAH)
+    BUILD_LBVH,   // Linear BVH: tri par code de Morton, construction quasi linéaire
+    BUILD_SBVH    // SAH avec découpes spatiales: une primitive peut être référencée par plusieurs feuilles
+};
+
+// Largeur par défaut de l'arbre parcouru (voir BSPTree::setLayout)
+static const int BSP_DEFAULT_WIDTH = 4;
+
+/**
+ * Réglages d'une structure; seuls ceux du type choisi sont utilisés
+ */
+struct AcceleratorSettings {
+    AcceleratorType type = defaultType();
+    BSPBuildStrategy builder = BUILD_SAH;  // BVH: constructeur
+    int bvhWidth = BSP_DEFAULT_WIDTH;      // BVH: largeur de l'arbre parcouru (2, 4 ou 8)
+    int bvhQuantization = 0;               // BVH: bornes compressées sur 8 ou 16 bits, 0 = float
+    int maxDepth = 10;                     // BVH: profondeur maximale (BUILD_MEDIAN uniquement)
+    int minObjects = 2;                    // BVH: objets par feuille au minimum (BUILD_MEDIAN uniquement)
+
+    /**
+     * Type utilisé sans clé "accelerator": celui choisi à la configuration CMake
+     * (USE_BSPTREE, USE_AABB), qui ne fixent plus que cette valeur par défaut
+     */
+    static AcceleratorType defaultType();
+};
+
+/**
+ * Nom d'un type ("none", "aabb", "bvh", "grid", "kdtree")
+ */
+std::string acceleratorName(AcceleratorType type);
+
+/**
+ * Nom d'un constructeur de BVH ("median", "sah", "lbvh", "sbvh")
+ */
+std::string builderName(BSPBuildStrategy builder);
+
+/**
+ * Constructeur correspondant à un nom
+ * @return false si le nom est inconnu (builder inchangé)
+ */
+bool parseBuilderName(const std::string& name, BSPBuildStrategy& builder);
+
+/**
+ * Type correspondant à un nom
+ * @return false si le nom est inconnu (type inchangé)
+ */
+bool parseAcceleratorName(const std::string& name, AcceleratorType& type);
+
+class Accelerator {
+public:
+    virtual ~Accelerator() {}
+
+    /**
+     * Crée une structure vide du type demandé, déjà configurée
+     */
+    static std::unique_ptr<Accelerator> create(const AcceleratorSettings& settings);
+
+    virtual AcceleratorType getType() const = 0;
+
+    /**
+     * Applique les réglages propres à la structure (constructeur, format des nœuds)
+     * @return false si la structure déjà construite ne correspond plus: build() est nécessaire
+     */
+    virtual bool configure(const AcceleratorSettings& /*settings*/) { return true; }
+
+    /**
+     * Construit la structure (boundingBox des objets à jour)
+     */
+    virtual void build(std::vector<SceneObject*>& objects) = 0;
+
+    /**
+     * Construit la structure sur des primitives compactes (triangles d'un mesh),
+     * référencées par leur indice. insert et remove ne s'y appliquent pas.
+     */
+    virtual void build(const PrimitiveSet& primitives) = 0;
+
+    /**
+     * Met à jour la structure après un changement de transformation des objets
+     * @return false si elle doit être reconstruite (par défaut: toujours)
+     */
+    virtual bool refit() { return false; }
+
+    /**
+     * Ajoute un objet à la structure construite, sans la reconstruire
+     * (boundingBox de l'objet à jour)
+     * @return false si la structure ne le permet pas: build() est nécessaire
+     */
+    virtual bool insert(SceneObject* /*object*/) { return false; }
+
+    /**
+     * Retire un objet de la structure construite, sans la reconstruire
+     * @return false si la structure ne le permet pas (ou ne contient pas l'objet)
+     */
+    virtual bool remove(SceneObject* /*object*/) { return false; }
+
+    /**
+     * Trouve l'intersection la plus proche le long du rayon
+     * @param closest Intersection la plus proche (Distance = distance au carré)
+     * @return true si un objet a été touché
+     */
+    virtual bool closestIntersection(Ray& ray, Intersection& closest, CullingType culling) = 0;
+
+    /**
+     * Requête d'ombre: s'arrête au premier objet qui bloque le rayon avant maxDistance
+     */
+    virtual bool occluded(Ray& ray, double maxDistance) = 0;
+};
+
+/**
+ * Sans structure: test de tous les objets (ACCELERATOR_NONE et ACCELERATOR_AABB)
+ */
+class LinearAccelerator : public Accelerator {
+public:
+    /**
+     * @param testBoxes Filtrer les objets par leur AABB avant le test exact
+     */
+    explicit LinearAccelerator(bool testBoxes);
+
+    AcceleratorType getType() const override { return testBoxes ? ACCELERATOR_AABB : ACCELERATOR_NONE; }
+    void build(std::vector<SceneObject*>& objects) override;
+    void build(const PrimitiveSet& primitives) override;
+    bool refit() override { return true; }
+    bool insert(SceneObject* object) override;
+    bool remove(SceneObject* object) override;
+    bool closestIntersection(Ray& ray, Intersection& closest, CullingType culling) override;
+    bool occluded(Ray& ray, double maxDistance) override;
+
+private:
+    std::vector<SceneObject*> objects;
+    const PrimitiveSet* primitives = nullptr;  // Primitives compactes, à la place de objects
+    std::vector<uint32_t> primIndices;         // 0 .. n - 1: toutes les primitives en une liste
+    bool testBoxes;
+};
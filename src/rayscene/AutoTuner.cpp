@@ -0,0 +1,293 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include "../json/json.hpp"
+#include "AutoTuner.hpp"
+#include "Mesh.hpp"
+
+using json = nlohmann::ordered_json;
+
+// Image d'essai: résolution finale divisée par ce facteur sur chaque axe
+static const unsigned int AUTOTUNE_PROBE_DIVISOR = 4;
+
+// Rendus d'essai par candidat, après la construction: le plus rapide est retenu
+static const int AUTOTUNE_PROBE_RUNS = 2;
+
+static const uint64_t FNV_OFFSET = 1469598103934665603ull;
+static const uint64_t FNV_PRIME = 1099511628211ull;
+
+static uint64_t fnv1a(uint64_t hash, const char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+uint64_t AutoTuner::hashScene(const std::string& scenePath, const Scene& scene) {
+    std::ifstream file(scenePath, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    uint64_t hash = fnv1a(FNV_OFFSET, content.data(), content.size());
+
+    // Un .obj remplacé sous le même nom change la scène: nombre de triangles de chaque géométrie
+    std::set<const MeshGeometry*> seen;
+    for (SceneObject* object : scene.getObjects()) {
+        Mesh* mesh = dynamic_cast<Mesh*>(object);
+        if (mesh == nullptr || !mesh->getGeometry() || !seen.insert(mesh->getGeometry().get()).second) {
+            continue;
+        }
+        const std::string entry = mesh->getGeometry()->getPath() + ":" + std::to_string(mesh->getGeometry()->getTriangleCount());
+        hash = fnv1a(hash, entry.data(), entry.size());
+    }
+    return hash;
+}
+
+std::vector<AcceleratorSettings> AutoTuner::candidates(const AcceleratorSettings& base) {
+    std::vector<AcceleratorSettings> out;
+    AcceleratorSettings bvh = base;
+    bvh.type = ACCELERATOR_BVH;
+
+    // Constructeurs et largeurs de l'arbre parcouru
+    const int widths[] = {2, 4, 8};
+    for (int width : widths) {
+        AcceleratorSettings sah = bvh;
+        sah.builder = BUILD_SAH;
+        sah.bvhWidth = width;
+        out.push_back(sah);
+    }
+    AcceleratorSettings sbvh = bvh;
+    sbvh.builder = BUILD_SBVH;
+    out.push_back(sbvh);
+    AcceleratorSettings lbvh = bvh;
+    lbvh.builder = BUILD_LBVH;
+    out.push_back(lbvh);
+
+    // Découpage médian: la taille des feuilles est le seul réglage qui compte,
+    // la profondeur est seulement bornée par la pile de parcours
+    const int leafSizes[] = {2, 4, 8};
+    for (int leafSize : leafSizes) {
+        AcceleratorSettings median = bvh;
+        median.builder = BUILD_MEDIAN;
+        median.maxDepth = BSP_MAX_DEPTH / 2;
+        median.minObjects = leafSize;
+        out.push_back(median);
+    }
+
+    AcceleratorSettings grid = base;
+    grid.type = ACCELERATOR_GRID;
+    out.push_back(grid);
+    AcceleratorSettings kdtree = base;
+    kdtree.type = ACCELERATOR_KDTREE;
+    out.push_back(kdtree);
+    return out;
+}
+
+void AutoTuner::setMeshSettings(Scene& scene, const AcceleratorSettings& settings) {
+    for (SceneObject* object : scene.getObjects()) {
+        Mesh* mesh = dynamic_cast<Mesh*>(object);
+        if (mesh != nullptr) {
+            mesh->accelerator = settings;
+        }
+    }
+}
+
+static json settingsToJson(const AcceleratorSettings& settings) {
+    return {
+        {"type", acceleratorName(settings.type)},
+        {"builder", builderName(settings.builder)},
+        {"bvhWidth", settings.bvhWidth},
+        {"bvhQuantization", settings.bvhQuantization},
+        {"maxDepth", settings.maxDepth},
+        {"minObjects", settings.minObjects}};
+}
+
+/**
+ * Lit un entier optionnel de l'entrée
+ * @return false si le champ est présent mais n'est pas un entier
+ */
+static bool intFromJson(const json& data, const char* name, int& value) {
+    if (!data.contains(name)) {
+        return true;
+    }
+    if (!data[name].is_number_integer()) {
+        return false;
+    }
+    value = data[name].get<int>();
+    return true;
+}
+
+/**
+ * Le cache est un fichier éditable: une entrée incomplète ou mal typée est
+ * traitée comme absente (nouveaux essais) au lieu d'interrompre le rendu
+ * @return false si l'entrée est incomplète ou d'un format inconnu
+ */
+static bool settingsFromJson(const json& data, AcceleratorSettings& settings) {
+    if (!data.is_object() || !data.contains("type") || !data.contains("builder") ||
+        !data["type"].is_string() || !data["builder"].is_string()) {
+        return false;
+    }
+    AcceleratorSettings parsed = settings;
+    if (!parseAcceleratorName(data["type"].get<std::string>(), parsed.type) ||
+        !parseBuilderName(data["builder"].get<std::string>(), parsed.builder) ||
+        !intFromJson(data, "bvhWidth", parsed.bvhWidth) ||
+        !intFromJson(data, "bvhQuantization", parsed.bvhQuantization) ||
+        !intFromJson(data, "maxDepth", parsed.maxDepth) ||
+        !intFromJson(data, "minObjects", parsed.minObjects)) {
+        return false;
+    }
+    settings = parsed;
+    return true;
+}
+
+/**
+ * Durée optionnelle de l'entrée (0 si absente ou mal typée)
+ */
+static double numberFromJson(const json& data, const char* name) {
+    return data.contains(name) && data[name].is_number() ? data[name].get<double>() : 0.0;
+}
+
+/**
+ * Lit le cache; un fichier absent ou illisible donne un cache vide
+ */
+static json readCache(const std::string& cachePath) {
+    std::ifstream file(cachePath);
+    if (!file.good()) {
+        return json::object();
+    }
+    json cache = json::parse(file, nullptr, false);
+    return cache.is_object() ? cache : json::object();
+}
+
+/**
+ * Construit les structures des triangles (sinon construites au premier rayon
+ * qui atteint chaque mesh, pendant le rendu, donc hors de scene.buildTime)
+ * @param rebuild Reconstruire aussi les structures déjà construites avec les mêmes réglages
+ * @return Durée des constructions en secondes
+ */
+static double buildMeshes(Scene& scene, bool rebuild) {
+    auto begin = std::chrono::high_resolution_clock::now();
+    std::set<MeshGeometry*> seen;
+    for (SceneObject* object : scene.getObjects()) {
+        Mesh* mesh = dynamic_cast<Mesh*>(object);
+        if (mesh != nullptr && mesh->getGeometry() && seen.insert(mesh->getGeometry().get()).second) {
+            if (rebuild) {
+                mesh->getGeometry()->invalidate();
+            }
+            mesh->getGeometry()->build();
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() * 1e-9;
+}
+
+/**
+ * Durée estimée du rendu complet avec les réglages actuels de la scène
+ * @param scale Nombre de pixels du rendu complet / nombre de pixels de l'essai
+ * @param meshes Compter la construction des structures des triangles (refaite pour chaque
+ *        candidat); sinon elles doivent déjà être construites et leur coût est ignoré
+ */
+static double measure(Scene& scene, Camera& camera, Image& probe, double scale, bool meshes, double& raysPerSecond) {
+    // Construction complète chronométrée avant les essais
+    scene.prepare();
+    const double buildTime = scene.buildTime + (meshes ? buildMeshes(scene, true) : 0);
+
+    double renderTime = 0;
+    for (int run = 0; run < AUTOTUNE_PROBE_RUNS; ++run) {
+        auto begin = std::chrono::high_resolution_clock::now();
+        camera.render(probe, scene);
+        auto end = std::chrono::high_resolution_clock::now();
+        const double elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() * 1e-9;
+        // Le prepare() du rendu se contente d'un refit (reconstruction pour la grille et le kd-tree)
+        const double traversal = std::max(elapsed - scene.buildTime, 1e-9);
+        renderTime = run == 0 ? traversal : std::min(renderTime, traversal);
+    }
+    raysPerSecond = probe.width * probe.height / renderTime;
+    return buildTime + renderTime * scale;
+}
+
+AutoTuneResult AutoTuner::tune(const std::string& scenePath, Scene& scene, Camera& camera,
+                               const Image& image, const std::string& cachePath) {
+    AutoTuneResult result;
+    result.scene = scene.accelerator;
+    result.mesh = result.scene;
+    bool hasMeshes = false;
+    for (SceneObject* object : scene.getObjects()) {
+        if (Mesh* mesh = dynamic_cast<Mesh*>(object)) {
+            result.mesh = mesh->accelerator;
+            hasMeshes = true;
+            break;
+        }
+    }
+
+    char key[17];
+    std::snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(hashScene(scenePath, scene)));
+    json cache = readCache(cachePath);
+    const json entry = cache.contains(key) ? cache[key] : json();
+    if (entry.is_object() && entry.contains("accelerator") && entry.contains("meshAccelerator")) {
+        AcceleratorSettings sceneSettings = result.scene;
+        AcceleratorSettings meshSettings = result.mesh;
+        if (settingsFromJson(entry["accelerator"], sceneSettings) &&
+            settingsFromJson(entry["meshAccelerator"], meshSettings)) {
+            result.scene = sceneSettings;
+            result.mesh = meshSettings;
+            result.raysPerSecond = numberFromJson(entry, "raysPerSecond");
+            result.estimatedTime = numberFromJson(entry, "estimatedTime");
+            result.cached = true;
+            scene.accelerator = result.scene;
+            setMeshSettings(scene, result.mesh);
+            return result;
+        }
+    }
+
+    Image probe(std::max(1u, image.width / AUTOTUNE_PROBE_DIVISOR), std::max(1u, image.height / AUTOTUNE_PROBE_DIVISOR));
+    const double scale = static_cast<double>(image.width) * image.height / (static_cast<double>(probe.width) * probe.height);
+    result.estimatedTime = -1;
+
+    // Structure de la scène, meshes inchangés: leurs structures, construites une fois
+    // avant les essais, coûtent la même chose pour tous les candidats et ne sont pas comptées
+    scene.prepare();
+    buildMeshes(scene, false);
+    for (const AcceleratorSettings& candidate : candidates(result.scene)) {
+        scene.accelerator = candidate;
+        double raysPerSecond = 0;
+        const double time = measure(scene, camera, probe, scale, false, raysPerSecond);
+        if (result.estimatedTime < 0 || time < result.estimatedTime) {
+            result.scene = candidate;
+            result.estimatedTime = time;
+            result.raysPerSecond = raysPerSecond;
+        }
+    }
+    scene.accelerator = result.scene;
+
+    // Structure des triangles, avec la meilleure structure de scène: chaque candidat
+    // reconstruit les structures des meshes, l'estimation finale comprend donc leur
+    // construction. Inutile si les triangles sont dans la structure de la scène.
+    if (hasMeshes && !scene.flattenMeshes) {
+        const AcceleratorSettings current = result.mesh;
+        double best = -1;
+        for (const AcceleratorSettings& candidate : candidates(current)) {
+            setMeshSettings(scene, candidate);
+            double raysPerSecond = 0;
+            const double time = measure(scene, camera, probe, scale, true, raysPerSecond);
+            if (best < 0 || time < best) {
+                result.mesh = candidate;
+                result.estimatedTime = best = time;
+                result.raysPerSecond = raysPerSecond;
+            }
+        }
+        setMeshSettings(scene, result.mesh);
+    }
+
+    cache[key] = {
+        {"scene", scenePath},
+        {"accelerator", settingsToJson(result.scene)},
+        {"meshAccelerator", settingsToJson(result.mesh)},
+        {"raysPerSecond", result.raysPerSecond},
+        {"estimatedTime", result.estimatedTime}};
+    std::ofstream out(cachePath);
+    out << cache.dump(2) << std::endl;
+    return result;
+}
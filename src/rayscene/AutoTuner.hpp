@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../rayimage/Image.hpp"
+#include "Accelerator.hpp"
+#include "Camera.hpp"
+#include "Scene.hpp"
+
+/**
+ * Réglage automatique des structures d'accélération d'une scène
+ *
+ * Aucun réglage fixe (profondeur et taille des feuilles, constructeur, largeur
+ * des nœuds) ne convient à la fois à une scène de 12 triangles et à un mesh de
+ * 2 millions. Le tuner rend une image d'essai en basse résolution pour chaque
+ * candidat et garde celui dont la durée estimée du rendu complet est la plus
+ * courte (construction + parcours extrapolé à la résolution finale).
+ *
+ * Principe:
+ * - Structure de la scène d'abord (meshes inchangés), puis celle des triangles
+ *   des meshes avec la meilleure structure de scène: 2 x N essais au lieu de N²
+ * - Le résultat est mis en cache dans un fichier JSON, indexé par une empreinte
+ *   de la scène (fichier de scène et nombre de triangles de chaque .obj): les
+ *   rendus suivants du même fichier partent directement des bons réglages
+ */
+struct AutoTuneResult {
+    AcceleratorSettings scene;      // Structure des objets de la scène
+    AcceleratorSettings mesh;       // Structure des triangles des meshes
+    double raysPerSecond = 0;       // Rayons primaires par seconde sur l'image d'essai
+    double estimatedTime = 0;       // Durée estimée du rendu complet (secondes)
+    bool cached = false;            // Lu dans le cache, aucun essai
+};
+
+class AutoTuner {
+public:
+    /**
+     * Applique les réglages en cache pour cette scène, ou les mesure puis les met
+     * en cache. Les réglages retenus sont appliqués à la scène et à ses meshes.
+     * @param scenePath Fichier de la scène, pour l'empreinte
+     * @param image Image du rendu final (seule sa taille est utilisée)
+     * @param cachePath Fichier du cache (créé au besoin)
+     */
+    static AutoTuneResult tune(const std::string& scenePath, Scene& scene, Camera& camera,
+                               const Image& image, const std::string& cachePath);
+
+    /**
+     * Empreinte de la scène: FNV-1a 64 bits du fichier et des géométries de mesh
+     */
+    static uint64_t hashScene(const std::string& scenePath, const Scene& scene);
+
+    /**
+     * Réglages candidats: constructeurs et largeurs du BVH, tailles de feuille
+     * du découpage médian, grille et kd-tree
+     */
+    static std::vector<AcceleratorSettings> candidates(const AcceleratorSettings& base);
+
+    /**
+     * Applique les réglages à la structure des triangles de tous les meshes
+     */
+    static void setMeshSettings(Scene& scene, const AcceleratorSettings& settings);
+};
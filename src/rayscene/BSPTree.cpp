@@ -1,111 +1,1743 @@
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <limits>
+#include <thread>
 #include "BSPTree.hpp"
+#include "Parallel.hpp"
+
+// Paramètres du constructeur SAH
+static const int SAH_BIN_COUNT = 16;             // Nombre de casiers par axe
+static const double SAH_TRAVERSAL_COST = 1.0;    // Coût relatif d'un test de nœud
+static const double SAH_INTERSECTION_COST = 1.0; // Coût relatif d'un test d'objet
+static const uint32_t SAH_MAX_LEAF_SIZE = 16;    // Au-delà, on coupe même si le SAH préfère une feuille
+
+// Seuils de parallélisation de la construction (nombre de primitives du nœud)
+static const uint32_t BSP_PARALLEL_SUBTREE_THRESHOLD = 4096;   // Sous-arbres construits sur un autre thread
+static const uint32_t BSP_PARALLEL_BINNING_THRESHOLD = 65536;  // Classement SAH réparti entre les threads
+
+// Paramètres du constructeur SBVH (budget de duplication: SBVH_DUPLICATION_BUDGET, BSPTree.hpp)
+static const double SBVH_MIN_OVERLAP = 1e-5;  // Recouvrement (relatif à la racine) à partir duquel on tente une coupe spatiale
+
+// Paramètres du constructeur LBVH
+static const uint32_t LBVH_MAX_LEAF_SIZE = 4;                  // Taille de feuille fixe (pas de coût SAH)
+static const uint32_t LBVH_WIDE_CODE_THRESHOLD = 1u << 20;     // Au-delà, codes de 63 bits au lieu de 30
+static const uint32_t LBVH_PARALLEL_SORT_THRESHOLD = 65536;    // Tri par base réparti entre les threads
+
+static double axisValue(const Vector3& v, int axis) {
+    if (axis == 0) return v.x;
+    if (axis == 1) return v.y;
+    return v.z;
+}
+
+/**
+ * Conversion double -> float arrondie vers le bas (resp. le haut):
+ * la boîte float d'un nœud englobe toujours sa boîte double
+ */
+static float toFloatDown(double value) {
+    float f = static_cast<float>(value);
+    if (static_cast<double>(f) > value) {
+        f = std::nextafter(f, -std::numeric_limits<float>::infinity());
+    }
+    return f;
+}
+
+static float toFloatUp(double value) {
+    float f = static_cast<float>(value);
+    if (static_cast<double>(f) < value) {
+        f = std::nextafter(f, std::numeric_limits<float>::infinity());
+    }
+    return f;
+}
+
+/**
+ * Bornes float d'un nœud à partir d'une AABB double, arrondies vers l'extérieur
+ */
+static void setNodeBounds(BSPNode& node, AABB const& box) {
+    Vector3 min = box.getMin();
+    Vector3 max = box.getMax();
+    node.min[0] = toFloatDown(min.x);
+    node.min[1] = toFloatDown(min.y);
+    node.min[2] = toFloatDown(min.z);
+    node.max[0] = toFloatUp(max.x);
+    node.max[1] = toFloatUp(max.y);
+    node.max[2] = toFloatUp(max.z);
+}
+
+/**
+ * Bornes d'un nœud interne: union de celles de ses enfants (déjà conservatives)
+ */
+static void mergeChildBounds(BSPNode& node, const BSPNode& left, const BSPNode& right) {
+    for (int axis = 0; axis < 3; ++axis) {
+        node.min[axis] = std::min(left.min[axis], right.min[axis]);
+        node.max[axis] = std::max(left.max[axis], right.max[axis]);
+    }
+}
+
+/**
+ * Surface d'un nœud, 0 si elle n'est pas finie pour ne pas fausser le coût SAH
+ */
+static double nodeArea(const BSPNode& node) {
+    double dx = static_cast<double>(node.max[0]) - node.min[0];
+    double dy = static_cast<double>(node.max[1]) - node.min[1];
+    double dz = static_cast<double>(node.max[2]) - node.min[2];
+    double area = 2.0 * (dx * dy + dy * dz + dz * dx);
+    return std::isfinite(area) ? area : 0.0;
+}
+
+// Marge relative sur la sortie de boîte (Ize, « Robust BVH Ray Traversal », 2013): un rayon
+// qui ne fait qu'effleurer le coin d'une boîte ne la manque pas à un arrondi près
+static const double BSP_SLAB_FAR_SCALE = 1.0 + 4 * std::numeric_limits<double>::epsilon();
+
+// Décalage des plans des faces vers l'extérieur (voir intersectsNode)
+static const double BSP_SLAB_PLANE_OFFSET = std::numeric_limits<double>::min();
+
+/**
+ * Test rayon-nœud: même formulation que AABB::intersects, l'inverse de la
+ * direction étant calculé une seule fois par rayon et non une fois par nœud.
+ * Un rayon parallèle à un axe, d'origine dans le plan d'une face, calculait
+ * 0 * inf = NaN et manquait la boîte; décalée du plus petit double normal, la
+ * distance à ce plan garde son signe: -inf en entrée, +inf en sortie, la face
+ * ne coupe plus le rayon. Les autres distances ne changent pas à l'arrondi près.
+ * @param tEntry distance d'entrée dans la boîte (négative si l'origine est dedans)
+ */
+static inline bool intersectsNode(const BSPNode& node, const Vector3& o, const Vector3& dInv, double& tEntry) {
+    double tx1 = (node.min[0] - o.x - BSP_SLAB_PLANE_OFFSET) * dInv.x;
+    double tx2 = (node.max[0] - o.x + BSP_SLAB_PLANE_OFFSET) * dInv.x;
+
+    double tmin = std::min(tx1, tx2);
+    double tmax = std::max(tx1, tx2);
+
+    double ty1 = (node.min[1] - o.y - BSP_SLAB_PLANE_OFFSET) * dInv.y;
+    double ty2 = (node.max[1] - o.y + BSP_SLAB_PLANE_OFFSET) * dInv.y;
+
+    tmin = std::max(tmin, std::min(ty1, ty2));
+    tmax = std::min(tmax, std::max(ty1, ty2));
+
+    double tz1 = (node.min[2] - o.z - BSP_SLAB_PLANE_OFFSET) * dInv.z;
+    double tz2 = (node.max[2] - o.z + BSP_SLAB_PLANE_OFFSET) * dInv.z;
+
+    tmin = std::max(tmin, std::min(tz1, tz2));
+    tmax = std::min(tmax, std::max(tz1, tz2));
+
+    tEntry = tmin;
+    tmax *= BSP_SLAB_FAR_SCALE;
+    return tmax >= tmin && tmax > 0;
+}
+
+/**
+ * Vrai si une boîte entrée à tEntry peut contenir un impact plus proche que le
+ * meilleur actuel (les distances sont comparées au carré, comme dans Scene)
+ */
+static inline bool mayBeCloser(double tEntry, double closestDistanceSquared) {
+    return closestDistanceSquared < 0 || tEntry <= 0 || tEntry * tEntry <= closestDistanceSquared;
+}
 
 // ============================================================================
-// BSPNode Implementation
+// BSPTree Implementation
 // ============================================================================
 
-BSPNode::BSPNode() : left(nullptr), right(nullptr), isLeaf(false) {}
+BSPTree::BSPTree() {}
+
+BSPTree::~BSPTree() {
+    // Les objets ne sont pas détruits ici, ils appartiennent à la Scene
+}
+
+/**
+ * Construit l'arbre BSP à partir des objets de la scène
+ *
+ * ALGORITHME (BUILD_MEDIAN):
+ * 1. Calculer l'AABB englobant tous les objets
+ * 2. Si peu d'objets ou profondeur max: créer une feuille
+ * 3. Sinon: diviser l'espace en deux selon l'axe le plus long
+ * 4. Récurser sur chaque moitié
+ *
+ * ALGORITHME (BUILD_SAH): voir buildSAHRecursive
+ * ALGORITHME (BUILD_LBVH): voir buildLBVH
+ * ALGORITHME (BUILD_SBVH): voir buildSBVHRecursive
+ *
+ * Les objets non bornés (plans) restent hors de l'arbre, dans unboundedIndices:
+ * une boîte infinie rendrait infinies la racine et tous les ancêtres de sa
+ * feuille, visités alors par tous les rayons. Ils sont testés à part, avant
+ * l'arbre, ce qui fournit souvent un premier impact pour élaguer le parcours.
+ *
+ * Les constructeurs permutent primIndices sur place et émettent les
+ * nœuds directement dans le tableau final, en ordre profondeur d'abord.
+ *
+ * MULTITHREADING: les grands sous-arbres sont construits en parallèle
+ * (voir buildChildren) et le classement SAH des grands nœuds est réparti
+ * entre les threads, avec le même nombre de threads que le rendu.
+ */
+void BSPTree::build(std::vector<SceneObject*>& objects, BSPBuildStrategy strategy, int maxDepth, int minObjects) {
+    this->objects = objects;
+    primitives = nullptr;
+    buildTree(strategy, maxDepth, minObjects);
+}
+
+void BSPTree::build(const PrimitiveSet& primitives) {
+    objects.clear();
+    this->primitives = &primitives;
+    buildTree(configuredStrategy, configuredMaxDepth, configuredMinObjects);
+}
+
+void BSPTree::buildTree(BSPBuildStrategy strategy, int maxDepth, int minObjects) {
+    nodes.clear();
+    primIndices.clear();
+    unboundedIndices.clear();
+    builtStrategy = strategy;
+    builtMaxDepth = maxDepth;
+    builtMinObjects = minObjects;
+    builtCost = 0;
+    primBatch = primitives ? std::max<uint32_t>(1, primitives->batchSize()) : 1;
+    incrementalReady = false;
+    parents.clear();
+    heights.clear();
+    primLeaf.clear();
+    primOf.clear();
+    freePrims.clear();
+    freeSlots.clear();
+
+    // Boîtes des primitives compactes calculées une fois: les constructeurs les relisent à chaque niveau
+    const uint32_t total = static_cast<uint32_t>(primitiveCount());
+    if (primitives) {
+        primBoxes.resize(total);
+        parallelFor(0, total, getThreadCount(), [this](size_t begin, size_t end, unsigned int) {
+            for (size_t i = begin; i < end; ++i) {
+                primBoxes[i] = primitives->bounds(static_cast<uint32_t>(i));
+            }
+        });
+    }
+
+    // Objets non bornés (ou boîte NaN): liste à part, hors de l'arbre
+    for (uint32_t i = 0; i < total; ++i) {
+        if (primitiveBounds(i).isFinite()) {
+            primIndices.push_back(i);
+        } else {
+            unboundedIndices.push_back(i);
+        }
+    }
+    unboundedIndices.shrink_to_fit();
+
+    if (primIndices.empty()) {
+        primBoxes.clear();
+        collapse();
+        return;
+    }
+
+    const uint32_t count = static_cast<uint32_t>(primIndices.size());
+    const unsigned int threads = getThreadCount();
+    centroids.resize(total);
+    parallelFor(0, count, threads, [this](size_t begin, size_t end, unsigned int) {
+        for (size_t i = begin; i < end; ++i) {
+            const AABB box = primitiveBounds(primIndices[i]);
+            centroids[primIndices[i]] = (box.getMin() + box.getMax()) * 0.5;
+        }
+    });
+
+    // Un arbre équilibré a environ 2n/taille_feuille nœuds
+    nodes.reserve(2 * count);
+
+    if (strategy == BUILD_SAH) {
+        buildSAHRecursive(0, count, 0, nodes, threads);
+    } else if (strategy == BUILD_LBVH) {
+        buildLBVH(0, count, nodes, threads);
+    } else if (strategy == BUILD_SBVH) {
+        // Les feuilles réécrivent primIndices, une primitive pouvant y apparaître plusieurs fois
+        std::vector<BSPReference> refs(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            refs[i].prim = primIndices[i];
+            refs[i].box = primitiveBounds(primIndices[i]);
+        }
+        const double rootArea = computeBoundingBox(0, count).surfaceArea();
+        const size_t budget = static_cast<size_t>(count * SBVH_DUPLICATION_BUDGET);
+        primIndices.clear();
+        primIndices.reserve(count + budget);
+        buildSBVHRecursive(refs, 0, budget, rootArea, nodes, primIndices, threads);
+        primIndices.shrink_to_fit();
+    } else {
+        // La pile de parcours est dimensionnée pour BSP_MAX_DEPTH niveaux
+        buildRecursive(0, count, 0, std::min(maxDepth, BSP_MAX_DEPTH - 1), minObjects, nodes, threads);
+    }
+
+    nodes.shrink_to_fit();
+    centroids.clear();
+    centroids.shrink_to_fit();
+    primBoxes.clear();
+
+    // Primitives compactes: indices croissants dans chaque feuille. Un PrimitiveSet
+    // qui range ses primitives par type (ScenePrimitives) y trouve des plages contiguës
+    if (primitives) {
+        for (const BSPNode& node : nodes) {
+            if (node.isLeaf()) {
+                std::sort(primIndices.begin() + node.primOffset, primIndices.begin() + node.primOffset + node.count());
+            }
+        }
+    }
+    primBoxes.shrink_to_fit();
+
+    builtCost = computeSAHCost();
+    collapse();
+}
+
+bool BSPTree::configure(const AcceleratorSettings& settings) {
+    configuredStrategy = settings.builder;
+    configuredMaxDepth = settings.maxDepth;
+    configuredMinObjects = settings.minObjects;
+    setLayout(settings.bvhWidth, settings.bvhQuantization);
+    return builtStrategy == configuredStrategy
+        && (builtStrategy != BUILD_MEDIAN || (builtMaxDepth == configuredMaxDepth && builtMinObjects == configuredMinObjects));
+}
+
+void BSPTree::build(std::vector<SceneObject*>& objects) {
+    build(objects, configuredStrategy, configuredMaxDepth, configuredMinObjects);
+}
+
+/**
+ * Recalcule les bornes sans toucher à la topologie
+ *
+ * ALGORITHME:
+ * 1. Les feuilles reprennent l'union des boundingBox (à jour) de leurs objets
+ * 2. Les nœuds internes sont recalculés après leurs enfants (parcours postfixe:
+ *    après insert/remove, un enfant peut précéder son parent dans le tableau)
+ * 3. Le coût SAH du résultat est comparé à celui de la construction
+ *
+ * Complexité O(n) sans tri ni allocation, contre O(n log n) pour build().
+ */
+bool BSPTree::refit() {
+    if (nodes.empty()) {
+        // Arbre vide, ou nœuds binaires libérés par le format compressé
+        return primIndices.empty();
+    }
+
+    if (!refitNode(0)) {
+        // Un objet de l'arbre est devenu non borné: il doit passer dans unboundedIndices
+        return false;
+    }
+
+    collapse();
+
+    // Des objets qui se croisent ou s'éloignent de leurs voisins gonflent les nœuds
+    return computeSAHCost() <= builtCost * BSP_REFIT_MAX_DEGRADATION;
+}
+
+bool BSPTree::refitNode(uint32_t index) {
+    BSPNode& node = nodes[index];
+    if (node.isLeaf()) {
+        AABB box = computeBoundingBox(node.primOffset, node.primOffset + node.count());
+        if (!box.isFinite()) {
+            return false;
+        }
+        setNodeBounds(node, box);
+        return true;
+    }
+    if (!refitNode(node.left) || !refitNode(node.right)) {
+        return false;
+    }
+    mergeChildBounds(node, nodes[node.left], nodes[node.right]);
+    return true;
+}
+
+/*
+ * OPTIMISATION : Insertion et retrait incrémentaux
+ *
+ * CODE AVANT :
+ *   scene.add(sphere);   // treeDirty = true
+ *   scene.prepare();     // build(): O(n log n) pour un seul objet de plus
+ *
+ * CODE APRÈS :
+ *   scene.add(sphere);   // BSPTree::insert: descente + remontée, O(log n)
+ *   scene.prepare();     // refit() en O(n), reconstruction seulement si le coût SAH s'est dégradé
+ *
+ * Les nœuds restent dans un seul tableau: les nouveaux sont ajoutés à la fin,
+ * les nœuds libérés sont comblés par le dernier (tableau toujours dense, sans
+ * trou pour computeSAHCost ni collapse). Seule la racine a une place fixe (0).
+ */
+bool BSPTree::prepareIncremental() {
+    if (incrementalReady) {
+        return true;
+    }
+    if (nodes.empty() && !primIndices.empty()) {
+        return false;  // Nœuds binaires libérés par le format compressé
+    }
+
+    // Juste après build(), un enfant suit toujours son parent: les hauteurs se calculent à rebours
+    parents.assign(nodes.size(), BSP_NO_NODE);
+    heights.assign(nodes.size(), 0);
+    primLeaf.assign(objects.size(), BSP_NO_NODE);
+    for (size_t i = nodes.size(); i-- > 0;) {
+        const BSPNode& node = nodes[i];
+        if (node.isLeaf()) {
+            for (uint32_t k = 0; k < node.count(); ++k) {
+                uint32_t& leaf = primLeaf[primIndices[node.primOffset + k]];
+                leaf = leaf == BSP_NO_NODE ? static_cast<uint32_t>(i) : BSP_MULTI_LEAF;
+            }
+        } else {
+            parents[node.left] = static_cast<uint32_t>(i);
+            parents[node.right] = static_cast<uint32_t>(i);
+            heights[i] = 1 + std::max(heights[node.left], heights[node.right]);
+        }
+    }
+
+    primOf.clear();
+    primOf.reserve(objects.size());
+    for (uint32_t i = 0; i < objects.size(); ++i) {
+        primOf[objects[i]] = i;
+    }
+    freePrims.clear();
+    freeSlots.clear();
+    incrementalReady = true;
+    return true;
+}
+
+bool BSPTree::insert(SceneObject* object) {
+    if (primitives) {
+        return false;
+    }
+    if (!prepareIncremental() || primOf.count(object) != 0) {
+        return false;
+    }
+    const AABB& box = object->boundingBox;
+    const bool bounded = box.isFinite();
+    if (bounded && !nodes.empty() && heights[0] + 2 >= static_cast<uint32_t>(BSP_MAX_DEPTH)) {
+        return false;  // La pile de parcours ne suffirait plus
+    }
+
+    uint32_t prim;
+    if (!freePrims.empty()) {
+        prim = freePrims.back();
+        freePrims.pop_back();
+        objects[prim] = object;
+    } else {
+        prim = static_cast<uint32_t>(objects.size());
+        objects.push_back(object);
+        primLeaf.push_back(BSP_NO_NODE);
+    }
+    primOf[object] = prim;
+    if (!bounded) {
+        unboundedIndices.push_back(prim);
+        return true;
+    }
+
+    BSPNode leaf;
+    setNodeBounds(leaf, box);
+    leaf.primCount = 1u | BSP_LEAF_FLAG;
+    if (!freeSlots.empty()) {
+        // Chaque remove() libère un emplacement: primIndices ne dépasse pas le nombre de primitives
+        leaf.primOffset = freeSlots.back();
+        freeSlots.pop_back();
+        primIndices[leaf.primOffset] = prim;
+    } else {
+        leaf.primOffset = static_cast<uint32_t>(primIndices.size());
+        primIndices.push_back(prim);
+    }
+    wideStale = true;
+
+    if (nodes.empty()) {
+        primLeaf[prim] = appendNode(leaf, BSP_NO_NODE, 0);
+        return true;
+    }
+
+    // Descente vers le frère le moins coûteux: un nouveau parent à la place du nœud
+    // courant coûte sa surface, descendre agrandit le nœud courant (coût hérité)
+    uint32_t sibling = 0;
+    while (!nodes[sibling].isLeaf()) {
+        const BSPNode& node = nodes[sibling];
+        BSPNode combined;
+        mergeChildBounds(combined, node, leaf);
+        const double combinedArea = nodeArea(combined);
+        const double cost = 2.0 * combinedArea;
+        const double inheritance = 2.0 * (combinedArea - nodeArea(node));
+
+        auto descendCost = [&leaf, inheritance](const BSPNode& child) {
+            BSPNode merged;
+            mergeChildBounds(merged, child, leaf);
+            const double area = nodeArea(merged);
+            return (child.isLeaf() ? area : area - nodeArea(child)) + inheritance;
+        };
+        const double leftCost = descendCost(nodes[node.left]);
+        const double rightCost = descendCost(nodes[node.right]);
+        if (cost < leftCost && cost < rightCost) {
+            break;
+        }
+        sibling = leftCost < rightCost ? node.left : node.right;
+    }
+
+    const uint32_t leafIndex = appendNode(leaf, BSP_NO_NODE, 0);
+    primLeaf[prim] = leafIndex;
+
+    BSPNode parent;
+    mergeChildBounds(parent, nodes[sibling], leaf);
+    parent.right = leafIndex;
+    uint32_t parentIndex;
+    if (sibling == 0) {
+        // La racine garde l'index 0: l'ancienne racine passe en fin de tableau
+        const uint32_t moved = appendNode(nodes[0], BSP_NO_NODE, 0);
+        moveNode(0, moved);
+        parentIndex = 0;
+        parent.left = moved;
+        nodes[0] = parent;
+        parents[moved] = 0;
+        heights[0] = heights[moved] + 1;
+    } else {
+        const uint32_t grand = parents[sibling];
+        parent.left = sibling;
+        parentIndex = appendNode(parent, grand, heights[sibling] + 1);
+        replaceChild(grand, sibling, parentIndex);
+        parents[sibling] = parentIndex;
+    }
+    parents[leafIndex] = parentIndex;
+    refitUpward(parents[parentIndex]);
+    return true;
+}
+
+bool BSPTree::remove(SceneObject* object) {
+    if (primitives) {
+        return false;
+    }
+    if (!prepareIncremental()) {
+        return false;
+    }
+    auto found = primOf.find(object);
+    if (found == primOf.end() || primLeaf[found->second] == BSP_MULTI_LEAF) {
+        return false;
+    }
+    const uint32_t prim = found->second;
+    const uint32_t leaf = primLeaf[prim];
+    primOf.erase(found);
+    objects[prim] = nullptr;
+    primLeaf[prim] = BSP_NO_NODE;
+    freePrims.push_back(prim);
+
+    if (leaf == BSP_NO_NODE) {
+        unboundedIndices.erase(std::find(unboundedIndices.begin(), unboundedIndices.end(), prim));
+        return true;
+    }
+
+    // La primitive quitte la plage de sa feuille (échangée avec la dernière)
+    wideStale = true;
+    BSPNode& node = nodes[leaf];
+    const uint32_t begin = node.primOffset;
+    const uint32_t count = node.count() - 1;
+    std::iter_swap(std::find(primIndices.begin() + begin, primIndices.begin() + begin + count, prim),
+                   primIndices.begin() + begin + count);
+    node.primCount = count | BSP_LEAF_FLAG;
+    freeSlots.push_back(begin + count);
+    if (count > 0) {
+        setNodeBounds(node, computeBoundingBox(begin, begin + count));
+        refitUpward(parents[leaf]);
+        return true;
+    }
+
+    // Feuille vide: son frère prend la place de leur parent
+    const uint32_t parent = parents[leaf];
+    if (parent == BSP_NO_NODE) {
+        nodes.clear();
+        parents.clear();
+        heights.clear();
+        primIndices.clear();
+        freeSlots.clear();
+        return true;
+    }
+    const uint32_t sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+    const uint32_t grand = parents[parent];
+    if (grand == BSP_NO_NODE) {
+        moveNode(sibling, 0);
+        parents[0] = BSP_NO_NODE;
+        releaseNode(std::max(sibling, leaf));
+        releaseNode(std::min(sibling, leaf));
+    } else {
+        replaceChild(grand, parent, sibling);
+        parents[sibling] = grand;
+        refitUpward(grand);
+        releaseNode(std::max(parent, leaf));
+        releaseNode(std::min(parent, leaf));
+    }
+    return true;
+}
+
+/**
+ * Rotations (Kopta et al., Catto): à chaque ancêtre A d'enfants B et C, on peut
+ * échanger B avec un enfant de C (ou C avec un enfant de B). On garde l'échange
+ * qui réduit le plus la surface de l'enfant modifié, si la hauteur de A ne
+ * croît pas: l'arbre se réoptimise localement au fil des modifications.
+ */
+void BSPTree::refitUpward(uint32_t index) {
+    while (index != BSP_NO_NODE) {
+        BSPNode& node = nodes[index];
+        mergeChildBounds(node, nodes[node.left], nodes[node.right]);
+        heights[index] = 1 + std::max(heights[node.left], heights[node.right]);
+        rotate(index);
+        index = parents[index];
+    }
+}
+
+void BSPTree::rotate(uint32_t index) {
+    const uint32_t children[2] = {nodes[index].left, nodes[index].right};
+    double bestGain = 0;
+    uint32_t bestChild = BSP_NO_NODE;      // Enfant de index qui descend
+    uint32_t bestGrandchild = BSP_NO_NODE; // Petit-enfant qui monte
+
+    for (int side = 0; side < 2; ++side) {
+        const uint32_t moving = children[side];
+        const uint32_t other = children[1 - side];
+        const BSPNode& otherNode = nodes[other];
+        if (otherNode.isLeaf()) {
+            continue;
+        }
+        const double otherArea = nodeArea(otherNode);
+        const uint32_t grandchildren[2] = {otherNode.left, otherNode.right};
+        for (int g = 0; g < 2; ++g) {
+            const uint32_t up = grandchildren[g];
+            const uint32_t stays = grandchildren[1 - g];
+            // other devient l'union de moving et de stays
+            BSPNode merged;
+            mergeChildBounds(merged, nodes[moving], nodes[stays]);
+            const double gain = nodeArea(merged) - otherArea;
+            const uint32_t otherHeight = 1 + std::max(heights[moving], heights[stays]);
+            const uint32_t height = 1 + std::max(heights[up], otherHeight);
+            if (gain < bestGain && height <= heights[index]) {
+                bestGain = gain;
+                bestChild = moving;
+                bestGrandchild = up;
+            }
+        }
+    }
+    if (bestChild == BSP_NO_NODE || bestGain > -1e-9 * nodeArea(nodes[index])) {
+        return;
+    }
+
+    const uint32_t other = parents[bestGrandchild];
+    replaceChild(index, bestChild, bestGrandchild);
+    replaceChild(other, bestGrandchild, bestChild);
+    parents[bestGrandchild] = index;
+    parents[bestChild] = other;
+    BSPNode& otherNode = nodes[other];
+    mergeChildBounds(otherNode, nodes[otherNode.left], nodes[otherNode.right]);
+    heights[other] = 1 + std::max(heights[otherNode.left], heights[otherNode.right]);
+    heights[index] = 1 + std::max(heights[nodes[index].left], heights[nodes[index].right]);
+}
+
+uint32_t BSPTree::appendNode(const BSPNode& node, uint32_t parent, uint32_t height) {
+    const BSPNode copy = node;  // node peut désigner un élément de nodes, invalidé par push_back
+    nodes.push_back(copy);
+    parents.push_back(parent);
+    heights.push_back(height);
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+void BSPTree::replaceChild(uint32_t parent, uint32_t oldChild, uint32_t newChild) {
+    BSPNode& node = nodes[parent];
+    if (node.left == oldChild) {
+        node.left = newChild;
+    } else {
+        node.right = newChild;
+    }
+}
+
+void BSPTree::moveNode(uint32_t from, uint32_t to) {
+    nodes[to] = nodes[from];
+    heights[to] = heights[from];
+    const BSPNode& node = nodes[to];
+    if (node.isLeaf()) {
+        for (uint32_t k = 0; k < node.count(); ++k) {
+            uint32_t& leaf = primLeaf[primIndices[node.primOffset + k]];
+            if (leaf != BSP_MULTI_LEAF) {
+                leaf = to;
+            }
+        }
+    } else {
+        parents[node.left] = to;
+        parents[node.right] = to;
+    }
+}
+
+void BSPTree::releaseNode(uint32_t index) {
+    const uint32_t last = static_cast<uint32_t>(nodes.size() - 1);
+    if (index != last) {
+        moveNode(last, index);
+        parents[index] = parents[last];
+        if (parents[last] != BSP_NO_NODE) {
+            replaceChild(parents[last], last, index);
+        }
+    }
+    nodes.pop_back();
+    parents.pop_back();
+    heights.pop_back();
+}
+
+void BSPTree::setLayout(int width, int quantizationBits) {
+    width = (width == 4 || width == 8) ? width : 2;
+    quantizationBits = (width != 2 && (quantizationBits == 8 || quantizationBits == 16)) ? quantizationBits : 0;
+    if (width != this->width || quantizationBits != this->quantizationBits) {
+        const bool released = nodes.empty() && !primIndices.empty();
+        this->width = width;
+        this->quantizationBits = quantizationBits;
+        if (released) {
+            if (primitives) {
+                buildTree(builtStrategy, builtMaxDepth, builtMinObjects);
+            } else {
+                std::vector<SceneObject*> previous = objects;
+                build(previous, builtStrategy, builtMaxDepth, builtMinObjects);
+            }
+        } else {
+            collapse();
+        }
+    }
+}
+
+/**
+ * Priorité d'ouverture d'un nœud binaire lors de l'aplatissement: sa surface
+ */
+static double collapsePriority(const BSPNode& node) {
+    double dx = static_cast<double>(node.max[0]) - node.min[0];
+    double dy = static_cast<double>(node.max[1]) - node.min[1];
+    double dz = static_cast<double>(node.max[2]) - node.min[2];
+    return dx * dy + dy * dz + dz * dx;
+}
+
+void BSPTree::collapse() {
+    wideStale = false;
+    wideNodes4.clear();
+    wideNodes8.clear();
+    quantizedNodes4x8.clear();
+    quantizedNodes4x16.clear();
+    quantizedNodes8x8.clear();
+    quantizedNodes8x16.clear();
+    if (nodes.empty()) {
+        return;
+    }
+
+    if (width == 4) {
+        wideNodes4.reserve(nodes.size() / 3 + 1);
+        collapseNode(0, wideNodes4);
+        if (quantizationBits == 8) {
+            quantize(wideNodes4, quantizedNodes4x8);
+        } else if (quantizationBits == 16) {
+            quantize(wideNodes4, quantizedNodes4x16);
+        }
+    } else if (width == 8) {
+        wideNodes8.reserve(nodes.size() / 7 + 1);
+        collapseNode(0, wideNodes8);
+        if (quantizationBits == 8) {
+            quantize(wideNodes8, quantizedNodes8x8);
+        } else if (quantizationBits == 16) {
+            quantize(wideNodes8, quantizedNodes8x16);
+        }
+    }
+
+    // Seul le format parcouru est conservé
+    if (quantizationBits != 0) {
+        std::vector<BSPWideNode<4>>().swap(wideNodes4);
+        std::vector<BSPWideNode<8>>().swap(wideNodes8);
+        std::vector<BSPNode>().swap(nodes);
+        incrementalReady = false;
+    }
+    wideNodes4.shrink_to_fit();
+    wideNodes8.shrink_to_fit();
+}
+
+template <int N, typename Q>
+void BSPTree::quantize(const std::vector<BSPWideNode<N>>& wide, std::vector<BSPQuantizedNode<N, Q>>& out) {
+    out.resize(wide.size());
+    for (size_t i = 0; i < wide.size(); ++i) {
+        out[i].encode(wide[i]);
+    }
+}
+
+BSPMemoryStats BSPTree::getMemoryStats() const {
+    BSPMemoryStats stats;
+    stats.primitiveCount = primitiveCount();
+    stats.binaryNodeCount = nodes.size();
+    stats.binaryNodeBytes = nodes.capacity() * sizeof(BSPNode);
+    stats.primIndexBytes = (primIndices.capacity() + unboundedIndices.capacity()) * sizeof(uint32_t);
+
+    auto traversal = [&stats](size_t count, size_t capacity, size_t nodeSize) {
+        if (count > 0) {
+            stats.traversalNodeCount = count;
+            stats.traversalNodeSize = nodeSize;
+            stats.traversalNodeBytes = capacity * nodeSize;
+        }
+    };
+    stats.traversalNodeCount = nodes.size();
+    stats.traversalNodeSize = sizeof(BSPNode);
+    traversal(wideNodes4.size(), wideNodes4.capacity(), sizeof(BSPWideNode<4>));
+    traversal(wideNodes8.size(), wideNodes8.capacity(), sizeof(BSPWideNode<8>));
+    traversal(quantizedNodes4x8.size(), quantizedNodes4x8.capacity(), sizeof(BSPQuantizedNode<4, uint8_t>));
+    traversal(quantizedNodes4x16.size(), quantizedNodes4x16.capacity(), sizeof(BSPQuantizedNode<4, uint16_t>));
+    traversal(quantizedNodes8x8.size(), quantizedNodes8x8.capacity(), sizeof(BSPQuantizedNode<8, uint8_t>));
+    traversal(quantizedNodes8x16.size(), quantizedNodes8x16.capacity(), sizeof(BSPQuantizedNode<8, uint16_t>));
+    return stats;
+}
+
+template <int N>
+uint32_t BSPTree::collapseNode(uint32_t binaryIndex, std::vector<BSPWideNode<N>>& out) {
+    // Sous-arbres binaires regroupés dans ce nœud large
+    uint32_t children[N];
+    int childCount = 0;
+    const BSPNode& root = nodes[binaryIndex];
+    if (root.isLeaf()) {
+        children[childCount++] = binaryIndex;
+    } else {
+        children[childCount++] = root.left;
+        children[childCount++] = root.right;
+    }
+
+    while (childCount < N) {
+        int best = -1;
+        double bestPriority = -1;
+        for (int i = 0; i < childCount; ++i) {
+            const BSPNode& child = nodes[children[i]];
+            if (!child.isLeaf() && collapsePriority(child) > bestPriority) {
+                bestPriority = collapsePriority(child);
+                best = i;
+            }
+        }
+        if (best < 0) {
+            break;  // Que des feuilles
+        }
+        const BSPNode& opened = nodes[children[best]];
+        children[best] = opened.left;
+        children[childCount++] = opened.right;
+    }
+
+    // Bornes et feuilles d'abord: out peut être réalloué par la récursion
+    const uint32_t index = static_cast<uint32_t>(out.size());
+    out.emplace_back();
+    BSPWideNode<N>& wide = out[index];
+    for (int i = 0; i < N; ++i) {
+        if (i < childCount) {
+            const BSPNode& child = nodes[children[i]];
+            for (int axis = 0; axis < 3; ++axis) {
+                wide.bounds[axis][i] = child.min[axis];
+                wide.bounds[axis + 3][i] = child.max[axis];
+            }
+            wide.child[i] = child.isLeaf() ? child.primOffset : 0;
+            wide.primCount[i] = child.isLeaf() ? (child.count() | WIDE_LEAF_FLAG) : 0;
+        } else {
+            // Emplacement vide: boîte inversée, jamais touchée
+            for (int axis = 0; axis < 3; ++axis) {
+                wide.bounds[axis][i] = std::numeric_limits<float>::infinity();
+                wide.bounds[axis + 3][i] = -std::numeric_limits<float>::infinity();
+            }
+            wide.child[i] = 0;
+            wide.primCount[i] = WIDE_LEAF_FLAG;
+        }
+    }
+
+    for (int i = 0; i < childCount; ++i) {
+        if (!nodes[children[i]].isLeaf()) {
+            uint32_t childIndex = collapseNode(children[i], out);
+            out[index].child[i] = childIndex;
+        }
+    }
+    return index;
+}
+
+/**
+ * Coût SAH de l'arbre: somme des surfaces des nœuds pondérées par leur coût,
+ * rapportée à la surface de l'union des feuilles bornées (invariant d'échelle)
+ */
+double BSPTree::intersectionCost(uint32_t count) const {
+    return SAH_INTERSECTION_COST * ((count + primBatch - 1) / primBatch);
+}
+
+double BSPTree::computeSAHCost() const {
+    double cost = 0;
+    float min[3] = {std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity()};
+    float max[3] = {-std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()};
+
+    for (const BSPNode& node : nodes) {
+        double area = nodeArea(node);
+        if (!node.isLeaf()) {
+            cost += SAH_TRAVERSAL_COST * area;
+        } else if (area > 0) {
+            cost += area * intersectionCost(node.count());
+            for (int axis = 0; axis < 3; ++axis) {
+                min[axis] = std::min(min[axis], node.min[axis]);
+                max[axis] = std::max(max[axis], node.max[axis]);
+            }
+        }
+    }
+
+    BSPNode bounds;
+    std::copy(min, min + 3, bounds.min);
+    std::copy(max, max + 3, bounds.max);
+    double rootArea = nodeArea(bounds);
+    return rootArea > 0 ? cost / rootArea : 0;
+}
+
+/**
+ * Statistiques de l'arbre binaire, parcouru en profondeur avec une pile explicite
+ * Recouvrement des frères: un BVH partitionne les objets, pas l'espace; plus les
+ * boîtes des deux enfants se chevauchent, plus un rayon doit descendre dans les deux.
+ */
+BSPTreeStats BSPTree::computeStats() const {
+    BSPTreeStats stats;
+    stats.memory = getMemoryStats();
+    stats.unboundedCount = unboundedIndices.size();
+    stats.leafSizes.assign(BSP_STATS_MAX_LEAF_SIZE + 1, 0);
+    if (nodes.empty()) {
+        return stats;
+    }
+
+    stats.hasBinaryTree = true;
+    stats.nodeCount = nodes.size();
+    stats.sahCost = computeSAHCost();
+
+    size_t depthSum = 0;
+    size_t internalCount = 0;
+    double overlapSum = 0;
+    std::vector<std::pair<uint32_t, int>> stack;
+    stack.push_back({0, 0});
+    while (!stack.empty()) {
+        const uint32_t index = stack.back().first;
+        const int depth = stack.back().second;
+        stack.pop_back();
+        const BSPNode& node = nodes[index];
+
+        if (node.isLeaf()) {
+            stats.leafCount++;
+            stats.referenceCount += node.count();
+            stats.leafSizes[std::min<uint32_t>(node.count(), BSP_STATS_MAX_LEAF_SIZE)]++;
+            stats.maxDepth = std::max(stats.maxDepth, depth);
+            depthSum += depth;
+            continue;
+        }
+
+        // Boîte commune aux deux enfants (vide si min > max sur un axe)
+        const BSPNode& left = nodes[node.left];
+        const BSPNode& right = nodes[node.right];
+        BSPNode overlap;
+        bool empty = false;
+        for (int axis = 0; axis < 3; ++axis) {
+            overlap.min[axis] = std::max(left.min[axis], right.min[axis]);
+            overlap.max[axis] = std::min(left.max[axis], right.max[axis]);
+            empty = empty || overlap.min[axis] > overlap.max[axis];
+        }
+        const double parentArea = nodeArea(node);
+        const double ratio = (!empty && parentArea > 0) ? nodeArea(overlap) / parentArea : 0;
+        overlapSum += ratio;
+        stats.maxSiblingOverlap = std::max(stats.maxSiblingOverlap, ratio);
+        internalCount++;
+
+        stack.push_back({node.right, depth + 1});
+        stack.push_back({node.left, depth + 1});
+    }
+
+    stats.averageLeafDepth = static_cast<double>(depthSum) / stats.leafCount;
+    stats.averageSiblingOverlap = internalCount > 0 ? overlapSum / internalCount : 0;
+    return stats;
+}
+
+uint32_t BSPTree::allocateNode(AABB const& box, std::vector<BSPNode>& out) {
+    BSPNode node;
+    setNodeBounds(node, box);
+    node.left = 0;
+    node.right = 0;
+
+    out.push_back(node);
+    return static_cast<uint32_t>(out.size() - 1);
+}
+
+void BSPTree::makeLeaf(BSPNode& node, uint32_t begin, uint32_t end) {
+    node.primOffset = begin;
+    node.primCount = (end - begin) | BSP_LEAF_FLAG;
+}
+
+/**
+ * Construit les deux enfants de out[nodeIndex]
+ *
+ * Pour un grand sous-arbre, l'enfant droit est confié à un nouveau thread qui
+ * l'écrit dans son propre tableau (les plages de primIndices sont disjointes),
+ * puis ce tableau est recopié à la suite de l'enfant gauche avec ses index
+ * décalés: l'ordre profondeur d'abord est conservé.
+ */
+void BSPTree::buildChildren(uint32_t nodeIndex, uint32_t begin, uint32_t mid, uint32_t end,
+                            std::vector<BSPNode>& out, unsigned int threads, ChildBuilder const& buildChild) {
+    uint32_t left;
+    uint32_t right;
+
+    if (threads > 1 && end - begin >= BSP_PARALLEL_SUBTREE_THRESHOLD) {
+        std::vector<BSPNode> rightNodes;
+        rightNodes.reserve(2 * (end - mid));
+        unsigned int rightThreads = threads / 2;
+
+        std::thread worker([&]() { buildChild(mid, end, rightNodes, rightThreads); });
+        left = buildChild(begin, mid, out, threads - rightThreads);
+        worker.join();
+
+        right = static_cast<uint32_t>(out.size());
+        for (BSPNode node : rightNodes) {
+            if (!node.isLeaf()) {
+                node.left += right;
+                node.right += right;
+            }
+            out.push_back(node);
+        }
+    } else {
+        // Attention: out peut être réalloué, pas de référence conservée
+        left = buildChild(begin, mid, out, threads);
+        right = buildChild(mid, end, out, threads);
+    }
+
+    out[nodeIndex].left = left;
+    out[nodeIndex].right = right;
+}
+
+uint32_t BSPTree::buildRecursive(uint32_t begin, uint32_t end, int depth, int maxDepth, int minObjects,
+                                 std::vector<BSPNode>& out, unsigned int threads) {
+    AABB box = computeBoundingBox(begin, end);
+    uint32_t nodeIndex = allocateNode(box, out);
+
+    // Condition d'arrêt: peu d'objets ou profondeur max atteinte
+    if (end - begin <= static_cast<uint32_t>(minObjects) || depth >= maxDepth) {
+        makeLeaf(out[nodeIndex], begin, end);
+        return nodeIndex;
+    }
+
+    // Trouver l'axe de division (le plus long)
+    int axis = findSplitAxis(box);
+
+    // Trier les objets selon le centre de leur bounding box sur cet axe
+    std::sort(primIndices.begin() + begin, primIndices.begin() + end, [this, axis](uint32_t a, uint32_t b) {
+        return axisValue(centroids[a], axis) < axisValue(centroids[b], axis);
+    });
+
+    // Diviser au milieu
+    uint32_t mid = begin + (end - begin) / 2;
+
+    // Récursion
+    buildChildren(nodeIndex, begin, mid, end, out, threads,
+        [&](uint32_t childBegin, uint32_t childEnd, std::vector<BSPNode>& childOut, unsigned int childThreads) {
+            return buildRecursive(childBegin, childEnd, depth + 1, maxDepth, minObjects, childOut, childThreads);
+        });
+
+    return nodeIndex;
+}
 
-BSPNode::~BSPNode() {
-    // Les objets ne sont pas détruits ici, ils appartiennent à la Scene
+/**
+ * Casier SAH: nombre de primitives et AABB de celles dont le centre y tombe
+ */
+struct SAHBin {
+    int count = 0;
+    AABB box;
+
+    void add(AABB const& other) {
+        if (count == 0) box = other; else box.subsume(other);
+        count++;
+    }
+
+    void merge(SAHBin const& other) {
+        if (other.count == 0) return;
+        if (count == 0) box = other.box; else box.subsume(other.box);
+        count += other.count;
+    }
+};
+
+/**
+ * Construction SAH par casiers (binned SAH)
+ *
+ * ALGORITHME:
+ * 1. Répartir les centres des AABB dans SAH_BIN_COUNT casiers sur chaque axe
+ * 2. Évaluer chaque frontière entre casiers:
+ *    coût = C_trav + C_inter * (A_gauche * N_gauche + A_droite * N_droite) / A_parent
+ * 3. Si la meilleure coupe coûte plus que la feuille (C_inter * N): créer une feuille
+ * 4. Sinon: partitionner et récurser
+ */
+uint32_t BSPTree::buildSAHRecursive(uint32_t begin, uint32_t end, int depth, std::vector<BSPNode>& out, unsigned int threads) {
+    const uint32_t count = end - begin;
+
+    // Boîte du nœud et bornes des centres, en une passe (parallèle pour les grands nœuds)
+    const unsigned int boundsThreads = count >= BSP_PARALLEL_BINNING_THRESHOLD ? threads : 1;
+    std::vector<AABB> chunkBox(boundsThreads);
+    std::vector<AABB> chunkCentroids(boundsThreads);
+    unsigned int chunks = parallelFor(begin, end, boundsThreads, [&](size_t first, size_t last, unsigned int chunk) {
+        AABB box = primitiveBounds(primIndices[first]);
+        Vector3 c = centroids[primIndices[first]];
+        AABB cBox(c, c);
+        for (size_t i = first + 1; i < last; ++i) {
+            box.subsume(primitiveBounds(primIndices[i]));
+            const Vector3& ci = centroids[primIndices[i]];
+            cBox.subsume(AABB(ci, ci));
+        }
+        chunkBox[chunk] = box;
+        chunkCentroids[chunk] = cBox;
+    });
+    AABB box = chunkBox[0];
+    AABB centroidBox = chunkCentroids[0];
+    for (unsigned int i = 1; i < chunks; ++i) {
+        box.subsume(chunkBox[i]);
+        centroidBox.subsume(chunkCentroids[i]);
+    }
+
+    uint32_t nodeIndex = allocateNode(box, out);
+
+    if (count == 1 || depth >= BSP_MAX_DEPTH - 1) {
+        makeLeaf(out[nodeIndex], begin, end);
+        return nodeIndex;
+    }
+
+    // Étape 1: bornes des centres, puis classement dans les casiers
+    const Vector3 cMin = centroidBox.getMin();
+    const Vector3 cMax = centroidBox.getMax();
+    double scale[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        double extent = axisValue(cMax, axis) - axisValue(cMin, axis);
+        scale[axis] = extent > 0 ? SAH_BIN_COUNT / extent : 0;  // 0: centres alignés sur cet axe
+    }
+
+    // Classement dans les casiers des trois axes en une passe, une copie des casiers par tranche
+    const unsigned int binThreads = count >= BSP_PARALLEL_BINNING_THRESHOLD ? threads : 1;
+    std::vector<SAHBin> chunkBins(binThreads * 3 * SAH_BIN_COUNT);
+    chunks = parallelFor(begin, end, binThreads, [&](size_t first, size_t last, unsigned int chunk) {
+        SAHBin* bins = &chunkBins[chunk * 3 * SAH_BIN_COUNT];
+        for (size_t i = first; i < last; ++i) {
+            uint32_t prim = primIndices[i];
+            const AABB primBox = primitiveBounds(prim);
+            for (int axis = 0; axis < 3; ++axis) {
+                int b = std::min(SAH_BIN_COUNT - 1,
+                                 static_cast<int>((axisValue(centroids[prim], axis) - axisValue(cMin, axis)) * scale[axis]));
+                bins[axis * SAH_BIN_COUNT + b].add(primBox);
+            }
+        }
+    });
+    for (unsigned int chunk = 1; chunk < chunks; ++chunk) {
+        for (int i = 0; i < 3 * SAH_BIN_COUNT; ++i) {
+            chunkBins[i].merge(chunkBins[chunk * 3 * SAH_BIN_COUNT + i]);
+        }
+    }
+
+    // Étape 2: meilleure frontière sur les trois axes
+    const double parentArea = box.surfaceArea();
+    double bestCost = std::numeric_limits<double>::infinity();
+    int bestAxis = -1;
+    int bestSplit = 0;
+
+    for (int axis = 0; axis < 3; ++axis) {
+        if (scale[axis] == 0) {
+            continue;
+        }
+        const SAHBin* bins = &chunkBins[axis * SAH_BIN_COUNT];
+
+        // Balayage de droite à gauche pour les surfaces cumulées
+        double rightArea[SAH_BIN_COUNT];
+        int rightCount[SAH_BIN_COUNT];
+        SAHBin acc;
+        for (int b = SAH_BIN_COUNT - 1; b > 0; --b) {
+            acc.merge(bins[b]);
+            rightArea[b] = acc.count > 0 ? acc.box.surfaceArea() : 0;
+            rightCount[b] = acc.count;
+        }
+
+        // Balayage de gauche à droite: évaluation de chaque frontière
+        acc = SAHBin();
+        for (int b = 0; b < SAH_BIN_COUNT - 1; ++b) {
+            acc.merge(bins[b]);
+            if (acc.count == 0 || rightCount[b + 1] == 0) {
+                continue;
+            }
+            double cost = SAH_TRAVERSAL_COST +
+                (acc.box.surfaceArea() * intersectionCost(acc.count) + rightArea[b + 1] * intersectionCost(rightCount[b + 1])) / parentArea;
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = b;
+            }
+        }
+    }
+
+    // Étape 3: la feuille est-elle moins chère que la meilleure coupe ?
+    const double leafCost = intersectionCost(count);
+    if ((bestAxis < 0 || bestCost >= leafCost) && count <= SAH_MAX_LEAF_SIZE) {
+        makeLeaf(out[nodeIndex], begin, end);
+        return nodeIndex;
+    }
+
+    // Étape 4: partitionner selon la frontière retenue
+    auto first = primIndices.begin() + begin;
+    auto last = primIndices.begin() + end;
+    uint32_t mid = begin;
+    if (bestAxis >= 0) {
+        double lo = axisValue(cMin, bestAxis);
+        double axisScale = scale[bestAxis];
+        auto it = std::partition(first, last, [&](uint32_t prim) {
+            int b = std::min(SAH_BIN_COUNT - 1, static_cast<int>((axisValue(centroids[prim], bestAxis) - lo) * axisScale));
+            return b <= bestSplit;
+        });
+        mid = static_cast<uint32_t>(it - primIndices.begin());
+    }
+    if (mid == begin || mid == end) {
+        // Centres confondus: coupe médiane pour borner la taille des feuilles
+        int axis = findSplitAxis(box);
+        mid = begin + count / 2;
+        std::nth_element(first, primIndices.begin() + mid, last, [this, axis](uint32_t a, uint32_t b) {
+            return axisValue(centroids[a], axis) < axisValue(centroids[b], axis);
+        });
+    }
+
+    buildChildren(nodeIndex, begin, mid, end, out, threads,
+        [&](uint32_t childBegin, uint32_t childEnd, std::vector<BSPNode>& childOut, unsigned int childThreads) {
+            return buildSAHRecursive(childBegin, childEnd, depth + 1, childOut, childThreads);
+        });
+    return nodeIndex;
 }
 
-// ============================================================================
-// BSPTree Implementation
-// ============================================================================
+/**
+ * Casier de coupe spatiale: boîte des morceaux de primitives qui y tombent,
+ * nombre de références qui y commencent et qui y finissent
+ */
+struct SpatialBin {
+    AABB box;
+    bool empty = true;
+    int enter = 0;
+    int exit = 0;
 
-BSPTree::BSPTree() : root(nullptr) {}
+    void add(AABB const& other) {
+        if (other.isEmpty()) return;
+        if (empty) box = other; else box.subsume(other);
+        empty = false;
+    }
+};
 
-BSPTree::~BSPTree() {
-    if (root) {
-        destroyRecursive(root);
+/**
+ * Boîte et surface d'une union de casiers, 0 si vide
+ */
+struct SpatialAccumulator {
+    AABB box;
+    bool empty = true;
+
+    void add(AABB const& other, bool otherEmpty) {
+        if (otherEmpty) return;
+        if (empty) box = other; else box.subsume(other);
+        empty = false;
+    }
+
+    double area() const { return empty ? 0 : box.surfaceArea(); }
+};
+
+/**
+ * Construction SBVH (Stich et al., "Spatial Splits in Bounding Volume Hierarchies")
+ *
+ * ALGORITHME:
+ * 1. Coupe objet: SAH par casiers sur les centres des boîtes des références
+ * 2. Si les deux enfants de la coupe objet se recouvrent notablement (au moins
+ *    SBVH_MIN_OVERLAP de la surface de la racine) et qu'il reste du budget:
+ *    coupe spatiale, SAH_BIN_COUNT casiers répartis sur l'axe le plus long du nœud; une
+ *    référence à cheval sur plusieurs casiers est découpée plan par plan
+ *    (splitBoundingBox) et compte une entrée dans son premier casier et une
+ *    sortie dans le dernier
+ * 3. La coupe la moins chère l'emporte, ou la feuille si elle coûte moins
+ * 4. Coupe spatiale retenue: chaque référence à cheval sur le plan est soit
+ *    dupliquée (un morceau par côté), soit envoyée entière d'un seul côté si
+ *    c'est moins cher ("unsplitting")
+ * 5. Le budget restant est partagé entre les enfants au prorata de leur taille
+ *
+ * Le budget rend la construction déterministe, même en parallèle: chaque
+ * sous-arbre ne consomme que sa part.
+ */
+uint32_t BSPTree::buildSBVHRecursive(std::vector<BSPReference>& refs, int depth, size_t budget, double rootArea,
+                                     std::vector<BSPNode>& out, std::vector<uint32_t>& outIndices, unsigned int threads) {
+    const uint32_t count = static_cast<uint32_t>(refs.size());
+
+    AABB box = refs[0].box;
+    Vector3 c = (refs[0].box.getMin() + refs[0].box.getMax()) * 0.5;
+    AABB centroidBox(c, c);
+    for (uint32_t i = 1; i < count; ++i) {
+        box.subsume(refs[i].box);
+        c = (refs[i].box.getMin() + refs[i].box.getMax()) * 0.5;
+        centroidBox.subsume(AABB(c, c));
+    }
+
+    uint32_t nodeIndex = allocateNode(box, out);
+
+    auto makeRefLeaf = [&](std::vector<BSPReference>& leafRefs) {
+        const uint32_t offset = static_cast<uint32_t>(outIndices.size());
+        for (const BSPReference& ref : leafRefs) {
+            outIndices.push_back(ref.prim);
+        }
+        makeLeaf(out[nodeIndex], offset, static_cast<uint32_t>(outIndices.size()));
+        leafRefs.clear();
+        leafRefs.shrink_to_fit();
+        return nodeIndex;
+    };
+
+    if (count == 1 || depth >= BSP_MAX_DEPTH - 1) {
+        return makeRefLeaf(refs);
+    }
+
+    const double parentArea = box.surfaceArea();
+    const Vector3 cMin = centroidBox.getMin();
+    const Vector3 cMax = centroidBox.getMax();
+
+    // Étape 1: coupe objet (casiers sur les centres)
+    double bestCost = std::numeric_limits<double>::infinity();
+    int objectAxis = -1;
+    int objectSplit = 0;
+    double objectScale = 0;
+    AABB objectLeft;
+    AABB objectRight;
+
+    for (int axis = 0; axis < 3; ++axis) {
+        double extent = axisValue(cMax, axis) - axisValue(cMin, axis);
+        if (extent <= 0) {
+            continue;
+        }
+        const double scale = SAH_BIN_COUNT / extent;
+        SAHBin bins[SAH_BIN_COUNT];
+        for (const BSPReference& ref : refs) {
+            double center = (axisValue(ref.box.getMin(), axis) + axisValue(ref.box.getMax(), axis)) * 0.5;
+            int b = std::min(SAH_BIN_COUNT - 1, static_cast<int>((center - axisValue(cMin, axis)) * scale));
+            bins[b].add(ref.box);
+        }
+
+        SAHBin right[SAH_BIN_COUNT];
+        SAHBin acc;
+        for (int b = SAH_BIN_COUNT - 1; b > 0; --b) {
+            acc.merge(bins[b]);
+            right[b] = acc;
+        }
+        acc = SAHBin();
+        for (int b = 0; b < SAH_BIN_COUNT - 1; ++b) {
+            acc.merge(bins[b]);
+            if (acc.count == 0 || right[b + 1].count == 0) {
+                continue;
+            }
+            double cost = SAH_TRAVERSAL_COST +
+                (acc.box.surfaceArea() * intersectionCost(acc.count) + right[b + 1].box.surfaceArea() * intersectionCost(right[b + 1].count)) / parentArea;
+            if (cost < bestCost) {
+                bestCost = cost;
+                objectAxis = axis;
+                objectSplit = b;
+                objectScale = scale;
+                objectLeft = acc.box;
+                objectRight = right[b + 1].box;
+            }
+        }
+    }
+
+    // Étape 2: coupe spatiale, seulement si les enfants de la coupe objet se recouvrent
+    int spatialAxis = -1;
+    double spatialPlane = 0;
+    AABB spatialLeft;
+    AABB spatialRight;
+    int spatialLeftCount = 0;
+    int spatialRightCount = 0;
+
+    bool trySpatial = budget > 0 && rootArea > 0;
+    if (trySpatial && objectAxis >= 0) {
+        AABB overlap = objectLeft.intersection(objectRight);
+        trySpatial = !overlap.isEmpty() && overlap.surfaceArea() > SBVH_MIN_OVERLAP * rootArea;
+    }
+
+    // Axe le plus long uniquement: le découpage des références domine le temps de construction
+    const int spatialCandidate = findSplitAxis(box);
+    const double spatialLo = axisValue(box.getMin(), spatialCandidate);
+    const double spatialExtent = axisValue(box.getMax(), spatialCandidate) - spatialLo;
+    if (trySpatial && spatialExtent > 0) {
+        const int axis = spatialCandidate;
+        const double lo = spatialLo;
+        const double extent = spatialExtent;
+        const double binSize = extent / SAH_BIN_COUNT;
+        const double scale = SAH_BIN_COUNT / extent;
+        auto binOf = [&](double value) {
+            return std::min(SAH_BIN_COUNT - 1, std::max(0, static_cast<int>((value - lo) * scale)));
+        };
+
+        SpatialBin bins[SAH_BIN_COUNT];
+        for (const BSPReference& ref : refs) {
+            const int first = binOf(axisValue(ref.box.getMin(), axis));
+            const int last = binOf(axisValue(ref.box.getMax(), axis));
+            bins[first].enter++;
+            bins[last].exit++;
+            if (first == last) {
+                bins[first].add(ref.box);
+                continue;
+            }
+            // Découpe de la référence en un morceau par casier traversé
+            AABB rest = ref.box;
+            for (int b = first; b < last && !rest.isEmpty(); ++b) {
+                AABB piece;
+                splitPrimitive(ref.prim, rest, axis, lo + (b + 1) * binSize, piece, rest);
+                bins[b].add(piece);
+            }
+            bins[last].add(rest);
+        }
+
+        SpatialAccumulator rightAcc[SAH_BIN_COUNT];
+        int rightCount[SAH_BIN_COUNT];
+        SpatialAccumulator acc;
+        int n = 0;
+        for (int b = SAH_BIN_COUNT - 1; b > 0; --b) {
+            acc.add(bins[b].box, bins[b].empty);
+            n += bins[b].exit;
+            rightAcc[b] = acc;
+            rightCount[b] = n;
+        }
+        acc = SpatialAccumulator();
+        n = 0;
+        for (int b = 0; b < SAH_BIN_COUNT - 1; ++b) {
+            acc.add(bins[b].box, bins[b].empty);
+            n += bins[b].enter;
+            const int nRight = rightCount[b + 1];
+            if (n == 0 || nRight == 0 || static_cast<size_t>(n + nRight - count) > budget) {
+                continue;
+            }
+            double cost = SAH_TRAVERSAL_COST +
+                (acc.area() * intersectionCost(n) + rightAcc[b + 1].area() * intersectionCost(nRight)) / parentArea;
+            if (cost < bestCost) {
+                bestCost = cost;
+                spatialAxis = axis;
+                spatialPlane = lo + (b + 1) * binSize;
+                spatialLeft = acc.box;
+                spatialRight = rightAcc[b + 1].box;
+                spatialLeftCount = n;
+                spatialRightCount = nRight;
+            }
+        }
+    }
+
+    // Étape 3: la feuille est-elle moins chère que la meilleure coupe ?
+    const double leafCost = intersectionCost(count);
+    if ((objectAxis < 0 && spatialAxis < 0) || bestCost >= leafCost) {
+        if (count <= SAH_MAX_LEAF_SIZE) {
+            return makeRefLeaf(refs);
+        }
+    }
+
+    std::vector<BSPReference> left;
+    std::vector<BSPReference> right;
+
+    // Étape 4: coupe spatiale
+    if (spatialAxis >= 0) {
+        const int axis = spatialAxis;
+        const double plane = spatialPlane;
+        for (const BSPReference& ref : refs) {
+            if (axisValue(ref.box.getMax(), axis) <= plane) {
+                left.push_back(ref);
+                continue;
+            }
+            if (axisValue(ref.box.getMin(), axis) >= plane) {
+                right.push_back(ref);
+                continue;
+            }
+
+            // Garder la référence entière d'un côté coûte-t-il moins que la dupliquer ?
+            AABB withLeft = spatialLeft;
+            withLeft.subsume(ref.box);
+            AABB withRight = spatialRight;
+            withRight.subsume(ref.box);
+            const double splitCost = spatialLeft.surfaceArea() * spatialLeftCount + spatialRight.surfaceArea() * spatialRightCount;
+            const double leftCost = withLeft.surfaceArea() * spatialLeftCount + spatialRight.surfaceArea() * (spatialRightCount - 1);
+            const double rightCost = spatialLeft.surfaceArea() * (spatialLeftCount - 1) + withRight.surfaceArea() * spatialRightCount;
+            if (leftCost < splitCost && leftCost <= rightCost) {
+                left.push_back(ref);
+                continue;
+            }
+            if (rightCost < splitCost) {
+                right.push_back(ref);
+                continue;
+            }
+
+            AABB leftPart;
+            AABB rightPart;
+            splitPrimitive(ref.prim, ref.box, axis, plane, leftPart, rightPart);
+            if (leftPart.isEmpty() && rightPart.isEmpty()) {
+                // Découpe dégénérée (arrondis): la référence reste entière, jamais perdue
+                left.push_back(ref);
+                continue;
+            }
+            if (!leftPart.isEmpty()) {
+                left.push_back({ref.prim, leftPart});
+            }
+            if (!rightPart.isEmpty()) {
+                right.push_back({ref.prim, rightPart});
+            }
+        }
+        if (left.empty() || right.empty() || left.size() + right.size() > count + budget) {
+            left.clear();
+            right.clear();
+        }
+    }
+
+    // Coupe objet (retenue, ou repli si la coupe spatiale n'a rien séparé)
+    if (left.empty() && objectAxis >= 0) {
+        const double lo = axisValue(cMin, objectAxis);
+        for (const BSPReference& ref : refs) {
+            double center = (axisValue(ref.box.getMin(), objectAxis) + axisValue(ref.box.getMax(), objectAxis)) * 0.5;
+            int b = std::min(SAH_BIN_COUNT - 1, static_cast<int>((center - lo) * objectScale));
+            (b <= objectSplit ? left : right).push_back(ref);
+        }
+    }
+    if (left.empty() || right.empty()) {
+        // Centres confondus: coupe médiane pour borner la taille des feuilles
+        left.clear();
+        right.clear();
+        const int axis = findSplitAxis(box);
+        const size_t mid = count / 2;
+        std::nth_element(refs.begin(), refs.begin() + mid, refs.end(), [axis](BSPReference const& a, BSPReference const& b) {
+            return axisValue(a.box.getMin(), axis) + axisValue(a.box.getMax(), axis) <
+                   axisValue(b.box.getMin(), axis) + axisValue(b.box.getMax(), axis);
+        });
+        left.assign(refs.begin(), refs.begin() + mid);
+        right.assign(refs.begin() + mid, refs.end());
+    }
+    refs.clear();
+    refs.shrink_to_fit();
+
+    // Étape 5: partage du budget restant
+    const size_t used = left.size() + right.size() - count;
+    const size_t remaining = budget - used;
+    const size_t leftBudget = static_cast<size_t>(static_cast<double>(remaining) * left.size() / (left.size() + right.size()));
+    const size_t rightBudget = remaining - leftBudget;
+
+    uint32_t leftIndex;
+    uint32_t rightIndex;
+    if (threads > 1 && count >= BSP_PARALLEL_SUBTREE_THRESHOLD) {
+        // Même schéma que buildChildren, avec en plus les indices des feuilles à décaler
+        std::vector<BSPNode> rightNodes;
+        std::vector<uint32_t> rightIndices;
+        unsigned int rightThreads = threads / 2;
+
+        std::thread worker([&]() {
+            buildSBVHRecursive(right, depth + 1, rightBudget, rootArea, rightNodes, rightIndices, rightThreads);
+        });
+        leftIndex = buildSBVHRecursive(left, depth + 1, leftBudget, rootArea, out, outIndices, threads - rightThreads);
+        worker.join();
+
+        rightIndex = static_cast<uint32_t>(out.size());
+        const uint32_t indexOffset = static_cast<uint32_t>(outIndices.size());
+        for (BSPNode node : rightNodes) {
+            if (node.isLeaf()) {
+                node.primOffset += indexOffset;
+            } else {
+                node.left += rightIndex;
+                node.right += rightIndex;
+            }
+            out.push_back(node);
+        }
+        outIndices.insert(outIndices.end(), rightIndices.begin(), rightIndices.end());
+    } else {
+        leftIndex = buildSBVHRecursive(left, depth + 1, leftBudget, rootArea, out, outIndices, threads);
+        rightIndex = buildSBVHRecursive(right, depth + 1, rightBudget, rootArea, out, outIndices, threads);
     }
+
+    out[nodeIndex].left = leftIndex;
+    out[nodeIndex].right = rightIndex;
+    return nodeIndex;
+}
+
+/**
+ * Répartit les bits de poids faible de v un bit sur trois
+ * (10 bits -> 30 bits pour les codes 32 bits, 21 bits -> 63 bits pour les codes 64 bits)
+ */
+static inline uint64_t expandBits3(uint64_t v) {
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffffull;
+    v = (v | v << 16) & 0x1f0000ff0000ffull;
+    v = (v | v << 8) & 0x100f00f00f00f00full;
+    v = (v | v << 4) & 0x10c30c30c30c30c3ull;
+    v = (v | v << 2) & 0x1249249249249249ull;
+    return v;
 }
 
-void BSPTree::destroyRecursive(BSPNode* node) {
-    if (!node) return;
-    
-    destroyRecursive(node->left);
-    destroyRecursive(node->right);
-    delete node;
+/**
+ * Code de Morton d'un point normalisé dans [0, 1]^3, sur 3 * bitsPerAxis bits
+ */
+static inline uint64_t mortonCode(double x, double y, double z, int bitsPerAxis) {
+    const double cells = static_cast<double>(1u << bitsPerAxis);
+    const double maxCell = cells - 1;
+    uint64_t ix = static_cast<uint64_t>(std::min(std::max(x * cells, 0.0), maxCell));
+    uint64_t iy = static_cast<uint64_t>(std::min(std::max(y * cells, 0.0), maxCell));
+    uint64_t iz = static_cast<uint64_t>(std::min(std::max(z * cells, 0.0), maxCell));
+    return (expandBits3(ix) << 2) | (expandBits3(iy) << 1) | expandBits3(iz);
 }
 
 /**
- * Construit l'arbre BSP à partir des objets de la scène
- * 
+ * Tri par base (radix sort, octet par octet) de primIndices[begin, end) selon codes
+ *
+ * Chaque passe est stable et parallèle: histogramme par tranche, préfixe
+ * global (chiffre, tranche), puis dispersion de chaque tranche à sa place.
+ * Les passes dont tous les codes partagent le même octet sont sautées.
+ */
+void BSPTree::sortByMortonCode(uint32_t begin, uint32_t end, std::vector<uint64_t>& codes, int bits, unsigned int threads) {
+    const uint32_t count = end - begin;
+    std::vector<uint64_t> codesTmp(count);
+    std::vector<uint32_t> indicesTmp(count);
+    uint64_t* srcCodes = codes.data() + begin;
+    uint64_t* dstCodes = codesTmp.data();
+    uint32_t* srcIndices = primIndices.data() + begin;
+    uint32_t* dstIndices = indicesTmp.data();
+
+    const unsigned int sortThreads = count >= LBVH_PARALLEL_SORT_THRESHOLD ? threads : 1;
+    std::vector<uint32_t> histograms(sortThreads * 256);
+
+    for (int shift = 0; shift < bits; shift += 8) {
+        std::fill(histograms.begin(), histograms.end(), 0);
+        unsigned int chunks = parallelFor(0, count, sortThreads, [&](size_t first, size_t last, unsigned int chunk) {
+            uint32_t* histogram = &histograms[chunk * 256];
+            for (size_t i = first; i < last; ++i) {
+                histogram[(srcCodes[i] >> shift) & 0xff]++;
+            }
+        });
+
+        // Octet identique pour tous les codes: la passe ne changerait rien
+        bool skip = false;
+        for (int digit = 0; digit < 256 && !skip; ++digit) {
+            uint32_t total = 0;
+            for (unsigned int chunk = 0; chunk < chunks; ++chunk) {
+                total += histograms[chunk * 256 + digit];
+            }
+            skip = total == count;
+        }
+        if (skip) {
+            continue;
+        }
+
+        // Préfixe: position de départ de chaque (chiffre, tranche)
+        uint32_t offset = 0;
+        for (int digit = 0; digit < 256; ++digit) {
+            for (unsigned int chunk = 0; chunk < chunks; ++chunk) {
+                uint32_t n = histograms[chunk * 256 + digit];
+                histograms[chunk * 256 + digit] = offset;
+                offset += n;
+            }
+        }
+
+        parallelFor(0, count, sortThreads, [&](size_t first, size_t last, unsigned int chunk) {
+            uint32_t* position = &histograms[chunk * 256];
+            for (size_t i = first; i < last; ++i) {
+                uint32_t dst = position[(srcCodes[i] >> shift) & 0xff]++;
+                dstCodes[dst] = srcCodes[i];
+                dstIndices[dst] = srcIndices[i];
+            }
+        });
+        std::swap(srcCodes, dstCodes);
+        std::swap(srcIndices, dstIndices);
+    }
+
+    // Résultat dans les tampons temporaires après un nombre impair de passes
+    if (srcCodes != codes.data() + begin) {
+        std::copy(srcCodes, srcCodes + count, codes.data() + begin);
+        std::copy(srcIndices, srcIndices + count, primIndices.data() + begin);
+    }
+}
+
+/**
+ * Construction LBVH (Linear BVH) sur primIndices[begin, end)
+ *
  * ALGORITHME:
- * 1. Calculer l'AABB englobant tous les objets
- * 2. Si peu d'objets ou profondeur max: créer une feuille
- * 3. Sinon: diviser l'espace en deux selon l'axe le plus long
- * 4. Récurser sur chaque moitié
+ * 1. Quantifier le centre de chaque AABB sur une grille 2^k par axe, k = 10
+ *    (codes de 30 bits) ou k = 21 (63 bits) pour les très grands ensembles
+ * 2. Entrelacer les bits des trois coordonnées (code de Morton): deux objets
+ *    proches dans l'espace ont des codes proches
+ * 3. Trier les objets par code (tri par base parallèle, linéaire)
+ * 4. Émettre la hiérarchie en une passe: chaque nœud coupe sa plage là où
+ *    le bit de poids fort courant change (voir buildLBVHRecursive)
+ *
+ * Aucun coût SAH n'est évalué: l'arbre est moins bon que BUILD_SAH
+ * mais se construit en une fraction du temps.
  */
-void BSPTree::build(std::vector<SceneObject*>& objects, int maxDepth, int minObjects) {
-    if (objects.empty()) {
-        root = nullptr;
-        return;
+uint32_t BSPTree::buildLBVH(uint32_t begin, uint32_t end, std::vector<BSPNode>& out, unsigned int threads) {
+    const uint32_t count = end - begin;
+
+    // Étape 1: bornes des centres
+    Vector3 cMin = centroids[primIndices[begin]];
+    AABB centroidBox(cMin, cMin);
+    for (uint32_t i = begin + 1; i < end; ++i) {
+        const Vector3& c = centroids[primIndices[i]];
+        centroidBox.subsume(AABB(c, c));
     }
-    
-    root = buildRecursive(objects, 0, maxDepth, minObjects);
+    cMin = centroidBox.getMin();
+    Vector3 extent = centroidBox.getMax() - cMin;
+    const double invX = extent.x > 0 ? 1.0 / extent.x : 0;
+    const double invY = extent.y > 0 ? 1.0 / extent.y : 0;
+    const double invZ = extent.z > 0 ? 1.0 / extent.z : 0;
+
+    // Étape 2: codes de Morton
+    const int bitsPerAxis = count > LBVH_WIDE_CODE_THRESHOLD ? 21 : 10;
+    const int bits = 3 * bitsPerAxis;
+    std::vector<uint64_t> codes(end);
+    parallelFor(begin, end, threads, [&](size_t chunkBegin, size_t chunkEnd, unsigned int) {
+        for (size_t i = chunkBegin; i < chunkEnd; ++i) {
+            const Vector3& c = centroids[primIndices[i]];
+            codes[i] = mortonCode((c.x - cMin.x) * invX, (c.y - cMin.y) * invY, (c.z - cMin.z) * invZ, bitsPerAxis);
+        }
+    });
+
+    // Étape 3: tri
+    sortByMortonCode(begin, end, codes, bits, threads);
+
+    // Étape 4: hiérarchie
+    return buildLBVHRecursive(begin, end, bits - 1, 0, codes.data(), out, threads);
 }
 
-BSPNode* BSPTree::buildRecursive(std::vector<SceneObject*>& objects, int depth, int maxDepth, int minObjects) {
-    if (objects.empty()) {
-        return nullptr;
+/**
+ * Émet le nœud couvrant primIndices[begin, end), triés par code de Morton
+ *
+ * Le premier et le dernier code partagent tous les bits au-dessus de la
+ * coupe: on cherche le bit de poids fort où ils diffèrent, puis (recherche
+ * dichotomique) le premier code où ce bit vaut 1. Les bornes d'un nœud
+ * interne sont l'union de celles de ses enfants, calculées au retour.
+ * @param codes codes triés, indexés comme primIndices
+ */
+uint32_t BSPTree::buildLBVHRecursive(uint32_t begin, uint32_t end, int bit, int depth, const uint64_t* codes,
+                                     std::vector<BSPNode>& out, unsigned int threads) {
+    const uint32_t count = end - begin;
+
+    if (count <= LBVH_MAX_LEAF_SIZE || depth >= BSP_MAX_DEPTH - 1) {
+        uint32_t nodeIndex = allocateNode(computeBoundingBox(begin, end), out);
+        makeLeaf(out[nodeIndex], begin, end);
+        return nodeIndex;
     }
-    
-    BSPNode* node = new BSPNode();
-    node->boundingBox = computeBoundingBox(objects);
-    
-    // Condition d'arrêt: peu d'objets ou profondeur max atteinte
-    if (objects.size() <= static_cast<size_t>(minObjects) || depth >= maxDepth) {
-        node->isLeaf = true;
-        node->objects = objects;
-        return node;
+
+    // Bit de poids fort qui distingue le premier et le dernier code
+    const uint64_t diff = codes[begin] ^ codes[end - 1];
+    while (bit >= 0 && ((diff >> bit) & 1) == 0) {
+        --bit;
     }
-    
-    // Trouver l'axe de division (le plus long)
-    int axis = findSplitAxis(node->boundingBox);
-    
-    // Trier les objets selon le centre de leur bounding box sur cet axe
-    std::sort(objects.begin(), objects.end(), [axis](SceneObject* a, SceneObject* b) {
-        // Calculer le centre de la bounding box
-        Vector3 centerA = (a->boundingBox.getMin() + a->boundingBox.getMax()) * 0.5;
-        Vector3 centerB = (b->boundingBox.getMin() + b->boundingBox.getMax()) * 0.5;
-        
-        if (axis == 0) return centerA.x < centerB.x;
-        if (axis == 1) return centerA.y < centerB.y;
-        return centerA.z < centerB.z;
-    });
-    
-    // Diviser au milieu
-    size_t mid = objects.size() / 2;
-    
-    std::vector<SceneObject*> leftObjects(objects.begin(), objects.begin() + mid);
-    std::vector<SceneObject*> rightObjects(objects.begin() + mid, objects.end());
-    
-    // Récursion
-    node->left = buildRecursive(leftObjects, depth + 1, maxDepth, minObjects);
-    node->right = buildRecursive(rightObjects, depth + 1, maxDepth, minObjects);
-    
-    return node;
+
+    uint32_t mid;
+    if (bit < 0) {
+        // Codes identiques: coupe médiane pour borner la taille des feuilles
+        if (count <= SAH_MAX_LEAF_SIZE) {
+            uint32_t nodeIndex = allocateNode(computeBoundingBox(begin, end), out);
+            makeLeaf(out[nodeIndex], begin, end);
+            return nodeIndex;
+        }
+        mid = begin + count / 2;
+    } else {
+        const uint64_t mask = uint64_t(1) << bit;
+        mid = static_cast<uint32_t>(std::partition_point(codes + begin, codes + end, [mask](uint64_t code) {
+            return (code & mask) == 0;
+        }) - codes);
+    }
+
+    out.push_back(BSPNode());
+    uint32_t nodeIndex = static_cast<uint32_t>(out.size() - 1);
+    buildChildren(nodeIndex, begin, mid, end, out, threads,
+        [&](uint32_t childBegin, uint32_t childEnd, std::vector<BSPNode>& childOut, unsigned int childThreads) {
+            return buildLBVHRecursive(childBegin, childEnd, bit - 1, depth + 1, codes, childOut, childThreads);
+        });
+
+    // Bornes: union des enfants
+    BSPNode& node = out[nodeIndex];
+    mergeChildBounds(node, out[node.left], out[node.right]);
+    return nodeIndex;
 }
 
-AABB BSPTree::computeBoundingBox(std::vector<SceneObject*>& objects) {
-    if (objects.empty()) {
+AABB BSPTree::computeBoundingBox(uint32_t begin, uint32_t end) {
+    if (begin >= end) {
         return AABB();
     }
-    
+
     // Commencer avec la bounding box du premier objet
-    AABB result = objects[0]->boundingBox;
-    
+    AABB result = primitiveBounds(primIndices[begin]);
+
     // Englober tous les autres objets
-    for (size_t i = 1; i < objects.size(); ++i) {
-        result.subsume(objects[i]->boundingBox);
+    for (uint32_t i = begin + 1; i < end; ++i) {
+        result.subsume(primitiveBounds(primIndices[i]));
     }
-    
+
     return result;
 }
 
@@ -113,11 +1745,11 @@ int BSPTree::findSplitAxis(AABB& box) {
     // Trouver l'axe avec la plus grande étendue
     Vector3 min = box.getMin();
     Vector3 max = box.getMax();
-    
+
     double extentX = max.x - min.x;
     double extentY = max.y - min.y;
     double extentZ = max.z - min.z;
-    
+
     // Retourner l'axe le plus long
     if (extentX >= extentY && extentX >= extentZ) return 0;  // X
     if (extentY >= extentX && extentY >= extentZ) return 1;  // Y
@@ -126,41 +1758,377 @@ int BSPTree::findSplitAxis(AABB& box) {
 
 /**
  * Trouve les objets potentiellement intersectés par un rayon
- * 
- * ALGORITHME:
- * 1. Si le rayon n'intersecte pas l'AABB du nœud: retourner
+ *
+ * ALGORITHME (itératif, pile de taille fixe sur la pile du thread):
+ * 1. Si le rayon n'intersecte pas l'AABB du nœud: dépiler le suivant
  * 2. Si c'est une feuille: ajouter tous ses objets aux candidats
- * 3. Sinon: récurser sur les enfants dont l'AABB est intersecté
+ * 3. Sinon: empiler l'enfant droit et descendre dans l'enfant gauche
  */
 bool BSPTree::intersects(Ray& ray, std::vector<SceneObject*>& candidates) {
     candidates.clear();
-    
-    if (!root) {
-        return false;
+    if (primitives) {
+        return false;  // Pas de SceneObject à proposer
     }
-    
-    traverseRecursive(root, ray, candidates);
+
+    // Les objets non bornés sont toujours candidats
+    for (uint32_t index : unboundedIndices) {
+        candidates.push_back(objects[index]);
+    }
+
+    if (nodes.empty()) {
+        return !candidates.empty();
+    }
+
+    const Vector3 o = ray.GetPosition();
+    const Vector3 dInv = ray.GetDirection().inverse();
+
+    uint32_t stack[BSP_MAX_DEPTH];
+    int stackSize = 0;
+    uint32_t current = 0;
+    double tEntry;
+
+    while (true) {
+        const BSPNode& node = nodes[current];
+
+        // Le rayon n'intersecte pas cette partie de l'espace: toute la branche est ignorée
+        if (intersectsNode(node, o, dInv, tEntry)) {
+            if (!node.isLeaf()) {
+                stack[stackSize++] = node.right;
+                current = node.left;
+                continue;
+            }
+
+            // Feuille: ajouter tous les objets comme candidats
+            const uint32_t end = node.primOffset + node.count();
+            for (uint32_t i = node.primOffset; i < end; ++i) {
+                candidates.push_back(objects[primIndices[i]]);
+            }
+        }
+
+        if (stackSize == 0) {
+            break;
+        }
+        current = stack[--stackSize];
+    }
+
     return !candidates.empty();
 }
 
-void BSPTree::traverseRecursive(BSPNode* node, Ray& ray, std::vector<SceneObject*>& candidates) {
-    if (!node) return;
-    
-    // Test d'intersection avec l'AABB du nœud
-    if (!node->boundingBox.intersects(ray)) {
-        // Le rayon n'intersecte pas cette partie de l'espace
-        // On peut ignorer toute cette branche! (OPTIMISATION CLÉ)
+/**
+ * Recherche de l'intersection la plus proche
+ *
+ * ALGORITHME:
+ * 1. Feuille: tester ses objets, conserver l'impact le plus proche
+ * 2. Nœud interne: tester les deux enfants, descendre dans le plus proche et
+ *    empiler l'autre avec sa distance d'entrée
+ * 3. Au dépilement, ignorer les nœuds entrés au-delà du meilleur impact
+ *    (ils ne peuvent plus rien apporter)
+ */
+void BSPTree::intersectPrimitives(const uint32_t* indices, uint32_t count, Ray& ray, CullingType culling,
+                                  Intersection& closestInter, double& closestDistanceSquared) {
+    if (primitives) {
+        primitives->intersect(indices, count, ray, culling, closestInter, closestDistanceSquared);
         return;
     }
-    
-    if (node->isLeaf) {
-        // Feuille: ajouter tous les objets comme candidats
-        for (SceneObject* obj : node->objects) {
-            candidates.push_back(obj);
+    Intersection intersection;
+    const Vector3 o = ray.GetPosition();
+    for (uint32_t i = 0; i < count; ++i) {
+        SceneObject* obj = objects[indices[i]];
+        if (!obj->boundingBox.intersects(ray)) {
+            continue;
+        }
+        if (obj->intersects(ray, intersection, culling)) {
+            intersection.Distance = (intersection.Position - o).lengthSquared();
+            if (closestDistanceSquared < 0 || intersection.Distance < closestDistanceSquared) {
+                closestDistanceSquared = intersection.Distance;
+                closestInter = intersection;
+            }
+        }
+    }
+}
+
+bool BSPTree::occludedPrimitives(const uint32_t* indices, uint32_t count, Ray& ray, double maxDistance) {
+    if (primitives) {
+        return primitives->occluded(indices, count, ray, maxDistance);
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        SceneObject* obj = objects[indices[i]];
+        if (!obj->boundingBox.intersects(ray)) {
+            continue;
+        }
+        if (obj->occluded(ray, maxDistance)) {
+            return true;
         }
+    }
+    return false;
+}
+
+bool BSPTree::closestIntersection(Ray& ray, Intersection& closest, CullingType culling) {
+    Intersection closestInter;
+    double closestDistanceSquared = -1;
+
+    // Objets non bornés d'abord (test analytique): leur impact élague le parcours de l'arbre
+    intersectPrimitives(unboundedIndices.data(), static_cast<uint32_t>(unboundedIndices.size()), ray, culling,
+                        closestInter, closestDistanceSquared);
+
+    // Après insert/remove, l'arbre large attend le prochain refit: parcours binaire
+    if (width == 4 && !wideStale) {
+        if (quantizationBits == 8) closestIntersectionWide<4>(quantizedNodes4x8, ray, culling, closestInter, closestDistanceSquared);
+        else if (quantizationBits == 16) closestIntersectionWide<4>(quantizedNodes4x16, ray, culling, closestInter, closestDistanceSquared);
+        else closestIntersectionWide<4>(wideNodes4, ray, culling, closestInter, closestDistanceSquared);
+    } else if (width == 8 && !wideStale) {
+        if (quantizationBits == 8) closestIntersectionWide<8>(quantizedNodes8x8, ray, culling, closestInter, closestDistanceSquared);
+        else if (quantizationBits == 16) closestIntersectionWide<8>(quantizedNodes8x16, ray, culling, closestInter, closestDistanceSquared);
+        else closestIntersectionWide<8>(wideNodes8, ray, culling, closestInter, closestDistanceSquared);
     } else {
-        // Nœud intermédiaire: récurser sur les deux enfants
-        traverseRecursive(node->left, ray, candidates);
-        traverseRecursive(node->right, ray, candidates);
+        closestIntersectionBinary(ray, culling, closestInter, closestDistanceSquared);
+    }
+
+    closest = closestInter;
+    return closestDistanceSquared > -1;
+}
+
+void BSPTree::closestIntersectionBinary(Ray& ray, CullingType culling, Intersection& closestInter,
+                                        double& closestDistanceSquared) {
+    const Vector3 o = ray.GetPosition();
+    const Vector3 dInv = ray.GetDirection().inverse();
+
+    struct StackEntry {
+        uint32_t node;
+        double tEntry;
+    };
+    StackEntry stack[BSP_MAX_DEPTH];
+    int stackSize = 0;
+    uint32_t current = 0;
+    double tEntry;
+
+    bool visit = !nodes.empty() && intersectsNode(nodes[0], o, dInv, tEntry);
+
+    while (visit) {
+        const BSPNode& node = nodes[current];
+
+        if (node.isLeaf()) {
+            intersectPrimitives(&primIndices[node.primOffset], node.count(), ray, culling, closestInter, closestDistanceSquared);
+        } else {
+            double tLeft, tRight;
+            bool hitLeft = intersectsNode(nodes[node.left], o, dInv, tLeft) &&
+                           mayBeCloser(tLeft, closestDistanceSquared);
+            bool hitRight = intersectsNode(nodes[node.right], o, dInv, tRight) &&
+                            mayBeCloser(tRight, closestDistanceSquared);
+
+            if (hitLeft && hitRight) {
+                // Proche d'abord, le lointain attend sur la pile
+                if (tLeft <= tRight) {
+                    stack[stackSize++] = {node.right, tRight};
+                    current = node.left;
+                } else {
+                    stack[stackSize++] = {node.left, tLeft};
+                    current = node.right;
+                }
+                continue;
+            }
+            if (hitLeft || hitRight) {
+                current = hitLeft ? node.left : node.right;
+                continue;
+            }
+        }
+
+        // Dépiler le prochain nœud encore susceptible d'améliorer l'impact
+        visit = false;
+        while (stackSize > 0) {
+            StackEntry entry = stack[--stackSize];
+            if (mayBeCloser(entry.tEntry, closestDistanceSquared)) {
+                current = entry.node;
+                visit = true;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * Requête d'ombre (any-hit)
+ *
+ * Pas besoin du plus proche: l'ordre de visite importe peu, on sort dès
+ * qu'un objet bloque le rayon. Les nœuds entrés au-delà de la lumière sont ignorés.
+ */
+bool BSPTree::occluded(Ray& ray, double maxDistance) {
+    if (occludedPrimitives(unboundedIndices.data(), static_cast<uint32_t>(unboundedIndices.size()), ray, maxDistance)) {
+        return true;
+    }
+
+    if (width == 4 && !wideStale) {
+        if (quantizationBits == 8) return occludedWide<4>(quantizedNodes4x8, ray, maxDistance);
+        if (quantizationBits == 16) return occludedWide<4>(quantizedNodes4x16, ray, maxDistance);
+        return occludedWide<4>(wideNodes4, ray, maxDistance);
+    }
+    if (width == 8 && !wideStale) {
+        if (quantizationBits == 8) return occludedWide<8>(quantizedNodes8x8, ray, maxDistance);
+        if (quantizationBits == 16) return occludedWide<8>(quantizedNodes8x16, ray, maxDistance);
+        return occludedWide<8>(wideNodes8, ray, maxDistance);
+    }
+    return occludedBinary(ray, maxDistance);
+}
+
+bool BSPTree::occludedBinary(Ray& ray, double maxDistance) {
+    if (nodes.empty()) {
+        return false;
+    }
+
+    const Vector3 o = ray.GetPosition();
+    const Vector3 dInv = ray.GetDirection().inverse();
+
+    uint32_t stack[BSP_MAX_DEPTH];
+    int stackSize = 0;
+    uint32_t current = 0;
+    double tEntry;
+
+    while (true) {
+        const BSPNode& node = nodes[current];
+
+        if (intersectsNode(node, o, dInv, tEntry) && tEntry < maxDistance) {
+            if (!node.isLeaf()) {
+                stack[stackSize++] = node.right;
+                current = node.left;
+                continue;
+            }
+
+            if (occludedPrimitives(&primIndices[node.primOffset], node.count(), ray, maxDistance)) {
+                return true;
+            }
+        }
+
+        if (stackSize == 0) {
+            return false;
+        }
+        current = stack[--stackSize];
+    }
+}
+
+/**
+ * Accès à un nœud large: direct pour les nœuds float, décodé dans decoded pour
+ * les nœuds compressés
+ */
+template <int N>
+static inline const BSPWideNode<N>& loadWideNode(const BSPWideNode<N>& node, BSPWideNode<N>&) {
+    return node;
+}
+
+template <int N, typename Q>
+static inline const BSPWideNode<N>& loadWideNode(const BSPQuantizedNode<N, Q>& node, BSPWideNode<N>& decoded) {
+    node.decode(decoded);
+    return decoded;
+}
+
+/**
+ * Parcours closest-hit d'un BVH large
+ *
+ * Même algorithme que la version binaire, un niveau couvrant N enfants:
+ * 1. Un seul test vectoriel donne le masque et la distance d'entrée des N enfants
+ * 2. Les enfants touchés (et encore susceptibles d'améliorer l'impact) sont
+ *    triés par distance d'entrée: le plus proche est visité tout de suite,
+ *    les autres empilés du plus lointain au plus proche
+ */
+template <int N, typename NodeT>
+void BSPTree::closestIntersectionWide(const std::vector<NodeT>& wideNodes, Ray& ray, CullingType culling,
+                                      Intersection& closestInter, double& closestDistanceSquared) {
+    const Vector3 o = ray.GetPosition();
+    const WideRay wideRay(o, ray.GetDirection().inverse());
+
+    struct StackEntry {
+        uint32_t child;
+        uint32_t primCount;
+        float tEntry;
+    };
+    StackEntry stack[BSP_MAX_DEPTH * (N - 1) + 1];
+    int stackSize = 0;
+    StackEntry current = {0, 0, 0.0f};  // Racine: nœud large 0
+    float tEntry[N];
+    BSPWideNode<N> decoded;
+
+    bool visit = !wideNodes.empty();
+
+    while (visit) {
+        if (current.primCount & WIDE_LEAF_FLAG) {
+            intersectPrimitives(&primIndices[current.child], current.primCount & ~WIDE_LEAF_FLAG, ray, culling,
+                                closestInter, closestDistanceSquared);
+        } else {
+            const BSPWideNode<N>& node = loadWideNode(wideNodes[current.child], decoded);
+            const int mask = intersectWide(node, wideRay, tEntry);
+
+            // Tri par insertion des enfants touchés (au plus N)
+            StackEntry hits[N];
+            int hitCount = 0;
+            for (int i = 0; i < N; ++i) {
+                if (!((mask >> i) & 1) || !mayBeCloser(tEntry[i], closestDistanceSquared)) {
+                    continue;
+                }
+                int j = hitCount++;
+                while (j > 0 && hits[j - 1].tEntry > tEntry[i]) {
+                    hits[j] = hits[j - 1];
+                    --j;
+                }
+                hits[j] = {node.child[i], node.primCount[i], tEntry[i]};
+            }
+
+            if (hitCount > 0) {
+                for (int j = hitCount - 1; j > 0; --j) {
+                    stack[stackSize++] = hits[j];
+                }
+                current = hits[0];
+                continue;
+            }
+        }
+
+        // Dépiler le prochain enfant encore susceptible d'améliorer l'impact
+        visit = false;
+        while (stackSize > 0) {
+            StackEntry entry = stack[--stackSize];
+            if (mayBeCloser(entry.tEntry, closestDistanceSquared)) {
+                current = entry;
+                visit = true;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * Requête d'ombre sur un BVH large: tous les enfants touchés avant la lumière
+ * sont empilés, sans tri
+ */
+template <int N, typename NodeT>
+bool BSPTree::occludedWide(const std::vector<NodeT>& wideNodes, Ray& ray, double maxDistance) {
+    if (wideNodes.empty()) {
+        return false;
+    }
+
+    const WideRay wideRay(ray.GetPosition(), ray.GetDirection().inverse());
+
+    uint32_t stack[BSP_MAX_DEPTH * (N - 1) + 1];
+    int stackSize = 0;
+    uint32_t current = 0;
+    float tEntry[N];
+    BSPWideNode<N> decoded;
+
+    while (true) {
+        const BSPWideNode<N>& node = loadWideNode(wideNodes[current], decoded);
+        const int mask = intersectWide(node, wideRay, tEntry);
+
+        for (int i = 0; i < N; ++i) {
+            if (!((mask >> i) & 1) || tEntry[i] >= maxDistance) {
+                continue;
+            }
+            if (!node.isLeaf(i)) {
+                stack[stackSize++] = node.child[i];
+            } else if (occludedPrimitives(&primIndices[node.child[i]], node.count(i), ray, maxDistance)) {
+                return true;
+            }
+        }
+
+        if (stackSize == 0) {
+            return false;
+        }
+        current = stack[--stackSize];
     }
 }
@@ -1,48 +1,227 @@
 #pragma once
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
 #include <vector>
 #include "../raymath/AABB.hpp"
 #include "../raymath/Ray.hpp"
 #include "SceneObject.hpp"
+#include "Accelerator.hpp"
+#include "WideBVH.hpp"
 
 /**
  * BSP Tree (Binary Space Partition Tree)
- * 
+ *
  * Optimisation de la complexité de recherche d'intersection rayon-objet.
  * Au lieu de tester tous les objets (O(n)), on divise l'espace récursivement
  * pour atteindre une complexité O(log n).
- * 
+ *
  * Principe:
  * - L'espace est divisé en deux récursivement
  * - Chaque nœud intermédiaire contient un AABB englobant ses enfants
  * - Seuls les nœuds feuilles contiennent des objets
  * - Lors du lancer de rayon, on ignore les branches dont l'AABB n'est pas intersecté
+ *
+ * Représentation mémoire:
+ * - Tous les nœuds vivent dans un seul tableau, en ordre profondeur d'abord
+ *   (l'enfant gauche suit immédiatement son parent)
+ * - Les feuilles désignent une plage du tableau d'indices de primitives
+ * - Aucun nœud n'est alloué individuellement sur le tas
+ * - Les objets non bornés (plans) ne sont pas dans l'arbre: ils sont testés
+ *   à part, avant le parcours
  */
 
-class BSPNode {
-public:
-    AABB boundingBox;           // AABB englobant tout ce nœud
-    BSPNode* left = nullptr;    // Enfant gauche
-    BSPNode* right = nullptr;   // Enfant droit
-    std::vector<SceneObject*> objects;  // Objets (seulement pour les feuilles)
-    bool isLeaf = false;
-    
-    BSPNode();
-    ~BSPNode();
+// Bit de poids fort de primCount: marque les feuilles
+static const uint32_t BSP_LEAF_FLAG = 0x80000000u;
+
+// Profondeur maximale de l'arbre = taille de la pile de parcours
+static const int BSP_MAX_DEPTH = 64;
+
+// Index de nœud absent (parent de la racine, primitive hors de l'arbre)
+static const uint32_t BSP_NO_NODE = 0xFFFFFFFFu;
+
+// Primitive référencée par plusieurs feuilles (SBVH): pas de retrait incrémental
+static const uint32_t BSP_MULTI_LEAF = 0xFFFFFFFEu;
+
+/**
+ * Nœud compact de 32 octets (une demi-ligne de cache)
+ * Les bornes sont stockées en float, arrondies vers l'extérieur pour rester conservatives.
+ */
+struct alignas(32) BSPNode {
+    float min[3];
+    float max[3];
+    union {
+        uint32_t left;        // Nœud interne: index de l'enfant gauche
+        uint32_t primOffset;  // Feuille: premier indice dans primIndices
+    };
+    union {
+        uint32_t right;       // Nœud interne: index de l'enfant droit
+        uint32_t primCount;   // Feuille: nombre de primitives | BSP_LEAF_FLAG
+    };
+
+    bool isLeaf() const { return (primCount & BSP_LEAF_FLAG) != 0; }
+    uint32_t count() const { return primCount & ~BSP_LEAF_FLAG; }
+};
+
+static_assert(sizeof(BSPNode) == 32, "BSPNode doit tenir sur 32 octets");
+
+/**
+ * Occupation mémoire d'un arbre
+ */
+struct BSPMemoryStats {
+    size_t primitiveCount = 0;
+    size_t binaryNodeCount = 0;     // Nœuds binaires (conservés pour refit sauf en format compressé)
+    size_t binaryNodeBytes = 0;
+    size_t traversalNodeCount = 0;  // Nœuds parcourus par les rayons (binaires, larges ou compressés)
+    size_t traversalNodeSize = 0;   // Octets par nœud parcouru
+    size_t traversalNodeBytes = 0;  // 0 si l'arbre parcouru est l'arbre binaire
+    size_t primIndexBytes = 0;
+
+    size_t totalBytes() const { return binaryNodeBytes + traversalNodeBytes + primIndexBytes; }
+};
+
+// Taille de feuille à partir de laquelle l'histogramme regroupe les feuilles (dernier casier)
+static const int BSP_STATS_MAX_LEAF_SIZE = 16;
+
+// Références supplémentaires autorisées au constructeur SBVH (30% des primitives)
+static const double SBVH_DUPLICATION_BUDGET = 0.3;
+
+// Au-delà de ce rapport entre le coût SAH après refit et celui de la construction, on reconstruit
+static const double BSP_REFIT_MAX_DEGRADATION = 1.5;
+
+/**
+ * Qualité d'un arbre (voir BSPTree::computeStats)
+ * Tout vient de l'arbre binaire, sauf memory: en format compressé, les nœuds
+ * binaires sont libérés et hasBinaryTree est faux.
+ */
+struct BSPTreeStats {
+    bool hasBinaryTree = false;
+    size_t nodeCount = 0;               // Nœuds binaires (internes et feuilles)
+    size_t leafCount = 0;
+    size_t referenceCount = 0;          // Primitives référencées par les feuilles (plus que primitiveCount en SBVH)
+    size_t unboundedCount = 0;          // Objets non bornés, hors de l'arbre
+    int maxDepth = 0;                   // Profondeur de la feuille la plus profonde (racine: 0)
+    double averageLeafDepth = 0;
+    std::vector<size_t> leafSizes;      // leafSizes[k]: feuilles de k primitives, le dernier casier cumule BSP_STATS_MAX_LEAF_SIZE et plus
+    double sahCost = 0;                 // Voir computeSAHCost
+    double averageSiblingOverlap = 0;   // Surface de l'intersection des deux enfants / surface du parent, moyenne des nœuds internes
+    double maxSiblingOverlap = 0;
+    BSPMemoryStats memory;
+};
+
+/**
+ * Référence à une primitive pendant la construction SBVH: une primitive
+ * coupée par un plan de découpe spatiale donne une référence par côté,
+ * chacune avec la boîte de sa partie
+ */
+struct BSPReference {
+    uint32_t prim;
+    AABB box;
 };
 
-class BSPTree {
+class BSPTree : public Accelerator {
 public:
     BSPTree();
     ~BSPTree();
-    
+
+    AcceleratorType getType() const override { return ACCELERATOR_BVH; }
+
+    /**
+     * Constructeur (utilisé par build(objects)) et format de l'arbre parcouru
+     * @return false si l'arbre existant a été construit autrement: il faut le reconstruire
+     */
+    bool configure(const AcceleratorSettings& settings) override;
+
+    /**
+     * Construit l'arbre avec le constructeur fixé par configure() (SAH par défaut)
+     */
+    void build(std::vector<SceneObject*>& objects) override;
+
     /**
      * Construit l'arbre BSP à partir d'une liste d'objets
      * @param objects Liste des objets de la scène
-     * @param maxDepth Profondeur maximale de l'arbre
-     * @param minObjects Nombre minimum d'objets par feuille
+     * @param strategy Découpage médian, SAH, LBVH ou SBVH
+     * @param maxDepth Profondeur maximale de l'arbre (BUILD_MEDIAN uniquement)
+     * @param minObjects Nombre minimum d'objets par feuille (BUILD_MEDIAN uniquement)
      */
-    void build(std::vector<SceneObject*>& objects, int maxDepth = 10, int minObjects = 2);
-    
+    void build(std::vector<SceneObject*>& objects, BSPBuildStrategy strategy,
+               int maxDepth = 10, int minObjects = 2);
+
+    /**
+     * Construit l'arbre sur des primitives compactes (triangles d'un mesh), avec le
+     * constructeur fixé par configure(). Les feuilles passent leurs indices à
+     * primitives en un appel; insert, remove et intersects(candidates) ne s'y appliquent pas.
+     */
+    void build(const PrimitiveSet& primitives) override;
+
+    /**
+     * Met à jour les bornes après déplacement des objets, sans reconstruire
+     * Les boundingBox des objets doivent avoir été recalculées. Les objets restent
+     * ceux passés à build().
+     * Après BUILD_SBVH, les feuilles reprennent les boîtes entières des primitives
+     * découpées: plus larges qu'à la construction, mais toujours correctes.
+     * @return false si la qualité de l'arbre s'est trop dégradée: il faut appeler build()
+     */
+    bool refit() override;
+
+    /**
+     * Insertion incrémentale (scènes dynamiques): O(log n), sans reconstruction
+     * - Descente vers le frère qui augmente le moins la surface des ancêtres
+     *   (heuristique de branchement de Bittner / Box2D)
+     * - Nouvelle feuille d'une primitive et nouveau parent à côté de ce frère
+     * - Remontée: bornes recalculées et rotations locales qui réduisent la
+     *   surface des enfants, sans jamais augmenter la hauteur
+     * Les arbres larges sont périmés jusqu'au prochain refit(): les rayons
+     * parcourent l'arbre binaire entre-temps. refit() reconstruit si le coût
+     * SAH s'est trop dégradé par rapport à la construction.
+     * @return false en format compressé (nœuds binaires libérés) ou si l'arbre
+     *         deviendrait trop profond pour la pile de parcours
+     */
+    bool insert(SceneObject* object) override;
+
+    /**
+     * Retrait incrémental: la primitive quitte sa feuille; une feuille vide est
+     * retirée avec son parent (le frère prend sa place), les nœuds libérés sont
+     * comblés par les derniers du tableau
+     * @return false si l'objet est inconnu, dupliqué par des coupes SBVH, ou en format compressé
+     */
+    bool remove(SceneObject* object) override;
+
+    /**
+     * Coût SAH de l'arbre (coût attendu d'un rayon, relatif à la boîte englobante)
+     */
+    double computeSAHCost() const;
+
+    /**
+     * Format de l'arbre parcouru
+     * L'arbre binaire reste la référence (construction, refit); les arbres larges
+     * en sont déduits en O(n) après chaque build() et refit().
+     * @param width 2 (binaire), 4 (BVH4) ou 8 (BVH8)
+     * @param quantizationBits 0 (bornes float), 8 ou 16 (bornes compressées, arbres larges uniquement)
+     *
+     * En format compressé, les nœuds binaires sont libérés pour que l'arbre occupe
+     * réellement moins de mémoire: refit() n'est plus possible (il renvoie false)
+     * et changer de format reconstruit l'arbre.
+     */
+    void setLayout(int width, int quantizationBits);
+    int getWidth() const { return width; }
+    int getQuantizationBits() const { return quantizationBits; }
+
+    /**
+     * Occupation mémoire de l'arbre (voir BSPMemoryStats)
+     */
+    BSPMemoryStats getMemoryStats() const;
+
+    /**
+     * Statistiques de qualité de l'arbre (voir BSPTreeStats), en O(n)
+     */
+    BSPTreeStats computeStats() const;
+
+    /**
+     * Stratégie utilisée par le dernier build()
+     */
+    BSPBuildStrategy getBuildStrategy() const { return builtStrategy; }
+
     /**
      * Trouve les objets potentiellement intersectés par un rayon
      * @param ray Le rayon à tester
@@ -50,32 +229,252 @@ public:
      * @return true si des candidats ont été trouvés
      */
     bool intersects(Ray& ray, std::vector<SceneObject*>& candidates);
-    
+
+    /**
+     * Trouve l'intersection la plus proche le long du rayon
+     * - Les enfants sont visités du plus proche au plus lointain
+     * - Chaque impact réduit la distance maximale de recherche
+     * - Les nœuds dont l'entrée est au-delà du meilleur impact sont ignorés
+     * @param ray Le rayon à tester
+     * @param closest Intersection la plus proche (Distance = distance au carré)
+     * @param culling Faces à ignorer
+     * @return true si un objet a été touché
+     */
+    bool closestIntersection(Ray& ray, Intersection& closest, CullingType culling) override;
+
+    /**
+     * Requête d'ombre: s'arrête au premier objet qui bloque le rayon avant maxDistance
+     * @param ray Le rayon à tester
+     * @param maxDistance Distance jusqu'à la lumière
+     * @return true si un objet bloque le rayon
+     */
+    bool occluded(Ray& ray, double maxDistance) override;
+
 private:
-    BSPNode* root = nullptr;
-    
+    std::vector<BSPNode> nodes;          // Nœuds en ordre profondeur d'abord, racine en 0
+    std::vector<uint32_t> primIndices;   // Indices dans objects, regroupés par feuille (répétés en SBVH)
+    std::vector<uint32_t> unboundedIndices;  // Objets non bornés (plans): hors de l'arbre, testés à part
+    std::vector<SceneObject*> objects;   // Primitives dans l'ordre fourni à build()
+    const PrimitiveSet* primitives = nullptr;  // Ou primitives compactes (build(primitives)), objects reste vide
+    std::vector<Vector3> centroids;      // Centres des AABB (construction uniquement)
+    std::vector<AABB> primBoxes;         // Boîtes des primitives compactes (construction uniquement)
+    uint32_t primBatch = 1;              // Primitives testées ensemble dans une feuille (PrimitiveSet::batchSize)
+    BSPBuildStrategy configuredStrategy = BUILD_SAH;  // Réglages de configure(), pour build(objects)
+    int configuredMaxDepth = 10;
+    int configuredMinObjects = 2;
+    BSPBuildStrategy builtStrategy = BUILD_SAH;
+    int builtMaxDepth = 10;
+    int builtMinObjects = 2;
+    double builtCost = 0;                // Coût SAH juste après build(), référence pour refit()
+
+    int width = BSP_DEFAULT_WIDTH;
+    int quantizationBits = 0;
+    bool wideStale = false;              // Arbre large périmé par insert/remove: parcours binaire jusqu'au prochain collapse()
+
+    // Structures des modifications incrémentales, créées au premier insert/remove après build()
+    bool incrementalReady = false;
+    std::vector<uint32_t> parents;       // Parent de chaque nœud (BSP_NO_NODE pour la racine)
+    std::vector<uint32_t> heights;       // Hauteur du sous-arbre de chaque nœud (feuille: 0)
+    std::vector<uint32_t> primLeaf;      // Feuille de chaque primitive (BSP_NO_NODE ou BSP_MULTI_LEAF)
+    std::unordered_map<SceneObject*, uint32_t> primOf;  // Index de chaque objet dans objects
+    std::vector<uint32_t> freePrims;     // Emplacements de objects libérés par remove()
+    std::vector<uint32_t> freeSlots;     // Emplacements de primIndices hors de toute feuille, réutilisés par insert()
+    std::vector<BSPWideNode<4>> wideNodes4;  // BVH4 (width == 4), racine en 0
+    std::vector<BSPWideNode<8>> wideNodes8;  // BVH8 (width == 8), racine en 0
+    std::vector<BSPQuantizedNode<4, uint8_t>> quantizedNodes4x8;    // BVH4 compressé 8 bits
+    std::vector<BSPQuantizedNode<4, uint16_t>> quantizedNodes4x16;  // BVH4 compressé 16 bits
+    std::vector<BSPQuantizedNode<8, uint8_t>> quantizedNodes8x8;    // BVH8 compressé 8 bits
+    std::vector<BSPQuantizedNode<8, uint16_t>> quantizedNodes8x16;  // BVH8 compressé 16 bits
+
     /**
-     * Construit récursivement un nœud de l'arbre
+     * Construction commune aux deux build(), sur objects ou primitives
      */
-    BSPNode* buildRecursive(std::vector<SceneObject*>& objects, int depth, int maxDepth, int minObjects);
-    
+    void buildTree(BSPBuildStrategy strategy, int maxDepth, int minObjects);
+
+    size_t primitiveCount() const { return primitives ? primitives->size() : objects.size(); }
+
     /**
-     * Calcule l'AABB englobant tous les objets
+     * Coût SAH des tests de count primitives d'une feuille (par paquets de primBatch)
      */
-    AABB computeBoundingBox(std::vector<SceneObject*>& objects);
-    
+    double intersectionCost(uint32_t count) const;
+    AABB primitiveBounds(uint32_t prim) const {
+        if (!primitives) {
+            return objects[prim]->boundingBox;
+        }
+        return primBoxes.empty() ? primitives->bounds(prim) : primBoxes[prim];
+    }
+    void splitPrimitive(uint32_t prim, const AABB& box, int axis, double position, AABB& left, AABB& right) const {
+        if (primitives) {
+            primitives->splitBounds(prim, box, axis, position, left, right);
+        } else {
+            objects[prim]->splitBoundingBox(box, axis, position, left, right);
+        }
+    }
+
     /**
-     * Trouve l'axe le plus long de l'AABB pour la division
+     * Bornes du sous-arbre de index recalculées depuis les feuilles (ordre indifférent)
+     * @return false si un objet est devenu non borné
      */
-    int findSplitAxis(AABB& box);
-    
+    bool refitNode(uint32_t index);
+
+    /**
+     * Crée parents, heights, primLeaf et primOf à partir de l'arbre construit
+     * @return false si les nœuds binaires ont été libérés (format compressé)
+     */
+    bool prepareIncremental();
+
+    /**
+     * Remonte de index à la racine: bornes, hauteurs et rotations
+     */
+    void refitUpward(uint32_t index);
+
+    /**
+     * Rotation locale sous index si elle réduit la surface d'un enfant sans
+     * augmenter la hauteur de index
+     */
+    void rotate(uint32_t index);
+
+    /**
+     * Ajoute un nœud (feuille ou interne) à la fin du tableau
+     */
+    uint32_t appendNode(const BSPNode& node, uint32_t parent, uint32_t height);
+
+    /**
+     * Remplace l'enfant oldChild de parent par newChild
+     */
+    void replaceChild(uint32_t parent, uint32_t oldChild, uint32_t newChild);
+
+    /**
+     * Libère le nœud index: le dernier nœud du tableau prend sa place
+     */
+    void releaseNode(uint32_t index);
+
+    /**
+     * Copie le nœud from à l'index to et rattache ses enfants (ou ses primitives)
+     */
+    void moveNode(uint32_t from, uint32_t to);
+
+    /**
+     * Reconstruit l'arbre large (éventuellement compressé) correspondant au format
+     * choisi à partir des nœuds binaires
+     */
+    void collapse();
+
+    /**
+     * Aplatit le sous-arbre binaire de binaryIndex dans out
+     * Tant qu'il reste de la place, l'enfant interne de plus grande surface est
+     * remplacé par ses deux enfants: les nœuds larges regroupent les boîtes qui
+     * seraient le plus souvent testées ensemble.
+     * @return index du nœud large créé
+     */
+    template <int N>
+    uint32_t collapseNode(uint32_t binaryIndex, std::vector<BSPWideNode<N>>& out);
+
+    /**
+     * Teste les primitives indices[0, count) (une feuille, ou la liste des objets non bornés)
+     */
+    void intersectPrimitives(const uint32_t* indices, uint32_t count, Ray& ray, CullingType culling,
+                             Intersection& closestInter, double& closestDistanceSquared);
+    bool occludedPrimitives(const uint32_t* indices, uint32_t count, Ray& ray, double maxDistance);
+
+    /**
+     * Parcours de l'arbre binaire; closestInter et closestDistanceSquared peuvent
+     * déjà contenir un impact (objets non bornés), qui élague le parcours
+     */
+    void closestIntersectionBinary(Ray& ray, CullingType culling, Intersection& closestInter,
+                                   double& closestDistanceSquared);
+    bool occludedBinary(Ray& ray, double maxDistance);
+
     /**
-     * Traverse l'arbre récursivement pour trouver les candidats
+     * Compresse un arbre large float dans out (mêmes index de nœuds)
      */
-    void traverseRecursive(BSPNode* node, Ray& ray, std::vector<SceneObject*>& candidates);
-    
+    template <int N, typename Q>
+    static void quantize(const std::vector<BSPWideNode<N>>& wide, std::vector<BSPQuantizedNode<N, Q>>& out);
+
+    /**
+     * Parcours d'un arbre large; NodeT = BSPWideNode<N> ou BSPQuantizedNode<N, Q>
+     * (décodé à la volée)
+     */
+    template <int N, typename NodeT>
+    void closestIntersectionWide(const std::vector<NodeT>& wideNodes, Ray& ray, CullingType culling,
+                                 Intersection& closestInter, double& closestDistanceSquared);
+
+    template <int N, typename NodeT>
+    bool occludedWide(const std::vector<NodeT>& wideNodes, Ray& ray, double maxDistance);
+
     /**
-     * Libère la mémoire de l'arbre
+     * Construit le sous-arbre couvrant primIndices[begin, end) dans out
+     * @return index (dans out) de la racine du sous-arbre
      */
-    void destroyRecursive(BSPNode* node);
+    typedef std::function<uint32_t(uint32_t begin, uint32_t end, std::vector<BSPNode>& out, unsigned int threads)> ChildBuilder;
+
+    /**
+     * Construit récursivement le nœud couvrant primIndices[begin, end)
+     * @param out Tableau de nœuds où écrire (nodes, ou tableau local d'un thread)
+     * @param threads Nombre de threads disponibles pour ce sous-arbre
+     * @return index du nœud créé
+     */
+    uint32_t buildRecursive(uint32_t begin, uint32_t end, int depth, int maxDepth, int minObjects,
+                            std::vector<BSPNode>& out, unsigned int threads);
+
+    /**
+     * Construit récursivement un nœud en choisissant la coupe de coût SAH minimal.
+     * La taille des feuilles découle du coût: on arrête dès que couper coûte plus
+     * cher que de tester tous les objets.
+     */
+    uint32_t buildSAHRecursive(uint32_t begin, uint32_t end, int depth, std::vector<BSPNode>& out, unsigned int threads);
+
+    /**
+     * Construction LBVH: codes de Morton des centres, tri par base, puis hiérarchie en une passe.
+     * Plus rapide que le SAH, au prix d'un arbre un peu moins efficace au parcours.
+     */
+    uint32_t buildLBVH(uint32_t begin, uint32_t end, std::vector<BSPNode>& out, unsigned int threads);
+    uint32_t buildLBVHRecursive(uint32_t begin, uint32_t end, int bit, int depth, const uint64_t* codes,
+                                std::vector<BSPNode>& out, unsigned int threads);
+
+    /**
+     * Construction SBVH (Spatial split BVH) sur des références de primitives
+     * Comme le SAH par casiers, avec en plus des coupes spatiales qui découpent
+     * les primitives à cheval sur le plan, dans la limite d'un budget de duplication.
+     * Les feuilles sont écrites à la suite de outIndices.
+     * @param refs Références du nœud (vidé avant la récursion)
+     * @param budget Nombre de références supplémentaires autorisées dans ce sous-arbre
+     * @param rootArea Surface de la racine bornée, pour le seuil de recouvrement
+     * @return index (dans out) du nœud créé
+     */
+    uint32_t buildSBVHRecursive(std::vector<BSPReference>& refs, int depth, size_t budget, double rootArea,
+                                std::vector<BSPNode>& out, std::vector<uint32_t>& outIndices, unsigned int threads);
+
+    /**
+     * Trie primIndices[begin, end) et codes[begin, end) par code croissant
+     * @param bits Nombre de bits significatifs des codes
+     */
+    void sortByMortonCode(uint32_t begin, uint32_t end, std::vector<uint64_t>& codes, int bits, unsigned int threads);
+
+    /**
+     * Construit les enfants [begin, mid) et [mid, end) de out[nodeIndex] et les y relie.
+     * Les grands sous-arbres droits sont construits sur un autre thread.
+     */
+    void buildChildren(uint32_t nodeIndex, uint32_t begin, uint32_t mid, uint32_t end,
+                       std::vector<BSPNode>& out, unsigned int threads, ChildBuilder const& buildChild);
+
+    /**
+     * Ajoute un nœud au tableau avec les bornes données
+     */
+    uint32_t allocateNode(AABB const& box, std::vector<BSPNode>& out);
+
+    /**
+     * Transforme le nœud en feuille couvrant primIndices[begin, end)
+     */
+    void makeLeaf(BSPNode& node, uint32_t begin, uint32_t end);
+
+    /**
+     * Calcule l'AABB englobant les objets de primIndices[begin, end)
+     */
+    AABB computeBoundingBox(uint32_t begin, uint32_t end);
+
+    /**
+     * Trouve l'axe le plus long de l'AABB pour la division
+     */
+    int findSplitAxis(AABB& box);
 };
@@ -3,6 +3,7 @@
 #include <thread>
 #include <vector>
 #include "Camera.hpp"
+#include "Parallel.hpp"
 #include "../raymath/Ray.hpp"
 
 // OPTIMISATION : Ajout du champ halfHeight pour éviter les divisions répétées dans la boucle de rendu
@@ -122,9 +123,8 @@ void Camera::render(Image &image, Scene &scene)
   scene.prepare();
 
 #ifdef USE_MULTITHREADING
-  // MODE MULTITHREADING : Obtenir le nombre de threads disponibles
-  unsigned int nthreads = std::thread::hardware_concurrency();
-  if (nthreads == 0) nthreads = 1; // Fallback si la détection échoue
+  // MODE MULTITHREADING : Obtenir le nombre de threads disponibles (le même que pour la construction des arbres)
+  unsigned int nthreads = getThreadCount();
 
   std::vector<std::thread> threads;
   std::vector<RenderSegment> segments(nthreads);
@@ -0,0 +1,405 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "KdTree.hpp"
+
+// Coûts du modèle SAH (seul leur rapport compte)
+static const double KD_TRAVERSAL_COST = 1.0;    // Descente d'un nœud
+static const double KD_INTERSECTION_COST = 1.5; // Test d'une primitive
+static const double KD_EMPTY_BONUS = 0.8;       // Réduction du coût si une cellule fille est vide
+
+// Boîte aux lettres: une primitive découpée est référencée par plusieurs feuilles
+static const uint32_t KD_MAILBOX_SIZE = 64;     // Puissance de 2
+
+// Marge relative sur les distances aux plans de coupe: un rayon qui passe par un sommet
+// ou une arête posés sur un plan visite les deux cellules, à un arrondi près
+static const double KD_SPLIT_SCALE = 1.0 + 4 * std::numeric_limits<double>::epsilon();
+
+static double axisValue(const Vector3& v, int axis) {
+    if (axis == 0) return v.x;
+    if (axis == 1) return v.y;
+    return v.z;
+}
+
+KdTree::KdTree() {}
+
+KdTree::~KdTree() {
+    // Les objets ne sont pas détruits ici, ils appartiennent à la Scene
+}
+
+size_t KdTree::getLeafCount() const {
+    size_t count = 0;
+    for (const KdNode& node : nodes) {
+        if (node.isLeaf()) count++;
+    }
+    return count;
+}
+
+void KdTree::build(std::vector<SceneObject*>& objects) {
+    this->objects = objects;
+    primitives = nullptr;
+    buildTree();
+}
+
+void KdTree::build(const PrimitiveSet& primitives) {
+    objects.clear();
+    this->primitives = &primitives;
+    buildTree();
+}
+
+void KdTree::buildTree() {
+    nodes.clear();
+    primIndices.clear();
+    unboundedIndices.clear();
+
+    std::vector<Reference> refs;
+    const uint32_t total = static_cast<uint32_t>(primitives ? primitives->size() : objects.size());
+    for (uint32_t i = 0; i < total; ++i) {
+        const AABB box = primitives ? primitives->bounds(i) : objects[i]->boundingBox;
+        if (!box.isFinite()) {
+            unboundedIndices.push_back(i);
+            continue;
+        }
+        if (refs.empty()) bounds = box; else bounds.subsume(box);
+        refs.push_back({i, box});
+    }
+    if (refs.empty()) {
+        return;
+    }
+
+    // Profondeur usuelle des kd-trees SAH (Pharr & Humphreys)
+    const int maxDepth = std::min(KD_MAX_DEPTH, static_cast<int>(8 + 1.3 * std::log2(static_cast<double>(refs.size()))));
+    buildRecursive(refs, bounds, 0, maxDepth);
+}
+
+void KdTree::makeLeaf(const std::vector<Reference>& refs) {
+    KdNode leaf;
+    leaf.split = 0;
+    leaf.flags = (static_cast<uint32_t>(primIndices.size()) << 2) | 3u;
+    leaf.count = static_cast<uint32_t>(refs.size());
+    for (const Reference& ref : refs) {
+        primIndices.push_back(ref.prim);
+    }
+    nodes.push_back(leaf);
+}
+
+/**
+ * Construction SAH
+ *
+ * ALGORITHME:
+ * 1. Candidats: bords des boîtes des références strictement dans la cellule
+ * 2. Pour un plan p: NL = boîtes commençant avant p, NR = boîtes finissant après p
+ *    (deux recherches dichotomiques dans les bords triés)
+ * 3. Coût = traversée + intersection * (aire(L) * NL + aire(R) * NR) / aire(cellule),
+ *    réduit si une cellule fille est vide (élague l'espace vide)
+ * 4. Feuille si aucun plan ne bat le coût de la feuille, sinon partition:
+ *    les références à cheval sont découpées par l'objet lui-même
+ */
+void KdTree::buildRecursive(std::vector<Reference>& refs, const AABB& cell, int depth, int maxDepth) {
+    const size_t count = refs.size();
+    const double cellArea = cell.surfaceArea();
+    if (count <= 1 || depth >= maxDepth || cellArea <= 0) {
+        makeLeaf(refs);
+        return;
+    }
+
+    // Étapes 1 à 3: meilleur plan sur les trois axes
+    double bestCost = KD_INTERSECTION_COST * count;
+    int bestAxis = -1;
+    double bestSplit = 0;
+    std::vector<double> mins(count);
+    std::vector<double> maxs(count);
+    for (int axis = 0; axis < 3; ++axis) {
+        const double lo = axisValue(cell.getMin(), axis);
+        const double hi = axisValue(cell.getMax(), axis);
+        if (hi <= lo) {
+            continue;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            mins[i] = axisValue(refs[i].box.getMin(), axis);
+            maxs[i] = axisValue(refs[i].box.getMax(), axis);
+        }
+        std::sort(mins.begin(), mins.end());
+        std::sort(maxs.begin(), maxs.end());
+
+        auto evaluate = [&](double split) {
+            if (split <= lo || split >= hi) {
+                return;
+            }
+            const size_t countLeft = std::lower_bound(mins.begin(), mins.end(), split) - mins.begin();
+            const size_t countRight = maxs.end() - std::upper_bound(maxs.begin(), maxs.end(), split);
+            const double areaLeft = cell.slice(axis, lo, split).surfaceArea();
+            const double areaRight = cell.slice(axis, split, hi).surfaceArea();
+            double cost = KD_TRAVERSAL_COST
+                        + KD_INTERSECTION_COST * (areaLeft * countLeft + areaRight * countRight) / cellArea;
+            if (countLeft == 0 || countRight == 0) {
+                cost *= KD_EMPTY_BONUS;
+            }
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = split;
+            }
+        };
+        for (size_t i = 0; i < count; ++i) {
+            if (i == 0 || mins[i] != mins[i - 1]) evaluate(mins[i]);
+            if (i == 0 || maxs[i] != maxs[i - 1]) evaluate(maxs[i]);
+        }
+    }
+
+    if (bestAxis < 0) {
+        makeLeaf(refs);
+        return;
+    }
+
+    // Étape 4: partition (les boîtes plates posées sur le plan vont à gauche)
+    std::vector<Reference> left;
+    std::vector<Reference> right;
+    for (const Reference& ref : refs) {
+        const double min = axisValue(ref.box.getMin(), bestAxis);
+        const double max = axisValue(ref.box.getMax(), bestAxis);
+        if (max < bestSplit || (max == bestSplit && min < bestSplit) || (min == bestSplit && max == bestSplit)) {
+            left.push_back(ref);
+        } else if (min >= bestSplit) {
+            right.push_back(ref);
+        } else {
+            AABB leftBox;
+            AABB rightBox;
+            if (primitives) {
+                primitives->splitBounds(ref.prim, ref.box, bestAxis, bestSplit, leftBox, rightBox);
+            } else {
+                objects[ref.prim]->splitBoundingBox(ref.box, bestAxis, bestSplit, leftBox, rightBox);
+            }
+            if (leftBox.isEmpty() && rightBox.isEmpty()) {
+                // Découpe dégénérée: la référence reste entière des deux côtés
+                leftBox = ref.box.slice(bestAxis, min, bestSplit);
+                rightBox = ref.box.slice(bestAxis, bestSplit, max);
+            }
+            if (!leftBox.isEmpty()) left.push_back({ref.prim, leftBox});
+            if (!rightBox.isEmpty()) right.push_back({ref.prim, rightBox});
+        }
+    }
+    if (left.size() == count && right.size() == count) {
+        makeLeaf(refs);
+        return;
+    }
+    std::vector<Reference>().swap(refs);
+
+    const AABB leftCell = cell.slice(bestAxis, axisValue(cell.getMin(), bestAxis), bestSplit);
+    const AABB rightCell = cell.slice(bestAxis, bestSplit, axisValue(cell.getMax(), bestAxis));
+
+    const size_t index = nodes.size();
+    KdNode node;
+    node.split = bestSplit;
+    node.flags = static_cast<uint32_t>(bestAxis);
+    node.count = 0;
+    nodes.push_back(node);
+
+    buildRecursive(left, leftCell, depth + 1, maxDepth);
+    nodes[index].flags |= static_cast<uint32_t>(nodes.size()) << 2;
+    buildRecursive(right, rightCell, depth + 1, maxDepth);
+}
+
+/**
+ * Parcours d'avant en arrière avec une pile de cellules lointaines
+ *
+ * ALGORITHME:
+ * 1. Intervalle [tMin, tMax] du rayon dans la cellule racine
+ * 2. Nœud interne: distance tSplit jusqu'au plan
+ *    - plan hors de [tMin, tMax]: une seule fille est traversée
+ *    - sinon: la fille lointaine est empilée avec [tSplit, tMax], on descend dans
+ *      la proche avec [tMin, tSplit]
+ * 3. Feuille: visite, puis dépilement de la prochaine cellule lointaine
+ */
+template <typename Visitor>
+void KdTree::traverse(Ray& ray, double tMax, Visitor&& visit) const {
+    if (nodes.empty()) {
+        return;
+    }
+
+    const Vector3 origin = ray.GetPosition();
+    const Vector3 direction = ray.GetDirection();
+    const double o[3] = {origin.x, origin.y, origin.z};
+    const double d[3] = {direction.x, direction.y, direction.z};
+    double inv[3];
+
+    // Étape 1: intervalle dans la cellule racine
+    double tMin = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        const double lo = axisValue(bounds.getMin(), axis);
+        const double hi = axisValue(bounds.getMax(), axis);
+        if (d[axis] == 0) {
+            if (o[axis] < lo || o[axis] > hi) {
+                return;
+            }
+            inv[axis] = 0;
+            continue;
+        }
+        inv[axis] = 1.0 / d[axis];
+        double tNear = (lo - o[axis]) * inv[axis];
+        double tFar = (hi - o[axis]) * inv[axis];
+        if (tNear > tFar) std::swap(tNear, tFar);
+        tMin = std::max(tMin, tNear);
+        tMax = std::min(tMax, tFar);
+    }
+    if (tMin > tMax * KD_SPLIT_SCALE) {
+        return;
+    }
+
+    struct StackEntry {
+        uint32_t node;
+        double tMin;
+        double tMax;
+    };
+    StackEntry stack[KD_MAX_DEPTH];
+    int stackSize = 0;
+    uint32_t index = 0;
+
+    while (true) {
+        // Étape 2: descente jusqu'à une feuille
+        const KdNode* node = &nodes[index];
+        while (!node->isLeaf()) {
+            const int axis = node->axis();
+            uint32_t nearChild = index + 1;
+            uint32_t farChild = node->right();
+            if (o[axis] > node->split || (o[axis] == node->split && d[axis] > 0)) {
+                std::swap(nearChild, farChild);
+            }
+
+            if (d[axis] == 0) {
+                // Rayon parallèle au plan: les deux cellules s'il est dans le plan
+                if (o[axis] == node->split) {
+                    stack[stackSize++] = {farChild, tMin, tMax};
+                }
+                index = nearChild;
+            } else {
+                const double tSplit = (node->split - o[axis]) * inv[axis];
+                if (tSplit > tMax * KD_SPLIT_SCALE || tSplit <= 0) {
+                    index = nearChild;
+                } else if (tSplit * KD_SPLIT_SCALE < tMin) {
+                    index = farChild;
+                } else {
+                    stack[stackSize++] = {farChild, tSplit, tMax};
+                    index = nearChild;
+                    tMax = tSplit;
+                }
+            }
+            node = &nodes[index];
+        }
+
+        // Étape 3: feuille
+        if (node->count > 0 && !visit(&primIndices[node->primOffset()], node->count, tMax)) {
+            return;
+        }
+        if (stackSize == 0) {
+            return;
+        }
+        --stackSize;
+        index = stack[stackSize].node;
+        tMin = stack[stackSize].tMin;
+        tMax = stack[stackSize].tMax;
+    }
+}
+
+/**
+ * Test d'un objet, même filtre que les feuilles du BSPTree
+ */
+static inline void intersectObject(SceneObject* obj, Ray& ray, CullingType culling, const Vector3& o,
+                                   Intersection& closestInter, double& closestDistanceSquared) {
+    Intersection intersection;
+    if (!obj->boundingBox.intersects(ray)) {
+        return;
+    }
+    if (obj->intersects(ray, intersection, culling)) {
+        intersection.Distance = (intersection.Position - o).lengthSquared();
+        if (closestDistanceSquared < 0 || intersection.Distance < closestDistanceSquared) {
+            closestDistanceSquared = intersection.Distance;
+            closestInter = intersection;
+        }
+    }
+}
+
+static inline bool occludedObject(SceneObject* obj, Ray& ray, double maxDistance) {
+    if (!obj->boundingBox.intersects(ray)) {
+        return false;
+    }
+    return obj->occluded(ray, maxDistance);
+}
+
+void KdTree::intersectPrimitive(uint32_t index, Ray& ray, CullingType culling, const Vector3& o,
+                                Intersection& closestInter, double& closestDistanceSquared) const {
+    if (primitives) {
+        primitives->intersect(&index, 1, ray, culling, closestInter, closestDistanceSquared);
+    } else {
+        intersectObject(objects[index], ray, culling, o, closestInter, closestDistanceSquared);
+    }
+}
+
+bool KdTree::occludedPrimitive(uint32_t index, Ray& ray, double maxDistance) const {
+    return primitives ? primitives->occluded(&index, 1, ray, maxDistance) : occludedObject(objects[index], ray, maxDistance);
+}
+
+/**
+ * Recherche de l'intersection la plus proche
+ * Les cellules étant disjointes et visitées dans l'ordre, un impact situé avant
+ * la sortie de la feuille courante ne peut plus être battu.
+ */
+bool KdTree::closestIntersection(Ray& ray, Intersection& closest, CullingType culling) {
+    Intersection closestInter;
+    double closestDistanceSquared = -1;
+    const Vector3 o = ray.GetPosition();
+
+    for (uint32_t index : unboundedIndices) {
+        intersectPrimitive(index, ray, culling, o, closestInter, closestDistanceSquared);
+    }
+
+    uint32_t mailbox[KD_MAILBOX_SIZE];
+    std::fill(mailbox, mailbox + KD_MAILBOX_SIZE, UINT32_MAX);
+
+    const double tMax = closestDistanceSquared < 0 ? std::numeric_limits<double>::infinity()
+                                                    : std::sqrt(closestDistanceSquared);
+    traverse(ray, tMax, [&](const uint32_t* indices, uint32_t count, double tExit) {
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint32_t index = indices[i];
+            uint32_t& slot = mailbox[index & (KD_MAILBOX_SIZE - 1)];
+            if (slot == index) {
+                continue;
+            }
+            slot = index;
+            intersectPrimitive(index, ray, culling, o, closestInter, closestDistanceSquared);
+        }
+        return closestDistanceSquared < 0 || closestDistanceSquared > tExit * tExit;
+    });
+
+    closest = closestInter;
+    return closestDistanceSquared > -1;
+}
+
+bool KdTree::occluded(Ray& ray, double maxDistance) {
+    for (uint32_t index : unboundedIndices) {
+        if (occludedPrimitive(index, ray, maxDistance)) {
+            return true;
+        }
+    }
+
+    uint32_t mailbox[KD_MAILBOX_SIZE];
+    std::fill(mailbox, mailbox + KD_MAILBOX_SIZE, UINT32_MAX);
+
+    bool hit = false;
+    traverse(ray, maxDistance, [&](const uint32_t* indices, uint32_t count, double) {
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint32_t index = indices[i];
+            uint32_t& slot = mailbox[index & (KD_MAILBOX_SIZE - 1)];
+            if (slot == index) {
+                continue;
+            }
+            slot = index;
+            if (occludedPrimitive(index, ray, maxDistance)) {
+                hit = true;
+                return false;
+            }
+        }
+        return true;
+    });
+    return hit;
+}
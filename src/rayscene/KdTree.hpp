@@ -0,0 +1,129 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "../raymath/AABB.hpp"
+#include "../raymath/Ray.hpp"
+#include "SceneObject.hpp"
+#include "Accelerator.hpp"
+
+/**
+ * kd-tree (accélérateur alternatif au BSPTree)
+ *
+ * Contrairement au BSPTree, qui partitionne les objets (ses boîtes peuvent se
+ * chevaucher), le kd-tree partitionne l'espace: chaque nœud coupe sa cellule
+ * par un plan aligné sur un axe, et les deux cellules filles sont disjointes.
+ *
+ * Principe:
+ * - Plans de coupe choisis par SAH parmi les bords des boîtes des primitives
+ * - Une primitive à cheval sur le plan est référencée des deux côtés, sa boîte
+ *   découpée par SceneObject::splitBoundingBox (coupes « parfaites » des triangles)
+ * - Parcours strictement d'avant en arrière: le premier impact situé dans la
+ *   cellule courante est le plus proche, le parcours s'arrête là
+ *
+ * Représentation mémoire:
+ * - Nœuds de 16 octets dans un seul tableau, en ordre profondeur d'abord
+ *   (l'enfant gauche suit son parent, seul l'enfant droit est stocké)
+ * - Les feuilles désignent une plage du tableau d'indices de primitives
+ * - Parcours avec une courte pile de cellules lointaines (pas de ropes: la pile
+ *   est bornée par la profondeur et ne coûte aucune mémoire par nœud)
+ * - Les objets non bornés (plans) restent hors de l'arbre, comme dans le BSPTree
+ */
+
+// Profondeur maximale de l'arbre = taille de la pile de parcours
+static const int KD_MAX_DEPTH = 48;
+
+/**
+ * Nœud compact de 16 octets
+ */
+struct KdNode {
+    double split;      // Nœud interne: position du plan de coupe
+    uint32_t flags;    // 2 bits de poids faible: axe (0, 1, 2) ou 3 pour une feuille
+                       // 30 bits de poids fort: index de l'enfant droit, ou début de la plage de la feuille
+    uint32_t count;    // Feuille: nombre de primitives
+
+    bool isLeaf() const { return (flags & 3u) == 3u; }
+    int axis() const { return static_cast<int>(flags & 3u); }
+    uint32_t right() const { return flags >> 2; }
+    uint32_t primOffset() const { return flags >> 2; }
+};
+
+class KdTree : public Accelerator {
+public:
+    KdTree();
+    ~KdTree();
+
+    AcceleratorType getType() const override { return ACCELERATOR_KDTREE; }
+
+    /**
+     * Construit l'arbre (coût SAH, profondeur bornée par 8 + 1.3 log2(n))
+     * @param objects Liste des objets de la scène (boundingBox à jour)
+     */
+    void build(std::vector<SceneObject*>& objects) override;
+    void build(const PrimitiveSet& primitives) override;
+
+    /**
+     * Trouve l'intersection la plus proche le long du rayon
+     * @param closest Intersection la plus proche (Distance = distance au carré)
+     * @return true si un objet a été touché
+     */
+    bool closestIntersection(Ray& ray, Intersection& closest, CullingType culling) override;
+
+    /**
+     * Requête d'ombre: s'arrête au premier objet qui bloque le rayon avant maxDistance
+     */
+    bool occluded(Ray& ray, double maxDistance) override;
+
+    /**
+     * Statistiques: nombre de nœuds, de feuilles et de références de primitives
+     */
+    size_t getNodeCount() const { return nodes.size(); }
+    size_t getLeafCount() const;
+    size_t getReferenceCount() const { return primIndices.size(); }
+
+private:
+    /**
+     * Référence de primitive pendant la construction: sa boîte peut n'être
+     * qu'un morceau de celle de l'objet (après découpe)
+     */
+    struct Reference {
+        uint32_t prim;
+        AABB box;
+    };
+
+    std::vector<SceneObject*> objects;      // Primitives dans l'ordre fourni à build()
+    const PrimitiveSet* primitives = nullptr;  // Ou primitives compactes, objects reste vide
+    std::vector<KdNode> nodes;              // Nœuds en ordre profondeur d'abord
+    std::vector<uint32_t> primIndices;      // Indices dans objects, par plages de feuilles
+    std::vector<uint32_t> unboundedIndices; // Objets non bornés: hors de l'arbre, testés à part
+    AABB bounds;                            // Cellule de la racine
+
+    /**
+     * Construction commune aux deux build(), sur objects ou primitives
+     */
+    void buildTree();
+
+    /**
+     * Test d'une primitive (SceneObject ou primitive compacte)
+     */
+    void intersectPrimitive(uint32_t index, Ray& ray, CullingType culling, const Vector3& o,
+                            Intersection& closestInter, double& closestDistanceSquared) const;
+    bool occludedPrimitive(uint32_t index, Ray& ray, double maxDistance) const;
+
+    /**
+     * Construit le sous-arbre de la cellule cell, ajouté à la fin de nodes
+     */
+    void buildRecursive(std::vector<Reference>& refs, const AABB& cell, int depth, int maxDepth);
+
+    /**
+     * Crée une feuille avec les primitives des références
+     */
+    void makeLeaf(const std::vector<Reference>& refs);
+
+    /**
+     * Parcours d'avant en arrière des feuilles traversées par le rayon entre 0 et tMax
+     * Visitor(indices, count, tExit) reçoit les primitives d'une feuille et la distance
+     * de sortie de sa cellule; il renvoie false pour arrêter le parcours.
+     */
+    template <typename Visitor>
+    void traverse(Ray& ray, double tMax, Visitor&& visit) const;
+};
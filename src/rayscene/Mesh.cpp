@@ -2,7 +2,6 @@
 #include <limits>
 #include "Mesh.hpp"
 #include "../raymath/Vector3.hpp"
-#include "../objloader/OBJ_Loader.h"
 
 Mesh::Mesh() : SceneObject()
 {
@@ -10,173 +9,137 @@ Mesh::Mesh() : SceneObject()
 
 Mesh::~Mesh()
 {
-    const int count = triangles.size();
-    for (int i = 0; i < count; ++i)
-    {
-        delete triangles[i];
-    }
+    // La géométrie est libérée avec sa dernière instance (shared_ptr)
 }
 
 void Mesh::loadFromObj(std::string path)
 {
+    std::shared_ptr<MeshGeometry> geom = std::make_shared<MeshGeometry>();
+    geom->loadFromObj(path);
+    setGeometry(geom);
+}
 
-    objl::Loader *loader = new objl::Loader();
-    bool loadout = loader->LoadFile(path);
+void Mesh::setGeometry(std::shared_ptr<MeshGeometry> geom)
+{
+    geometry = geom;
+}
 
-    if (loadout)
+void Mesh::createWorldTriangles(std::vector<Triangle *> &out) const
+{
+    if (!geometry)
     {
-        for (int i = 0; i < loader->LoadedMeshes.size(); i++)
-        {
-            objl::Mesh curMesh = loader->LoadedMeshes[i];
-
-            for (int j = 0; j < curMesh.Indices.size(); j += 3)
-            {
-                Vector3 v1(
-                    curMesh.Vertices[curMesh.Indices[j]].Position.X,
-                    curMesh.Vertices[curMesh.Indices[j]].Position.Y,
-                    curMesh.Vertices[curMesh.Indices[j]].Position.Z);
-                Vector3 v2(
-                    curMesh.Vertices[curMesh.Indices[j + 1]].Position.X,
-                    curMesh.Vertices[curMesh.Indices[j + 1]].Position.Y,
-                    curMesh.Vertices[curMesh.Indices[j + 1]].Position.Z);
-                Vector3 v3(
-                    curMesh.Vertices[curMesh.Indices[j + 2]].Position.X,
-                    curMesh.Vertices[curMesh.Indices[j + 2]].Position.Y,
-                    curMesh.Vertices[curMesh.Indices[j + 2]].Position.Z);
-
-                Triangle *triangle = new Triangle(
-                    v1,
-                    v2,
-                    v3);
-                triangle->name = "T:" + std::to_string(j);
-                triangle->ID = j;
-                triangles.push_back(triangle);
-            }
-        }
+        return;
+    }
+    const TriangleMesh &triangles = geometry->getTriangles();
+    const uint32_t count = static_cast<uint32_t>(triangles.size());
+    out.reserve(out.size() + count);
+    Vector3 a, b, c;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        triangles.corners(i, a, b, c);
+        Triangle *copy = new Triangle(a, b, c);
+        copy->transform = transform;
+        copy->material = material;
+        out.push_back(copy);
     }
-
-    this->applyTransform();
-    delete loader;
 }
 
+/*
+ * OPTIMISATION : Instanciation des meshes
+ *
+ * CODE AVANT :
+ *   for (...) {
+ *     triangles[i]->transform = transform;
+ *     triangles[i]->applyTransform();  // Copie monde de chaque triangle, par instance
+ *   }
+ *   // + un BSP Tree reconstruit par instance, à chaque prepare()
+ *
+ * CODE APRÈS : la géométrie reste en espace objet, construite une seule fois
+ * pour toutes les instances ; seul le rayon est transformé (voir intersects)
+ */
 void Mesh::applyTransform()
 {
-    const int count = triangles.size();
-    for (int i = 0; i < count; ++i)
+    if (!geometry)
     {
-        triangles[i]->material = this->material;
-        triangles[i]->transform = transform;
-        triangles[i]->applyTransform();
+        return;
     }
+    geometry->setAcceleratorSettings(accelerator);
+    geometry->prepare();
 }
 
 void Mesh::calculateBoundingBox()
 {
-    if (triangles.empty())
+    if (!geometry || geometry->getTriangleCount() == 0)
     {
         boundingBox = AABB(Vector3(), Vector3());
         return;
     }
 
-    // Calculer les bounding boxes de tous les triangles
-    const int count = triangles.size();
-    triangles[0]->calculateBoundingBox();
-    boundingBox = triangles[0]->boundingBox;
-
-    for (int i = 1; i < count; ++i)
-    {
-        triangles[i]->calculateBoundingBox();
-        boundingBox.subsume(triangles[i]->boundingBox);
-    }
-
-#ifdef USE_BSPTREE
-    // Construire le BSP Tree pour les triangles du mesh
-    // Convertir les triangles en SceneObject* pour le BSP Tree
-    std::vector<SceneObject*> triangleObjects;
-    triangleObjects.reserve(count);
-    for (int i = 0; i < count; ++i)
+    // AABB monde: englober les 8 coins transformés de l'AABB objet
+    Vector3 min = geometry->getBoundingBox().getMin();
+    Vector3 max = geometry->getBoundingBox().getMax();
+    for (int i = 0; i < 8; ++i)
     {
-        triangleObjects.push_back(triangles[i]);
+        Vector3 corner(
+            (i & 1) ? max.x : min.x,
+            (i & 2) ? max.y : min.y,
+            (i & 4) ? max.z : min.z);
+        Vector3 p = transform.apply(corner);
+        if (i == 0)
+        {
+            boundingBox = AABB(p, p);
+        }
+        else
+        {
+            boundingBox.subsume(AABB(p, p));
+        }
     }
-    triangleBSP.build(triangleObjects, 15, 4);  // Plus de profondeur pour les triangles
-#endif
 }
 
 bool Mesh::intersects(Ray &r, Intersection &intersection, CullingType culling)
 {
-#ifdef USE_AABB
     // OPTIMISATION CRITIQUE : Vérifier d'abord la bounding box du mesh ENTIER
     // Si le rayon ne touche pas le mesh, on évite de tester les 967 triangles !
-    if (!boundingBox.intersects(r))
+    // (sauf sans aucune structure, pour mesurer le coût brut des triangles)
+    if (accelerator.type != ACCELERATOR_NONE && !boundingBox.intersects(r))
     {
         return false;
     }
-#endif
-
-    Intersection tInter;
-    double closestDistanceSquared = -1;
-    Intersection closestInter;
-
-#ifdef USE_BSPTREE
-    // OPTIMISATION: Vecteur statique pour éviter réallocations (hot path!)
-    static thread_local std::vector<SceneObject*> candidates;
-    candidates.clear();
-    
-    if (!triangleBSP.intersects(r, candidates))
+
+    if (!geometry)
     {
         return false;
     }
 
-    const int candidateCount = candidates.size();
-    for (int i = 0; i < candidateCount; ++i)
+    // Rayon en espace objet (transformation rigide: les distances sont conservées)
+    Ray localRay(transform.applyInverse(r.GetPosition()), transform.applyInverseDirection(r.GetDirection()));
+
+    Intersection localInter;
+    if (!geometry->intersects(localRay, localInter, culling))
     {
-#ifdef USE_AABB
-        // Vérifier l'AABB du triangle d'abord
-        if (!candidates[i]->boundingBox.intersects(r))
-        {
-            continue;
-        }
-#endif
-        if (candidates[i]->intersects(r, tInter, culling))
-        {
-            tInter.Distance = (tInter.Position - r.GetPosition()).lengthSquared();
-            if (closestDistanceSquared < 0 || tInter.Distance < closestDistanceSquared)
-            {
-                closestDistanceSquared = tInter.Distance;
-                closestInter = tInter;
-            }
-        }
+        return false;
     }
-#else
-    // Version sans BSP Tree: tester tous les triangles
-    const int count = triangles.size();
-    for (int i = 0; i < count; ++i)
+
+    // Retour en espace monde
+    intersection = localInter;
+    intersection.Position = transform.apply(localInter.Position);
+    intersection.Normal = transform.applyDirection(localInter.Normal);
+    intersection.Mat = this->material;
+    return true;
+}
+
+bool Mesh::occluded(Ray &r, double maxDistance)
+{
+    if (accelerator.type != ACCELERATOR_NONE && !boundingBox.intersects(r))
     {
-#ifdef USE_AABB
-        // Optimisation AABB: vérifier la bounding box du triangle
-        if (!triangles[i]->boundingBox.intersects(r))
-        {
-            continue;
-        }
-#endif
-        if (triangles[i]->intersects(r, tInter, culling))
-        {
-            tInter.Distance = (tInter.Position - r.GetPosition()).lengthSquared();
-            if (closestDistanceSquared < 0 || tInter.Distance < closestDistanceSquared)
-            {
-                closestDistanceSquared = tInter.Distance;
-                closestDistanceSquared = tInter.Distance;
-                closestInter = tInter;
-            }
-        }
+        return false;
     }
-#endif
 
-    if (closestDistanceSquared < 0)
+    if (!geometry)
     {
         return false;
     }
 
-    intersection = closestInter;
-    return true;
-}
\ No newline at end of file
+    Ray localRay(transform.applyInverse(r.GetPosition()), transform.applyInverseDirection(r.GetDirection()));
+    return geometry->occluded(localRay, maxDistance);
+}
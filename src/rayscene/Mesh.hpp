@@ -1,30 +1,51 @@
 #pragma once
+#include <memory>
 #include <vector>
 #include "SceneObject.hpp"
 #include "../raymath/Transform.hpp"
 #include "../raymath/Vector3.hpp"
 #include "../raymath/Color.hpp"
 #include "../raymath/Ray.hpp"
+#include "./MeshGeometry.hpp"
 #include "./Triangle.hpp"
-#ifdef USE_BSPTREE
-#include "BSPTree.hpp"
-#endif
 
+/**
+ * Instance d'un mesh dans la scène
+ *
+ * La géométrie (triangles + BSP Tree en espace objet) est partagée entre
+ * toutes les instances d'un même fichier .obj. L'instance ne stocke que sa
+ * transformation: l'arbre de la scène englobe les AABB des instances
+ * (niveau haut), puis le rayon est ramené en espace objet pour parcourir
+ * l'arbre des triangles (niveau bas).
+ */
 class Mesh : public SceneObject
 {
 private:
-  std::vector<Triangle *> triangles;
-#ifdef USE_BSPTREE
-  BSPTree triangleBSP;  // BSP Tree pour les triangles du mesh
-#endif
+  std::shared_ptr<MeshGeometry> geometry;
 
 public:
   Mesh();
   ~Mesh();
 
+  AcceleratorSettings accelerator;  // Structure des triangles et ses réglages
+
   void loadFromObj(std::string path);
 
+  /**
+   * Utilise une géométrie déjà chargée (partagée avec d'autres instances)
+   */
+  void setGeometry(std::shared_ptr<MeshGeometry> geom);
+  std::shared_ptr<MeshGeometry> getGeometry() const { return geometry; }
+
+  /**
+   * Copies en espace monde des triangles de l'instance, pour les placer directement
+   * dans l'arbre de la scène (Scene::flattenMeshes). Elles portent la transformation
+   * et le matériau de l'instance; l'appelant les libère.
+   */
+  void createWorldTriangles(std::vector<Triangle *> &out) const;
+
   virtual void applyTransform() override;
   virtual void calculateBoundingBox() override;
   virtual bool intersects(Ray &r, Intersection &intersection, CullingType culling) override;
+  virtual bool occluded(Ray &r, double maxDistance) override;
 };
@@ -0,0 +1,262 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+#include "MeshGeometry.hpp"
+#include "Parallel.hpp"
+#include "../raymath/Vector3.hpp"
+#include "../objloader/OBJ_Loader.h"
+
+MeshGeometry::MeshGeometry()
+{
+}
+
+MeshGeometry::~MeshGeometry()
+{
+}
+
+namespace
+{
+    /**
+     * Position d'un sommet, comparée bit à bit: seuls les sommets identiques sont fusionnés
+     */
+    struct VertexKey
+    {
+        double x, y, z;
+
+        bool operator==(const VertexKey &other) const
+        {
+            return std::memcmp(this, &other, sizeof(VertexKey)) == 0;
+        }
+    };
+
+    struct VertexKeyHash
+    {
+        size_t operator()(const VertexKey &key) const
+        {
+            uint64_t bits[3];
+            std::memcpy(bits, &key, sizeof(bits));
+            return std::hash<uint64_t>()(bits[0] ^ (bits[1] * 0x9E3779B97F4A7C15ull) ^ (bits[2] * 0xC2B2AE3D27D4EB4Full));
+        }
+    };
+}
+
+/*
+ * OPTIMISATION : Mesh indexé compact
+ *
+ * CODE AVANT :
+ *   Triangle *triangle = new Triangle(v1, v2, v3);  // SceneObject complet par face:
+ *   triangle->name = "T:" + std::to_string(j);      // nom, Transform (matrices 4x4),
+ *   triangles.push_back(triangle);                  // AABB, 6 sommets, vtable
+ *
+ * CODE APRÈS :
+ *   - objl répète chaque sommet dans chaque face: les positions identiques sont
+ *     fusionnées, puis rangées une seule fois en SoA (TriangleMesh)
+ *   - Chaque triangle n'est plus que trois indices 32 bits, dans l'ordre des faces
+ *   - Une allocation par tableau au lieu d'une par triangle, et des feuilles
+ *     dont les sommets voisins partagent les mêmes lignes de cache
+ */
+void MeshGeometry::loadFromObj(std::string path)
+{
+    this->path = path;
+    triangles = TriangleMesh();
+
+    objl::Loader *loader = new objl::Loader();
+    bool loadout = loader->LoadFile(path);
+
+    if (loadout)
+    {
+        size_t indexCount = 0;
+        for (const objl::Mesh &curMesh : loader->LoadedMeshes)
+        {
+            indexCount += curMesh.Indices.size();
+        }
+        // Mesh fermé: environ deux fois moins de sommets que de triangles
+        triangles.reserve(indexCount / 6, indexCount / 3);
+
+        std::unordered_map<VertexKey, uint32_t, VertexKeyHash> vertexIndices;
+        vertexIndices.reserve(indexCount / 6);
+        auto sharedVertex = [this, &vertexIndices](const objl::Vector3 &position)
+        {
+            // Mêmes conversions qu'avant: coordonnées float du fichier, puis double
+            const Vector3 p(position.X, position.Y, position.Z);
+            const VertexKey key = {p.x, p.y, p.z};
+            auto found = vertexIndices.find(key);
+            if (found != vertexIndices.end())
+            {
+                return found->second;
+            }
+            const uint32_t index = triangles.addVertex(p);
+            vertexIndices.emplace(key, index);
+            return index;
+        };
+
+        for (const objl::Mesh &curMesh : loader->LoadedMeshes)
+        {
+            for (size_t j = 0; j + 2 < curMesh.Indices.size(); j += 3)
+            {
+                const uint32_t a = sharedVertex(curMesh.Vertices[curMesh.Indices[j]].Position);
+                const uint32_t b = sharedVertex(curMesh.Vertices[curMesh.Indices[j + 1]].Position);
+                const uint32_t c = sharedVertex(curMesh.Vertices[curMesh.Indices[j + 2]].Position);
+                triangles.addTriangle(a, b, c);
+            }
+        }
+    }
+    triangles.shrinkToFit();
+
+    prepared = false;
+    built = false;
+    delete loader;
+}
+
+void MeshGeometry::setAcceleratorSettings(const AcceleratorSettings &settings)
+{
+    std::lock_guard<std::mutex> lock(prepareMutex);
+    this->settings = settings;
+    if (triangleAccelerator && triangleAccelerator->getType() == settings.type)
+    {
+        built = triangleAccelerator->configure(settings) && built;
+    }
+    else
+    {
+        triangleAccelerator.reset();
+        built = false;
+    }
+}
+
+void MeshGeometry::setLayout(int width, int quantizationBits)
+{
+    AcceleratorSettings layout = settings;
+    layout.bvhWidth = width;
+    layout.bvhQuantization = quantizationBits;
+    setAcceleratorSettings(layout);
+}
+
+void MeshGeometry::invalidate()
+{
+    std::lock_guard<std::mutex> lock(prepareMutex);
+    triangleAccelerator.reset();
+    built = false;
+}
+
+BSPMemoryStats MeshGeometry::getMemoryStats()
+{
+    std::lock_guard<std::mutex> lock(prepareMutex);
+    BSPTree *tree = dynamic_cast<BSPTree *>(triangleAccelerator.get());
+    return tree ? tree->getMemoryStats() : BSPMemoryStats();
+}
+
+unsigned int MeshGeometry::getBuildCount()
+{
+    std::lock_guard<std::mutex> lock(prepareMutex);
+    return buildCount;
+}
+
+double MeshGeometry::getBuildTime()
+{
+    std::lock_guard<std::mutex> lock(prepareMutex);
+    return buildSeconds;
+}
+
+void MeshGeometry::prepare()
+{
+    std::lock_guard<std::mutex> lock(prepareMutex);
+    if (prepared)
+    {
+        return;
+    }
+
+    if (triangles.size() == 0)
+    {
+        boundingBox = AABB(Vector3(), Vector3());
+    }
+    else
+    {
+        prepareBoundingBoxes();
+    }
+    prepared = true;
+}
+
+/*
+ * OPTIMISATION : Construction paresseuse des structures des meshes
+ *
+ * CODE AVANT :
+ *   void MeshGeometry::prepare() {
+ *     prepareBoundingBoxes();
+ *     triangleAccelerator->build(triangleObjects);  // Pour chaque mesh, vu ou non
+ *   }
+ *
+ * CODE APRÈS :
+ *   - prepare() ne calcule que les AABB (boîte de l'instance pour l'arbre de la scène)
+ *   - Le premier rayon qui entre dans la boîte d'une instance construit la structure:
+ *     un booléen atomique évite le verrou une fois construite, le mutex garantit
+ *     une seule construction quand plusieurs threads arrivent en même temps
+ *   - Les meshes hors champ ou cachés ne sont jamais construits: le premier
+ *     pixel sort plus tôt sur les grandes scènes de décor
+ */
+void MeshGeometry::buildAccelerator()
+{
+    std::lock_guard<std::mutex> lock(prepareMutex);
+    if (built.load(std::memory_order_relaxed) || !prepared)
+    {
+        return;
+    }
+    if (triangles.size() == 0)
+    {
+        built.store(true, std::memory_order_release);  // Rien à construire, ni à attendre
+        return;
+    }
+
+    // Structure des triangles (en espace objet)
+    auto begin = std::chrono::high_resolution_clock::now();
+    if (!triangleAccelerator)
+    {
+        triangleAccelerator = Accelerator::create(settings);
+    }
+    triangleAccelerator->build(triangles);
+    auto end = std::chrono::high_resolution_clock::now();
+    buildSeconds += std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() * 1e-9;
+    buildCount++;
+    built.store(true, std::memory_order_release);
+}
+
+void MeshGeometry::prepareBoundingBoxes()
+{
+    // Tous les sommets appartiennent à un triangle: leur AABB est celle de la géométrie.
+    // Une AABB partielle par tranche de sommets
+    const size_t count = triangles.vertexCount();
+    const unsigned int threads = getThreadCount();
+    std::vector<AABB> chunkBoxes(threads);
+    unsigned int chunks = parallelFor(0, count, threads, [this, &chunkBoxes](size_t first, size_t last, unsigned int chunk)
+    {
+        Vector3 min = triangles.vertex(first);
+        Vector3 max = min;
+        for (size_t i = first + 1; i < last; ++i)
+        {
+            const Vector3 p = triangles.vertex(i);
+            min = Vector3(std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z));
+            max = Vector3(std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z));
+        }
+        chunkBoxes[chunk] = AABB(min, max);
+    });
+
+    boundingBox = chunkBoxes[0];
+    for (unsigned int i = 1; i < chunks; ++i)
+    {
+        boundingBox.subsume(chunkBoxes[i]);
+    }
+}
+
+bool MeshGeometry::intersects(Ray &r, Intersection &intersection, CullingType culling)
+{
+    // Requête d'impact le plus proche: s'arrête à la première surface rencontrée
+    build();
+    return triangleAccelerator && triangleAccelerator->closestIntersection(r, intersection, culling);
+}
+
+bool MeshGeometry::occluded(Ray &r, double maxDistance)
+{
+    build();
+    return triangleAccelerator && triangleAccelerator->occluded(r, maxDistance);
+}
@@ -0,0 +1,127 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "SceneObject.hpp"
+#include "../raymath/AABB.hpp"
+#include "../raymath/Ray.hpp"
+#include "./TriangleMesh.hpp"
+#include "Accelerator.hpp"
+#include "BSPTree.hpp"
+
+/**
+ * Géométrie d'un mesh en espace objet, partagée entre ses instances
+ *
+ * Chaque fichier .obj n'est chargé qu'une seule fois : les triangles et leur
+ * structure d'accélération (BSP Tree par défaut) sont construits en espace objet et partagés (std::shared_ptr) par
+ * tous les Mesh qui l'utilisent. Les triangles sont indexés (TriangleMesh): sommets
+ * partagés entre faces, trois indices par triangle, aucun SceneObject. Une instance ne porte que sa transformation
+ * et son matériau, les rayons sont ramenés en espace objet à son entrée.
+ *
+ * La structure des triangles n'est construite qu'au premier rayon qui entre dans
+ * la boîte d'une instance (voir build): un mesh hors champ ou caché ne coûte que
+ * ses AABB.
+ */
+class MeshGeometry
+{
+private:
+  TriangleMesh triangles;  // Sommets partagés et indices, en espace objet
+  std::string path;      // Fichier .obj d'origine
+  AABB boundingBox;      // AABB en espace objet
+  bool prepared = false; // AABB des triangles déjà calculées
+  std::atomic<bool> built{false};  // Structure des triangles construite avec les réglages courants
+  std::mutex prepareMutex; // Plusieurs instances peuvent préparer la géométrie en même temps
+  AcceleratorSettings settings;
+  std::unique_ptr<Accelerator> triangleAccelerator;  // Structure des triangles, en espace objet
+  unsigned int buildCount = 0;  // Constructions de la structure, sous prepareMutex
+  double buildSeconds = 0;      // Durée cumulée de ces constructions
+
+  /**
+   * AABB des triangles et de la géométrie (en parallèle), appelée sous prepareMutex
+   */
+  void prepareBoundingBoxes();
+
+  /**
+   * Construction de la structure, sous prepareMutex (voir build)
+   */
+  void buildAccelerator();
+
+public:
+  MeshGeometry();
+  ~MeshGeometry();
+
+  /**
+   * Structure des triangles et ses réglages. Un changement de type ou de
+   * constructeur la fait reconstruire au prochain prepare(); le format de
+   * l'arbre parcouru s'applique tout de suite (voir BSPTree::setLayout).
+   */
+  void setAcceleratorSettings(const AcceleratorSettings &settings);
+
+  /**
+   * Format de l'arbre parcouru seul (raccourci de setAcceleratorSettings)
+   */
+  void setLayout(int width, int quantizationBits);
+
+  /**
+   * Oublie la structure des triangles: le prochain build() la reconstruit avec
+   * les réglages courants, même s'ils n'ont pas changé (mesures du tuner)
+   */
+  void invalidate();
+
+  /**
+   * Occupation mémoire de l'arbre des triangles (vide si la structure n'est pas un BVH)
+   */
+  BSPMemoryStats getMemoryStats();
+
+  /**
+   * Nombre de constructions de la structure des triangles et leur durée cumulée
+   * en secondes (construites au premier rayon: comptées dans le rendu), à lire hors du rendu
+   */
+  unsigned int getBuildCount();
+  double getBuildTime();
+
+  void loadFromObj(std::string path);
+
+  /**
+   * Calcule les AABB des triangles et de la géométrie, sans construire leur structure.
+   * Sans effet après le premier appel : la géométrie ne change pas entre deux rendus.
+   * Peut être appelée depuis plusieurs threads.
+   */
+  void prepare();
+
+  /**
+   * Construit la structure des triangles si elle n'existe pas avec les réglages
+   * courants (après prepare). Appelée par la première requête qui atteint la
+   * géométrie; les threads qui arrivent pendant la construction l'attendent.
+   */
+  void build()
+  {
+    if (!built.load(std::memory_order_acquire))
+    {
+      buildAccelerator();
+    }
+  }
+
+  AABB getBoundingBox() const { return boundingBox; }
+  size_t getTriangleCount() const { return triangles.size(); }
+  const TriangleMesh &getTriangles() const { return triangles; }
+
+  /**
+   * Octets occupés par les triangles (sommets et indices), hors structure
+   */
+  size_t getTriangleMemory() const { return triangles.memoryBytes(); }
+  const std::string &getPath() const { return path; }
+
+  /**
+   * Structure des triangles (nullptr avant prepare()), à lire hors du rendu
+   */
+  const Accelerator *getAccelerator() const { return triangleAccelerator.get(); }
+
+  /**
+   * Requêtes en espace objet, le rayon doit déjà avoir été transformé
+   */
+  bool intersects(Ray &r, Intersection &intersection, CullingType culling);
+  bool occluded(Ray &r, double maxDistance);
+};
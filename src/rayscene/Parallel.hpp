@@ -0,0 +1,51 @@
+#pragma once
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+/**
+ * Nombre de threads de travail
+ * Le même pour le rendu (Camera) et pour la construction des arbres (BSPTree)
+ */
+inline unsigned int getThreadCount()
+{
+#ifdef USE_MULTITHREADING
+  unsigned int nthreads = std::thread::hardware_concurrency();
+  return nthreads == 0 ? 1 : nthreads; // Fallback si la détection échoue
+#else
+  return 1;
+#endif
+}
+
+/**
+ * Découpe [begin, end) en au plus `threads` tranches contiguës traitées en parallèle
+ * fn(chunkBegin, chunkEnd, chunkIndex) est appelée une fois par tranche,
+ * la tranche 0 s'exécute sur le thread appelant.
+ * @return nombre de tranches utilisées
+ */
+template <typename Fn>
+unsigned int parallelFor(size_t begin, size_t end, unsigned int threads, Fn fn)
+{
+  size_t count = end > begin ? end - begin : 0;
+  unsigned int chunks = static_cast<unsigned int>(std::max<size_t>(1, std::min<size_t>(threads, count)));
+  size_t chunkSize = (count + chunks - 1) / chunks;
+  if (chunkSize > 0)
+  {
+    chunks = static_cast<unsigned int>((count + chunkSize - 1) / chunkSize);
+  }
+
+  std::vector<std::thread> workers;
+  for (unsigned int i = 1; i < chunks; ++i)
+  {
+    size_t chunkBegin = begin + i * chunkSize;
+    size_t chunkEnd = std::min(end, chunkBegin + chunkSize);
+    workers.push_back(std::thread(fn, chunkBegin, chunkEnd, i));
+  }
+  fn(begin, std::min(end, begin + chunkSize), 0u);
+
+  for (auto &worker : workers)
+  {
+    worker.join();
+  }
+  return chunks;
+}
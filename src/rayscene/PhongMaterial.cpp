@@ -33,8 +33,10 @@ Color PhongMaterial::render(Ray &r, Ray &camera, Intersection *intersection, Sce
 
     Vector3 origin = intersection->Position + lightDir;
     Ray lightRay(origin, lightDir);
-    Intersection shadowInter;
-    if (!scene->closestIntersection(lightRay, shadowInter, CULLING_BACK))
+
+    // Seuls les objets entre l'origine du rayon et la lumière projettent une ombre
+    double lightDistance = (light->GetPosition() - origin).dot(lightDir);
+    if (!scene->occluded(lightRay, lightDistance))
     {
 
       float dotProdLN = lightDir.dot(intersection->Normal);
@@ -41,4 +41,18 @@ bool Plane::intersects(Ray &r, Intersection &intersection, CullingType culling)
   intersection.Mat = this->material;
 
   return true;
-}
\ No newline at end of file
+}
+
+bool Plane::occluded(Ray &r, double maxDistance)
+{
+  // Comme intersects(): seule la face avant du plan arrête un rayon
+  float denom = r.GetDirection().dot(normal);
+  if (denom > -0.000001)
+  {
+    return false;
+  }
+
+  float numer = (point - r.GetPosition()).dot(normal);
+  float t = numer / denom;
+  return t > 0 && t < maxDistance;
+}
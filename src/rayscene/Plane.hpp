@@ -14,6 +14,10 @@ public:
   Plane(Vector3 p, Vector3 n);
   ~Plane();
 
+  Vector3 getPoint() const { return point; }
+  Vector3 getNormal() const { return normal; }
+
   virtual void calculateBoundingBox() override;
   virtual bool intersects(Ray &r, Intersection &intersection, CullingType culling) override;
+  virtual bool occluded(Ray &r, double maxDistance) override;
 };
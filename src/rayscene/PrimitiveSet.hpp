@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "../raymath/AABB.hpp"
+#include "../raymath/Ray.hpp"
+#include "Intersection.hpp"
+#include "SceneObject.hpp"
+
+/**
+ * Primitives compactes qui ne sont pas des SceneObject
+ *
+ * Une structure d'accélération construite sur un PrimitiveSet ne référence ses
+ * primitives que par leur indice (0 .. size() - 1). Les feuilles passent la
+ * liste de leurs indices en un seul appel: un appel virtuel par feuille au lieu
+ * d'un par primitive, et une boucle que l'implémentation peut dérouler.
+ * Le PrimitiveSet doit survivre à la structure construite dessus.
+ */
+class PrimitiveSet {
+public:
+    virtual ~PrimitiveSet() {}
+
+    /**
+     * Nombre de primitives
+     */
+    virtual size_t size() const = 0;
+
+    /**
+     * Primitives testées ensemble par intersect (largeur SIMD): le SAH compte une
+     * feuille de n primitives comme ceil(n / batchSize()) tests
+     */
+    virtual uint32_t batchSize() const { return 1; }
+
+    /**
+     * Boîte d'une primitive
+     */
+    virtual AABB bounds(uint32_t prim) const = 0;
+
+    /**
+     * Découpe spatiale d'une primitive (voir SceneObject::splitBoundingBox)
+     */
+    virtual void splitBounds(uint32_t prim, const AABB& box, int axis, double position,
+                             AABB& left, AABB& right) const = 0;
+
+    /**
+     * Teste les primitives d'une feuille et garde l'impact le plus proche
+     * @param closestDistanceSquared Distance au carré de closest, négative sans impact
+     */
+    virtual void intersect(const uint32_t* prims, uint32_t count, Ray& ray, CullingType culling,
+                           Intersection& closest, double& closestDistanceSquared) const = 0;
+
+    /**
+     * Requête d'ombre sur les primitives d'une feuille (voir SceneObject::occluded)
+     */
+    virtual bool occluded(const uint32_t* prims, uint32_t count, Ray& ray, double maxDistance) const = 0;
+};
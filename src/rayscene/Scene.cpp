@@ -1,6 +1,14 @@
+#include <algorithm>
 #include <iostream>
+#include <chrono>
 #include "Scene.hpp"
 #include "Intersection.hpp"
+#include "Mesh.hpp"
+#include "Triangle.hpp"
+#include "Sphere.hpp"
+#include "SphereGroup.hpp"
+#include "ScenePrimitives.hpp"
+#include "Parallel.hpp"
 
 Scene::Scene()
 {
@@ -20,11 +28,39 @@ Scene::~Scene()
   {
     delete lights[i];
   }
+
+  releaseFlatObjects();
 }
 
 void Scene::add(SceneObject *object)
 {
   objects.push_back(object);
+  if (accel && !treeDirty && !flattenMeshes && !packSpheres && !typedPrimitives)
+  {
+    // Structure déjà construite: insertion incrémentale avec la boîte à jour
+    object->applyTransform();
+    object->calculateBoundingBox();
+    if (accel->insert(object))
+    {
+      return;
+    }
+  }
+  treeDirty = true;
+}
+
+bool Scene::remove(SceneObject *object)
+{
+  auto found = std::find(objects.begin(), objects.end(), object);
+  if (found == objects.end())
+  {
+    return false;
+  }
+  objects.erase(found);
+  if (!accel || treeDirty || flattenMeshes || packSpheres || typedPrimitives || !accel->remove(object))
+  {
+    treeDirty = true;
+  }
+  return true;
 }
 
 void Scene::addLight(Light *light)
@@ -32,118 +68,256 @@ void Scene::addLight(Light *light)
   lights.push_back(light);
 }
 
+/*
+ * OPTIMISATION : Préparation de la scène en parallèle
+ *
+ * CODE AVANT :
+ *   for (int i = 0; i < objectCount; ++i) {
+ *     objects[i]->applyTransform();       // Construit aussi l'arbre des meshes
+ *     objects[i]->calculateBoundingBox();
+ *   }
+ *   bspTree.build(objects, buildStrategy);  // Mono-thread
+ *
+ * CODE APRÈS :
+ *   - Les objets sont répartis entre les threads (chaque objet ne touche que ses données,
+ *     les géométries de mesh partagées se protègent elles-mêmes)
+ *   - BSPTree::build construit les grands sous-arbres et le classement SAH en parallèle
+ *   - La durée est mesurée pour être affichée séparément du rendu
+ *
+ * OPTIMISATION : Refit entre deux rendus
+ *   Si seules les transformations ont changé, l'arbre existant est conservé et
+ *   ses bornes recalculées en O(n) (BSPTree::refit). Il n'est reconstruit que si
+ *   des objets ont été ajoutés, si le constructeur a changé ou si la qualité
+ *   de l'arbre s'est trop dégradée. Les arbres des meshes sont en espace objet:
+ *   une nouvelle transformation ne les touche pas.
+ *
+ * La structure est créée ici selon accelerator (voir Accelerator::create), et
+ * recréée si le type change. La grille et le kd-tree ne savent pas se mettre à
+ * jour (refit renvoie false): ils sont reconstruits à chaque fois.
+ */
 void Scene::prepare()
 {
+  auto begin = std::chrono::high_resolution_clock::now();
+
   // OPTIMISÉ : Éviter appel répété à size() dans la condition de boucle
   const int objectCount = objects.size();
-  for (int i = 0; i < objectCount; ++i)
+  parallelFor(0, objectCount, getThreadCount(), [this](size_t first, size_t last, unsigned int)
   {
-    objects[i]->applyTransform();
-#ifdef USE_AABB
-    objects[i]->calculateBoundingBox();
-#endif
-  }
-  
-#ifdef USE_BSPTREE
-  // Construction de l'arbre BSP pour optimiser les recherches d'intersection
-  // Complexité réduite de O(n) à O(log n) pour chaque rayon
-  bspTree.build(objects);
-#endif
-}
+    for (size_t i = first; i < last; ++i)
+    {
+      objects[i]->applyTransform();
+      objects[i]->calculateBoundingBox();  // O(1) par objet, même si la structure ne s'en sert pas
+    }
+  });
 
-std::vector<Light *> Scene::getLights()
-{
-  return lights;
+  // Maillages aplatis, sphères regroupées: la structure reçoit les triangles et le
+  // groupe au lieu des instances et des sphères
+  if (!flatObjects.empty() && (flatMeshes != flattenMeshes || flatSpheres != packSpheres))
+  {
+    releaseFlatObjects();
+    treeDirty = true;
+  }
+  std::vector<SceneObject *> &structureObjects = flattenMeshes || packSpheres ? flattenObjects() : objects;
+
+  // Primitives par type: la structure est construite sur leurs tableaux, recopiés à chaque prepare()
+  if (typedPrimitives && !typed)
+  {
+    typed.reset(new ScenePrimitives());
+    treeDirty = true;
+  }
+  else if (!typedPrimitives && typed)
+  {
+    typed.reset();
+    treeDirty = true;
+  }
+  if (typed && treeDirty)
+  {
+    typed->assign(structureObjects);
+  }
+  else if (typed)
+  {
+    typed->update();
+  }
+
+  // Structure d'accélération: refit si elle le permet et si seuls les objets ont bougé
+  if (!accel || accel->getType() != accelerator.type)
+  {
+    accel = Accelerator::create(accelerator);
+    treeDirty = true;
+  }
+  const bool sameSettings = accel->configure(accelerator);
+  refitted = !treeDirty && sameSettings && accel->refit();
+  if (!refitted && typed)
+  {
+    accel->build(*typed);
+    treeDirty = false;
+  }
+  else if (!refitted)
+  {
+    accel->build(structureObjects);
+    treeDirty = false;
+  }
+
+  auto end = std::chrono::high_resolution_clock::now();
+  buildTime = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() * 1e-9;
 }
 
 /*
- * OPTIMISATION : Trouver l'intersection la plus proche avec lengthSquared()
- * 
+ * OPTIMISATION : BVH global à un seul niveau (option flattenMeshes)
+ *
  * CODE AVANT :
- *   double closestDistance = -1;
- *   for (...) {
- *     intersection.Distance = (intersection.Position - r.GetPosition()).length();  // sqrt() !
- *     if (closestDistance < 0 || intersection.Distance < closestDistance) {
- *       closestDistance = intersection.Distance;
- *       ...
- *     }
- *   }
- * 
+ *   arbre de la scène -> AABB du Mesh -> Mesh::intersects (virtuel)
+ *     -> rayon en espace objet -> arbre des triangles
+ *   // Les boîtes de meshes qui s'interpénètrent se recouvrent: un rayon y
+ *   // descend dans plusieurs arbres de triangles
+ *
  * CODE APRÈS :
- *   double closestDistanceSquared = -1;  // Stocker au carré
- *   for (...) {
- *     intersection.Distance = (...).lengthSquared();  // PAS de sqrt !
- *     if (...|| intersection.Distance < closestDistanceSquared) {  // Comparer valeurs au carré
- *       ...
- *     }
- *   }
- * 
- * Amélioration : Évite sqrt() pour chaque objet de la scène lors de la recherche de l'intersection la plus proche
- * Note : Pour comparer a < b, on peut comparer a² < b² (équivalent mathématiquement pour valeurs positives)
+ *   Chaque instance est remplacée par des copies de ses triangles en espace monde,
+ *   placées avec les sphères et triangles isolés dans une seule structure: plus de
+ *   second niveau, plus de transformation du rayon, et le constructeur sépare
+ *   les triangles de meshes différents.
+ *   Prix: une copie des triangles par instance (pas d'instanciation). À réserver
+ *   aux scènes statiques; un déplacement d'instance se rattrape par un refit.
+ *
+ * OPTIMISATION : Sphères regroupées (option packSpheres)
+ *
+ * CODE AVANT :
+ *   arbre de la scène -> AABB de chaque Sphere -> Sphere::intersects (virtuel)
+ *
+ * CODE APRÈS :
+ *   Les sphères sont recopiées dans un SphereSet (SoA) avec sa propre structure:
+ *   l'arbre de la scène n'en voit qu'une boîte, les feuilles de l'arbre des
+ *   sphères les testent par 4 (voir SphereSet::intersect).
  */
-bool Scene::closestIntersection(Ray &r, Intersection &closest, CullingType culling)
+std::vector<SceneObject *> &Scene::flattenObjects()
 {
-  Intersection intersection;
-
-  double closestDistanceSquared = -1;  // OPTIMISÉ : Stocker distance au carré
-  Intersection closestInter;
-
-#ifdef USE_BSPTREE
-  // OPTIMISATION BSP TREE : Utiliser l'arbre pour réduire le nombre d'objets à tester
-  // Au lieu de tester tous les objets O(n), on ne teste que ceux dans les AABB intersectés O(log n)
-  std::vector<SceneObject*> candidates;
-  if (!bspTree.intersects(r, candidates)) {
-    closest = closestInter;
-    return false;
-  }
-  
-  const int candidateCount = candidates.size();
-  for (int i = 0; i < candidateCount; ++i)
+  if (treeDirty || flatObjects.empty())
   {
-#ifdef USE_AABB
-    // Double vérification avec AABB individuel (optionnel mais peut aider)
-    if (!candidates[i]->boundingBox.intersects(r))
-    {
-      continue;
-    }
-#endif
-    if (candidates[i]->intersects(r, intersection, culling))
+    // Objets ajoutés: nouvelles copies, la structure devra être reconstruite
+    releaseFlatObjects();
+    std::vector<Sphere *> spheres;
+    for (SceneObject *object : objects)
     {
-      intersection.Distance = (intersection.Position - r.GetPosition()).lengthSquared();
-      if (closestDistanceSquared < 0 || intersection.Distance < closestDistanceSquared)
+      Mesh *mesh = flattenMeshes ? dynamic_cast<Mesh *>(object) : nullptr;
+      Sphere *sphere = packSpheres ? dynamic_cast<Sphere *>(object) : nullptr;
+      if (mesh != nullptr)
       {
-        closestDistanceSquared = intersection.Distance;
-        closestInter = intersection;
+        const size_t first = flatTriangles.size();
+        mesh->createWorldTriangles(flatTriangles);
+        flatOwners.insert(flatOwners.end(), flatTriangles.size() - first, mesh);
+      }
+      else if (sphere != nullptr)
+      {
+        spheres.push_back(sphere);
+      }
+      else
+      {
+        flatObjects.push_back(object);
       }
     }
-  }
-#else
-  // Version sans BSP Tree : tester tous les objets
-  const int objectCount = objects.size();
-  for (int i = 0; i < objectCount; ++i)
-  {
-#ifdef USE_AABB
-    // OPTIMISATION AABB : Vérifier d'abord si le rayon intersecte la bounding box
-    if (!objects[i]->boundingBox.intersects(r))
+    flatObjects.insert(flatObjects.end(), flatTriangles.begin(), flatTriangles.end());
+    if (!spheres.empty())
     {
-      continue;
+      sphereGroup = new SphereGroup();
+      sphereGroup->setSpheres(spheres);
+      flatObjects.push_back(sphereGroup);
     }
-#endif
-    if (objects[i]->intersects(r, intersection, culling))
+    flatMeshes = flattenMeshes;
+    flatSpheres = packSpheres;
+    treeDirty = true;
+  }
+
+  // Transformation courante de chaque instance (mêmes copies: refit possible)
+  const size_t triangleCount = flatTriangles.size();
+  parallelFor(0, triangleCount, getThreadCount(), [this](size_t first, size_t last, unsigned int)
+  {
+    for (size_t i = first; i < last; ++i)
     {
-      // OPTIMISÉ : Utiliser lengthSquared() au lieu de length()
-      intersection.Distance = (intersection.Position - r.GetPosition()).lengthSquared();
-      if (closestDistanceSquared < 0 || intersection.Distance < closestDistanceSquared)
-      {
-        closestDistanceSquared = intersection.Distance;
-        closestInter = intersection;
-      }
+      flatTriangles[i]->transform = flatOwners[i]->transform;
+      flatTriangles[i]->material = flatOwners[i]->material;
+      flatTriangles[i]->applyTransform();
+      flatTriangles[i]->calculateBoundingBox();
     }
+  });
+
+  // Sphères déjà transformées par prepare(): le groupe recopie leurs centres et met sa structure à jour
+  if (sphereGroup != nullptr)
+  {
+    sphereGroup->accelerator = accelerator;
+    sphereGroup->applyTransform();
+    sphereGroup->calculateBoundingBox();
   }
-#endif
+  return flatObjects;
+}
 
-  closest = closestInter;
-  return (closestDistanceSquared > -1);
+void Scene::releaseFlatObjects()
+{
+  for (Triangle *triangle : flatTriangles)
+  {
+    delete triangle;
+  }
+  delete sphereGroup;
+  sphereGroup = nullptr;
+  flatTriangles.clear();
+  flatOwners.clear();
+  flatObjects.clear();
+}
+
+std::vector<Light *> Scene::getLights()
+{
+  return lights;
+}
+
+/*
+ * OPTIMISATION : Structure d'accélération choisie à l'exécution
+ *
+ * CODE AVANT :
+ *   #ifdef USE_BSPTREE
+ *     bspTree.closestIntersection(r, closestInter, culling);
+ *   #else
+ *     for (...) {           // Tous les objets
+ *   #ifdef USE_AABB
+ *       if (!objects[i]->boundingBox.intersects(r)) continue;
+ *   #endif
+ *       ...
+ *     }
+ *   #endif
+ *   // Comparer deux structures = recompiler
+ *
+ * CODE APRÈS :
+ *   return accel->closestIntersection(r, closest, culling);
+ *   // Test linéaire (avec ou sans AABB), BVH, grille ou kd-tree derrière la même interface,
+ *   // choisis par la clé "accelerator" de la scène. Un seul appel virtuel par rayon.
+ */
+bool Scene::closestIntersection(Ray &r, Intersection &closest, CullingType culling)
+{
+  if (!accel)
+  {
+    return false;  // prepare() pas encore appelé
+  }
+  return accel->closestIntersection(r, closest, culling);
+}
+
+/*
+ * OPTIMISATION : Requête d'ombre dédiée (any-hit)
+ *
+ * CODE AVANT :
+ *   Intersection shadowInter;
+ *   if (!scene->closestIntersection(lightRay, shadowInter, CULLING_BACK)) { ... }
+ *   // Cherche l'occultant le plus proche, remplit une Intersection complète,
+ *   // et compte aussi les objets situés derrière la lumière !
+ *
+ * CODE APRÈS :
+ *   if (!scene->occluded(lightRay, lightDistance)) { ... }
+ *   // Sortie au premier objet qui bloque le rayon avant la lumière
+ */
+bool Scene::occluded(Ray &r, double maxDistance)
+{
+  if (maxDistance <= 0 || !accel)
+  {
+    return false;
+  }
+  return accel->occluded(r, maxDistance);
 }
 
 Color Scene::raycast(Ray &r, Ray &camera, int castCount, int maxCastCount)
@@ -1,35 +1,95 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 #include "../raymath/Ray.hpp"
 #include "../raymath/Color.hpp"
 #include "Light.hpp"
 #include "SceneObject.hpp"
-#ifdef USE_BSPTREE
-#include "BSPTree.hpp"
-#endif
+#include "Accelerator.hpp"
+
+class Mesh;
+class Triangle;
+class SphereGroup;
+class ScenePrimitives;
 
 class Scene
 {
 private:
   std::vector<SceneObject *> objects;
   std::vector<Light *> lights;
-#ifdef USE_BSPTREE
-  BSPTree bspTree;  // Arbre BSP pour optimisation des intersections
-#endif
+  std::unique_ptr<Accelerator> accel;  // Structure des requêtes, créée par prepare() selon accelerator
+  bool treeDirty = true;  // Objets ajoutés depuis la dernière construction: refit impossible
+
+  // Maillages aplatis (flattenMeshes): copies monde des triangles, leur instance, et la
+  // liste passée à la structure (objets hors meshes + copies, groupe de sphères)
+  std::vector<Triangle *> flatTriangles;
+  std::vector<Mesh *> flatOwners;
+  std::vector<SceneObject *> flatObjects;
+  SphereGroup *sphereGroup = nullptr;  // Sphères regroupées (packSpheres), nullptr sans sphère
+  bool flatMeshes = false;   // Options avec lesquelles flatObjects a été construite
+  bool flatSpheres = false;
+  std::unique_ptr<ScenePrimitives> typed;  // Objets rangés par type (typedPrimitives), nullptr sinon
+
+  /**
+   * Met à jour les copies des triangles et le groupe de sphères (recréés si les objets ont changé)
+   * @return liste des objets à placer dans la structure
+   */
+  std::vector<SceneObject *> &flattenObjects();
+  void releaseFlatObjects();
 
 public:
   Scene();
   ~Scene();
 
   Color globalAmbient;
+  AcceleratorSettings accelerator;  // Structure interrogée par les rayons et ses réglages
+  bool flattenMeshes = false;       // Triangles des meshes dans la structure de la scène (un seul niveau, sans instanciation)
+  bool packSpheres = false;         // Sphères regroupées dans un SphereSet avec sa propre structure (tests SIMD)
+  bool typedPrimitives = false;     // Structure construite sur des tableaux par type (ScenePrimitives), sans appel virtuel
+  double buildTime = 0;  // Durée du dernier prepare() en secondes (transformations, AABB, arbres)
+  bool refitted = false; // Le dernier prepare() a mis à jour l'arbre existant au lieu de le reconstruire
 
+  /**
+   * Ajoute un objet (la scène en devient propriétaire). Après un premier prepare(),
+   * il est inséré directement dans la structure si elle le permet (BVH, test
+   * linéaire): pas de reconstruction au prochain prepare(), un simple refit.
+   */
   void add(SceneObject *object);
+
+  /**
+   * Retire un objet de la scène, et de la structure si elle le permet (sinon elle
+   * sera reconstruite au prochain prepare()). L'objet n'est pas détruit: l'appelant
+   * en redevient propriétaire.
+   * @return false si l'objet n'est pas dans la scène
+   */
+  bool remove(SceneObject *object);
   void addLight(Light *light);
   std::vector<Light *> getLights();
+  const std::vector<SceneObject *> &getObjects() const { return objects; }
+
+  /**
+   * Structure construite par le dernier prepare() (nullptr avant)
+   */
+  const Accelerator *getAccelerator() const { return accel.get(); }
+
+  /**
+   * Groupe des sphères construit par le dernier prepare() (nullptr sans packSpheres)
+   */
+  const SphereGroup *getSphereGroup() const { return sphereGroup; }
+
+  /**
+   * Primitives par type du dernier prepare() (nullptr sans typedPrimitives)
+   */
+  const ScenePrimitives *getTypedPrimitives() const { return typed.get(); }
 
   void prepare();
   Color raycast(Ray &r, Ray &camera, int castCount, int maxCastCount);
 
   bool closestIntersection(Ray &r, Intersection &closest, CullingType culling);
+
+  /**
+   * Requête d'ombre: vrai dès qu'un objet bloque le rayon avant maxDistance
+   */
+  bool occluded(Ray &r, double maxDistance);
 };
@@ -1,6 +1,9 @@
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <map>
+#include <memory>
+#include <stdexcept>
 #include "../json/json.hpp"
 #include "SceneLoader.hpp"
 #include "Sphere.hpp"
@@ -189,10 +192,104 @@ Triangle *parseTriangle(json data)
     return triangle;
 }
 
-Mesh *parseMesh(json data, std::filesystem::path &sceneParentPath)
+AcceleratorType parseAccelerator(json data, std::string key, AcceleratorType fallback)
+{
+    if (data.contains(key))
+    {
+        std::string name = data[key];
+        AcceleratorType type = fallback;
+        if (!parseAcceleratorName(name, type))
+        {
+            std::cerr << "unknown " << key << " \"" << name << "\", falling back to " << acceleratorName(fallback) << std::endl;
+        }
+        return type;
+    }
+    return fallback;
+}
+
+BSPBuildStrategy parseBuildStrategy(json data)
+{
+    if (data.contains("builder"))
+    {
+        std::string builder = data["builder"];
+        BSPBuildStrategy strategy = BUILD_SAH;
+        if (!parseBuilderName(builder, strategy))
+        {
+            std::cerr << "unknown builder \"" << builder << "\", falling back to sah" << std::endl;
+        }
+        return strategy;
+    }
+    return BUILD_SAH;
+}
+
+int parseBvhWidth(json data)
+{
+    if (data.contains("bvhWidth"))
+    {
+        int width = data["bvhWidth"];
+        if (width == 2 || width == 4 || width == 8)
+        {
+            return width;
+        }
+        std::cerr << "unsupported bvhWidth " << width << ", falling back to " << BSP_DEFAULT_WIDTH << std::endl;
+    }
+    return BSP_DEFAULT_WIDTH;
+}
+
+int parseBvhQuantization(json data)
+{
+    if (data.contains("bvhQuantization"))
+    {
+        int bits = data["bvhQuantization"];
+        if (bits == 0 || bits == 8 || bits == 16)
+        {
+            return bits;
+        }
+        std::cerr << "unsupported bvhQuantization " << bits << ", falling back to float bounds" << std::endl;
+    }
+    return 0;
+}
+
+/**
+ * Structure de la scène: clés "accelerator", "builder", "bvhWidth" et "bvhQuantization"
+ */
+AcceleratorSettings parseAcceleratorSettings(json data)
+{
+    AcceleratorSettings settings;
+    settings.type = parseAccelerator(data, "accelerator", AcceleratorSettings::defaultType());
+    settings.builder = parseBuildStrategy(data);
+    settings.bvhWidth = parseBvhWidth(data);
+    settings.bvhQuantization = parseBvhQuantization(data);
+    return settings;
+}
+
+/**
+ * Structure des triangles des meshes: mêmes réglages que la scène, type donné par
+ * "meshAccelerator". Par défaut un BVH, sauf si la scène n'en utilise aucun
+ * (comparaisons sans structure) : grille et kd-tree visent les nuages d'objets.
+ */
+AcceleratorSettings parseMeshAcceleratorSettings(json sceneData)
+{
+    AcceleratorSettings settings = parseAcceleratorSettings(sceneData);
+    const bool linear = settings.type == ACCELERATOR_NONE || settings.type == ACCELERATOR_AABB;
+    settings.type = parseAccelerator(sceneData, "meshAccelerator", linear ? settings.type : ACCELERATOR_BVH);
+    // En SAH la taille des feuilles découle du coût; 15/4 ne sert qu'au découpage médian
+    settings.maxDepth = 15;
+    settings.minObjects = 4;
+    return settings;
+}
+
+/**
+ * Géométries déjà chargées, indexées par chemin du fichier .obj :
+ * N instances d'un même mesh partagent un seul jeu de triangles et une seule structure
+ */
+typedef std::map<std::string, std::shared_ptr<MeshGeometry>> GeometryCache;
+
+Mesh *parseMesh(json data, std::filesystem::path &sceneParentPath, json &sceneData, GeometryCache &geometries)
 {
 
     Mesh *mesh = new Mesh();
+    mesh->accelerator = parseMeshAcceleratorSettings(sceneData);
     Vector3 pos;
     Vector3 rot;
 
@@ -213,14 +310,26 @@ Mesh *parseMesh(json data, std::filesystem::path &sceneParentPath)
         std::string relPath = data["obj"];
         std::filesystem::path fullPath = sceneParentPath / relPath;
 
-        std::ifstream f(fullPath);
-        if (!f.good())
+        std::string key = fullPath.lexically_normal().string();
+        auto cached = geometries.find(key);
+        if (cached != geometries.end())
         {
-            std::cerr << "obj file not found at path: " << fullPath << std::endl;
-            exit(1);
+            mesh->setGeometry(cached->second);
+        }
+        else
+        {
+            std::ifstream f(fullPath);
+            if (!f.good())
+            {
+                std::cerr << "obj file not found at path: " << fullPath << std::endl;
+                exit(1);
+            }
+
+            std::shared_ptr<MeshGeometry> geometry = std::make_shared<MeshGeometry>();
+            geometry->loadFromObj(fullPath);
+            geometries[key] = geometry;
+            mesh->setGeometry(geometry);
         }
-
-        mesh->loadFromObj(fullPath);
     }
 
     if (data.contains("material"))
@@ -242,6 +351,8 @@ void parseOjects(json data, Scene *scene, std::filesystem::path &sceneParentPath
         return;
     }
 
+    GeometryCache geometries;
+
     for (auto &elem : data["objects"])
     {
         std::string type = elem["type"];
@@ -262,7 +373,7 @@ void parseOjects(json data, Scene *scene, std::filesystem::path &sceneParentPath
         }
         else if (type == "mesh")
         {
-            Mesh *m = parseMesh(elem, sceneParentPath);
+            Mesh *m = parseMesh(elem, sceneParentPath, data, geometries);
             scene->add(m);
         }
     }
@@ -330,6 +441,26 @@ Image *parseImage(json data, Image *image)
 }
 
 std::tuple<Scene *, Camera *, Image *> SceneLoader::Load(std::string path)
+{
+    return Load(path, std::map<std::string, std::string>());
+}
+
+std::tuple<Scene *, Camera *, Image *> SceneLoader::Load(std::string path, std::string builder)
+{
+    std::map<std::string, std::string> overrides;
+    AcceleratorType type;
+    if (parseAcceleratorName(builder, type))
+    {
+        overrides["accelerator"] = builder;
+    }
+    else if (!builder.empty())
+    {
+        overrides["builder"] = builder;
+    }
+    return Load(path, overrides);
+}
+
+std::tuple<Scene *, Camera *, Image *> SceneLoader::Load(std::string path, std::map<std::string, std::string> overrides)
 {
     std::ifstream f(path);
 
@@ -344,6 +475,37 @@ std::tuple<Scene *, Camera *, Image *> SceneLoader::Load(std::string path)
     std::filesystem::path parent_p = fPath.parent_path();
 
     json data = json::parse(f);
+    for (const auto &[key, value] : overrides)
+    {
+        if (key == "bvhWidth" || key == "bvhQuantization")
+        {
+            // Entier complet: "four" ou "4x" sont refusés au lieu d'arrêter le programme
+            size_t parsed = 0;
+            int number = 0;
+            try
+            {
+                number = std::stoi(value, &parsed);
+            }
+            catch (const std::exception &)
+            {
+                parsed = 0;
+            }
+            if (parsed == 0 || parsed != value.size())
+            {
+                std::cerr << "[ERROR] Invalid integer for " << key << ": " << value << std::endl;
+                exit(1);
+            }
+            data[key] = number;
+        }
+        else if (key == "flattenMeshes" || key == "packSpheres" || key == "typedPrimitives")
+        {
+            data[key] = value == "true" || value == "1";
+        }
+        else
+        {
+            data[key] = value;
+        }
+    }
 
     Scene *scene = new Scene();
     Camera *camera = new Camera();
@@ -361,6 +523,20 @@ std::tuple<Scene *, Camera *, Image *> SceneLoader::Load(std::string path)
         camera->Reflections = data["reflections"];
     }
 
+    scene->accelerator = parseAcceleratorSettings(data);
+    if (data.contains("flattenMeshes"))
+    {
+        scene->flattenMeshes = data["flattenMeshes"];
+    }
+    if (data.contains("packSpheres"))
+    {
+        scene->packSpheres = data["packSpheres"];
+    }
+    if (data.contains("typedPrimitives"))
+    {
+        scene->typedPrimitives = data["typedPrimitives"];
+    }
+
     Image *image = parseImage(data, image);
 
     return {scene, camera, image};
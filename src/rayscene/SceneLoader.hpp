@@ -1,5 +1,7 @@
 #pragma once
 
+#include <map>
+#include <string>
 #include <tuple>
 #include "Scene.hpp"
 #include "Camera.hpp"
@@ -9,4 +11,19 @@ class SceneLoader
 {
 public:
     static std::tuple<Scene *, Camera *, Image *> Load(std::string path);
+
+    /**
+     * Charge la scène en remplaçant le constructeur d'arbre du fichier (clé "builder")
+     * Sert à comparer les constructeurs sur une même scène.
+     * Un nom de structure ("none", "aabb", "bvh", "grid", "kdtree") remplace
+     * la clé "accelerator" à la place.
+     */
+    static std::tuple<Scene *, Camera *, Image *> Load(std::string path, std::string builder);
+
+    /**
+     * Charge la scène en remplaçant des clés de premier niveau du fichier
+     * ("accelerator", "meshAccelerator", "builder", "bvhWidth", "bvhQuantization",
+     * "flattenMeshes", "packSpheres", "typedPrimitives"...)
+     */
+    static std::tuple<Scene *, Camera *, Image *> Load(std::string path, std::map<std::string, std::string> overrides);
 };
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <limits>
 #include "SceneObject.hpp"
 #include "Intersection.hpp"
 
@@ -15,6 +16,24 @@ bool SceneObject::intersects(Ray &r, Intersection &intersection, CullingType cul
   return false;
 }
 
+bool SceneObject::occluded(Ray &r, double maxDistance)
+{
+  // Implémentation générique: impact complet puis comparaison de distance
+  Intersection intersection;
+  if (!this->intersects(r, intersection, CULLING_BACK))
+  {
+    return false;
+  }
+  return (intersection.Position - r.GetPosition()).lengthSquared() < maxDistance * maxDistance;
+}
+
+void SceneObject::splitBoundingBox(AABB const &box, int axis, double position, AABB &left, AABB &right)
+{
+  const AABB part = boundingBox.intersection(box);
+  left = part.slice(axis, -std::numeric_limits<double>::infinity(), position);
+  right = part.slice(axis, position, std::numeric_limits<double>::infinity());
+}
+
 void SceneObject::applyTransform()
 {
 }
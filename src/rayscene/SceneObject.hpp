@@ -27,4 +27,20 @@ public:
   virtual void applyTransform();
   virtual void calculateBoundingBox();
   virtual bool intersects(Ray &r, Intersection &intersection, CullingType culling);
+
+  /**
+   * Requête d'ombre: vrai dès que l'objet bloque le rayon avant maxDistance.
+   * Comme l'ancien test d'ombre, les faces tournées vers le rayon sont ignorées (CULLING_BACK).
+   * N'a pas besoin de remplir d'Intersection: chaque primitive peut sortir au plus tôt.
+   */
+  virtual bool occluded(Ray &r, double maxDistance);
+
+  /**
+   * Découpe spatiale du BVH: boîtes des parties de l'objet contenues dans box, de part
+   * et d'autre du plan axis = position (axis: 0 = x, 1 = y, 2 = z).
+   * L'implémentation générique coupe box elle-même, ce qui reste conservatif; les
+   * primitives qui savent se découper renvoient des boîtes plus serrées.
+   * Une partie peut être vide (AABB::isEmpty) si l'objet ne touche pas ce côté.
+   */
+  virtual void splitBoundingBox(AABB const &box, int axis, double position, AABB &left, AABB &right);
 };
@@ -0,0 +1,301 @@
+#include <cmath>
+#include <limits>
+#include "ScenePrimitives.hpp"
+#include "Parallel.hpp"
+#include "Plane.hpp"
+#include "Sphere.hpp"
+#include "Triangle.hpp"
+#include "TriangleKernel.hpp"
+
+void ScenePrimitives::assign(const std::vector<SceneObject*>& list) {
+    sphereSources.clear();
+    triangleSources.clear();
+    planeSources.clear();
+    objects.clear();
+    for (SceneObject* object : list) {
+        if (Sphere* sphere = dynamic_cast<Sphere*>(object)) {
+            sphereSources.push_back(sphere);
+        } else if (Triangle* triangle = dynamic_cast<Triangle*>(object)) {
+            triangleSources.push_back(triangle);
+        } else if (Plane* plane = dynamic_cast<Plane*>(object)) {
+            planeSources.push_back(plane);
+        } else {
+            objects.push_back(object);
+        }
+    }
+
+    spheres.clear();
+    spheres.reserve(sphereSources.size());
+    for (Sphere* sphere : sphereSources) {
+        spheres.add(sphere->getCenter(), sphere->getRadius(), sphere->material);
+    }
+    triangles.assign(triangleSources.size(), TrianglePrimitive());
+    planes.assign(planeSources.size(), PlanePrimitive());
+    triangleBegin = static_cast<uint32_t>(sphereSources.size());
+    planeBegin = triangleBegin + static_cast<uint32_t>(triangleSources.size());
+    objectBegin = planeBegin + static_cast<uint32_t>(planeSources.size());
+    update();
+}
+
+void ScenePrimitives::update() {
+    const uint32_t sphereTotal = static_cast<uint32_t>(sphereSources.size());
+    for (uint32_t i = 0; i < sphereTotal; ++i) {
+        spheres.set(i, sphereSources[i]->getCenter(), sphereSources[i]->getRadius(), sphereSources[i]->material);
+    }
+
+    // Les meshes aplatis peuvent fournir des centaines de milliers de triangles
+    parallelFor(0, triangleSources.size(), getThreadCount(), [this](size_t first, size_t last, unsigned int) {
+        for (size_t i = first; i < last; ++i) {
+            TrianglePrimitive& triangle = triangles[i];
+            triangleSources[i]->getWorldCorners(triangle.a, triangle.b, triangle.c);
+            triangle.normal = triangleSources[i]->getNormal();
+            triangle.material = triangleSources[i]->material;
+        }
+    });
+
+    for (size_t i = 0; i < planeSources.size(); ++i) {
+        planes[i].point = planeSources[i]->getPoint();
+        planes[i].normal = planeSources[i]->getNormal();
+        planes[i].material = planeSources[i]->material;
+    }
+}
+
+size_t ScenePrimitives::memoryBytes() const {
+    return spheres.memoryBytes() + triangles.capacity() * sizeof(TrianglePrimitive) +
+           planes.capacity() * sizeof(PlanePrimitive) + objects.capacity() * sizeof(SceneObject*);
+}
+
+AABB ScenePrimitives::bounds(uint32_t prim) const {
+    switch (kindOf(prim)) {
+        case KIND_SPHERE:
+            return spheres.bounds(prim);
+        case KIND_TRIANGLE: {
+            const TrianglePrimitive& triangle = triangles[prim - triangleBegin];
+            return Triangle::cornerBounds(triangle.a, triangle.b, triangle.c);
+        }
+        case KIND_PLANE: {
+            // Comme Plane::calculateBoundingBox: non borné, hors de l'arbre
+            const double inf = std::numeric_limits<double>::infinity();
+            return AABB(Vector3(-inf, -inf, -inf), Vector3(inf, inf, inf));
+        }
+        default:
+            return objects[prim - objectBegin]->boundingBox;
+    }
+}
+
+void ScenePrimitives::splitBounds(uint32_t prim, const AABB& box, int axis, double position,
+                                  AABB& left, AABB& right) const {
+    switch (kindOf(prim)) {
+        case KIND_SPHERE:
+            spheres.splitBounds(prim, box, axis, position, left, right);
+            break;
+        case KIND_TRIANGLE: {
+            const TrianglePrimitive& triangle = triangles[prim - triangleBegin];
+            Triangle::splitCorners(triangle.a, triangle.b, triangle.c, box, axis, position, left, right);
+            break;
+        }
+        case KIND_PLANE: {
+            const AABB part = bounds(prim).intersection(box);
+            left = part.slice(axis, -std::numeric_limits<double>::infinity(), position);
+            right = part.slice(axis, position, std::numeric_limits<double>::infinity());
+            break;
+        }
+        default:
+            objects[prim - objectBegin]->splitBoundingBox(box, axis, position, left, right);
+            break;
+    }
+}
+
+/*
+ * OPTIMISATION : Primitives rangées par type, noyaux appelés directement
+ *
+ * CODE AVANT :
+ *   for (...) {
+ *     SceneObject* obj = objects[indices[i]];      // Sphère, triangle, plan ou mesh mélangés
+ *     if (!obj->boundingBox.intersects(ray)) continue;
+ *     obj->intersects(ray, intersection, culling); // Appel virtuel par objet: pas d'inlining,
+ *   }                                              // branchement indirect imprévisible
+ *
+ * CODE APRÈS :
+ *   - Un appel virtuel par feuille; ses indices sont triés, donc regroupés par type
+ *   - Chaque plage d'un même type va à son noyau (SphereSet par 4, test étanche des
+ *     triangles, plans), appelé directement: boucle sans branchement indirect
+ *   - Position et normale une seule fois par plage, pour l'impact retenu
+ *   - Seuls les objets composites (meshes instanciés) passent encore par la vtable
+ */
+void ScenePrimitives::intersect(const uint32_t* prims, uint32_t count, Ray& ray, CullingType culling,
+                                Intersection& closest, double& closestDistanceSquared) const {
+    uint32_t first = 0;
+    while (first < count) {
+        const PrimitiveKind kind = kindOf(prims[first]);
+        uint32_t last = first + 1;
+        while (last < count && kindOf(prims[last]) == kind) {
+            ++last;
+        }
+        switch (kind) {
+            case KIND_SPHERE:
+                spheres.intersect(prims + first, last - first, ray, culling, closest, closestDistanceSquared);
+                break;
+            case KIND_TRIANGLE:
+                intersectTriangles(prims + first, last - first, ray, culling, closest, closestDistanceSquared);
+                break;
+            case KIND_PLANE:
+                intersectPlanes(prims + first, last - first, ray, closest, closestDistanceSquared);
+                break;
+            default:
+                intersectObjects(prims + first, last - first, ray, culling, closest, closestDistanceSquared);
+                break;
+        }
+        first = last;
+    }
+}
+
+bool ScenePrimitives::occluded(const uint32_t* prims, uint32_t count, Ray& ray, double maxDistance) const {
+    uint32_t first = 0;
+    while (first < count) {
+        const PrimitiveKind kind = kindOf(prims[first]);
+        uint32_t last = first + 1;
+        while (last < count && kindOf(prims[last]) == kind) {
+            ++last;
+        }
+        bool blocked;
+        switch (kind) {
+            case KIND_SPHERE:
+                blocked = spheres.occluded(prims + first, last - first, ray, maxDistance);
+                break;
+            case KIND_TRIANGLE:
+                blocked = occludedTriangles(prims + first, last - first, ray, maxDistance);
+                break;
+            case KIND_PLANE:
+                blocked = occludedPlanes(prims + first, last - first, ray, maxDistance);
+                break;
+            default:
+                blocked = occludedObjects(prims + first, last - first, ray, maxDistance);
+                break;
+        }
+        if (blocked) {
+            return true;
+        }
+        first = last;
+    }
+    return false;
+}
+
+void ScenePrimitives::intersectTriangles(const uint32_t* prims, uint32_t count, Ray& ray, CullingType culling,
+                                         Intersection& closest, double& closestDistanceSquared) const {
+    // Même boucle que TriangleMesh::intersect, sur des sommets déjà en espace monde
+    const Vector3 o = ray.GetPosition();
+    const Vector3 d = ray.GetDirection();
+    const TriangleRay prepared(o, d);
+
+    double tMax = closestDistanceSquared < 0 ? std::numeric_limits<double>::infinity() : std::sqrt(closestDistanceSquared);
+    const TrianglePrimitive* best = nullptr;
+    TriangleHit hit;
+    for (uint32_t i = 0; i < count; ++i) {
+        const TrianglePrimitive& triangle = triangles[prims[i] - triangleBegin];
+        if (intersectTriangle(prepared, triangle.a, triangle.b, triangle.c, culling, tMax, hit)) {
+            tMax = hit.t;
+            best = &triangle;
+        }
+    }
+    if (best == nullptr) {
+        return;
+    }
+
+    Intersection intersection;
+    intersection.Position = Vector3(o.x + d.x * tMax, o.y + d.y * tMax, o.z + d.z * tMax);
+    intersection.Normal = best->normal;
+    intersection.Mat = best->material;
+    intersection.Distance = tMax * tMax;
+    closestDistanceSquared = tMax * tMax;
+    closest = intersection;
+}
+
+void ScenePrimitives::intersectPlanes(const uint32_t* prims, uint32_t count, Ray& ray,
+                                      Intersection& closest, double& closestDistanceSquared) const {
+    // Mêmes calculs (en float) que Plane::intersects, puis même classement que BSPTree
+    const Vector3 o = ray.GetPosition();
+    const Vector3 d = ray.GetDirection();
+    for (uint32_t i = 0; i < count; ++i) {
+        const PlanePrimitive& plane = planes[prims[i] - planeBegin];
+        float denom = d.dot(plane.normal);
+        if (denom > -0.000001) {
+            continue;
+        }
+        float numer = (plane.point - o).dot(plane.normal);
+        float t = numer / denom;
+
+        const Vector3 position = o + (d * t);
+        const double distanceSquared = (position - o).lengthSquared();
+        if (closestDistanceSquared < 0 || distanceSquared < closestDistanceSquared) {
+            Intersection intersection;
+            intersection.Position = position;
+            intersection.Normal = plane.normal;
+            intersection.Mat = plane.material;
+            intersection.Distance = distanceSquared;
+            closestDistanceSquared = distanceSquared;
+            closest = intersection;
+        }
+    }
+}
+
+void ScenePrimitives::intersectObjects(const uint32_t* prims, uint32_t count, Ray& ray, CullingType culling,
+                                       Intersection& closest, double& closestDistanceSquared) const {
+    // Objets composites: même test que BSPTree sur des SceneObject
+    Intersection intersection;
+    const Vector3 o = ray.GetPosition();
+    for (uint32_t i = 0; i < count; ++i) {
+        SceneObject* object = objects[prims[i] - objectBegin];
+        if (!object->boundingBox.intersects(ray)) {
+            continue;
+        }
+        if (object->intersects(ray, intersection, culling)) {
+            intersection.Distance = (intersection.Position - o).lengthSquared();
+            if (closestDistanceSquared < 0 || intersection.Distance < closestDistanceSquared) {
+                closestDistanceSquared = intersection.Distance;
+                closest = intersection;
+            }
+        }
+    }
+}
+
+bool ScenePrimitives::occludedTriangles(const uint32_t* prims, uint32_t count, Ray& ray, double maxDistance) const {
+    const TriangleRay prepared(ray.GetPosition(), ray.GetDirection());
+    TriangleHit hit;
+    for (uint32_t i = 0; i < count; ++i) {
+        const TrianglePrimitive& triangle = triangles[prims[i] - triangleBegin];
+        if (intersectTriangle(prepared, triangle.a, triangle.b, triangle.c, CULLING_BACK, maxDistance, hit)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ScenePrimitives::occludedPlanes(const uint32_t* prims, uint32_t count, Ray& ray, double maxDistance) const {
+    // Comme Plane::occluded: seule la face avant du plan arrête un rayon
+    const Vector3 o = ray.GetPosition();
+    const Vector3 d = ray.GetDirection();
+    for (uint32_t i = 0; i < count; ++i) {
+        const PlanePrimitive& plane = planes[prims[i] - planeBegin];
+        float denom = d.dot(plane.normal);
+        if (denom > -0.000001) {
+            continue;
+        }
+        float numer = (plane.point - o).dot(plane.normal);
+        float t = numer / denom;
+        if (t > 0 && t < maxDistance) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ScenePrimitives::occludedObjects(const uint32_t* prims, uint32_t count, Ray& ray, double maxDistance) const {
+    for (uint32_t i = 0; i < count; ++i) {
+        SceneObject* object = objects[prims[i] - objectBegin];
+        if (object->boundingBox.intersects(ray) && object->occluded(ray, maxDistance)) {
+            return true;
+        }
+    }
+    return false;
+}
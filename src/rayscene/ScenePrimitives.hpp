@@ -0,0 +1,109 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "PrimitiveSet.hpp"
+#include "SphereSet.hpp"
+#include "../raymath/Vector3.hpp"
+
+class Sphere;
+class Triangle;
+class Plane;
+
+/**
+ * Objets de la scène rangés par type (Scene::typedPrimitives)
+ *
+ * Sphères, triangles et plans sont recopiés dans un tableau contigu par type;
+ * les autres objets (instances de mesh, groupes...) restent des SceneObject.
+ * Les indices de primitives suivent cet ordre: [sphères | triangles | plans | objets].
+ * Les feuilles d'un BVH construit dessus sont triées par indice (voir
+ * BSPTree::buildTree): chaque type y forme une plage contiguë, testée par son
+ * noyau appelé directement, sans passer par SceneObject::intersects.
+ *
+ * Les objets d'origine restent la propriété de la scène; update() recopie leur
+ * géométrie après applyTransform.
+ */
+class ScenePrimitives : public PrimitiveSet {
+public:
+    /**
+     * Range les objets par type et recopie leur géométrie
+     */
+    void assign(const std::vector<SceneObject*>& objects);
+
+    /**
+     * Recopie la géométrie courante des mêmes objets (transformations et matériaux)
+     */
+    void update();
+
+    size_t sphereCount() const { return spheres.size(); }
+    size_t triangleCount() const { return triangles.size(); }
+    size_t planeCount() const { return planes.size(); }
+    size_t objectCount() const { return objects.size(); }
+
+    /**
+     * Octets occupés par les tableaux des sphères, triangles et plans
+     */
+    size_t memoryBytes() const;
+
+    size_t size() const override { return objectBegin + objects.size(); }
+    AABB bounds(uint32_t prim) const override;
+    void splitBounds(uint32_t prim, const AABB& box, int axis, double position,
+                     AABB& left, AABB& right) const override;
+    void intersect(const uint32_t* prims, uint32_t count, Ray& ray, CullingType culling,
+                   Intersection& closest, double& closestDistanceSquared) const override;
+    bool occluded(const uint32_t* prims, uint32_t count, Ray& ray, double maxDistance) const override;
+
+private:
+    enum PrimitiveKind {
+        KIND_SPHERE,
+        KIND_TRIANGLE,
+        KIND_PLANE,
+        KIND_OBJECT
+    };
+
+    struct TrianglePrimitive {
+        Vector3 a, b, c;  // Sommets en espace monde
+        Vector3 normal;
+        Material* material;
+    };
+
+    struct PlanePrimitive {
+        Vector3 point;
+        Vector3 normal;
+        Material* material;
+    };
+
+    SphereSet spheres;
+    std::vector<TrianglePrimitive> triangles;
+    std::vector<PlanePrimitive> planes;
+    std::vector<SceneObject*> objects;  // Autres objets, appels virtuels
+
+    // Objets d'origine, même ordre que les tableaux
+    std::vector<Sphere*> sphereSources;
+    std::vector<Triangle*> triangleSources;
+    std::vector<Plane*> planeSources;
+
+    // Premier indice de chaque type (les sphères commencent à 0)
+    uint32_t triangleBegin = 0;
+    uint32_t planeBegin = 0;
+    uint32_t objectBegin = 0;
+
+    PrimitiveKind kindOf(uint32_t prim) const {
+        return prim < triangleBegin ? KIND_SPHERE
+             : prim < planeBegin ? KIND_TRIANGLE
+             : prim < objectBegin ? KIND_PLANE
+             : KIND_OBJECT;
+    }
+
+    /**
+     * Noyaux par type, sur une plage d'indices du même type
+     */
+    void intersectTriangles(const uint32_t* prims, uint32_t count, Ray& ray, CullingType culling,
+                            Intersection& closest, double& closestDistanceSquared) const;
+    void intersectPlanes(const uint32_t* prims, uint32_t count, Ray& ray,
+                         Intersection& closest, double& closestDistanceSquared) const;
+    void intersectObjects(const uint32_t* prims, uint32_t count, Ray& ray, CullingType culling,
+                          Intersection& closest, double& closestDistanceSquared) const;
+    bool occludedTriangles(const uint32_t* prims, uint32_t count, Ray& ray, double maxDistance) const;
+    bool occludedPlanes(const uint32_t* prims, uint32_t count, Ray& ray, double maxDistance) const;
+    bool occludedObjects(const uint32_t* prims, uint32_t count, Ray& ray, double maxDistance) const;
+};
@@ -0,0 +1,125 @@
+#include <map>
+#include "../json/json.hpp"
+#include "SceneStats.hpp"
+#include "BSPTree.hpp"
+#include "KdTree.hpp"
+#include "Mesh.hpp"
+#include "ScenePrimitives.hpp"
+#include "SphereGroup.hpp"
+#include "UniformGrid.hpp"
+
+using json = nlohmann::ordered_json;
+
+static json bvhStats(const BSPTree& tree) {
+    const BSPTreeStats stats = tree.computeStats();
+    json out;
+    out["builder"] = builderName(tree.getBuildStrategy());
+    out["width"] = tree.getWidth();
+    out["quantizationBits"] = tree.getQuantizationBits();
+    out["primitives"] = stats.memory.primitiveCount;
+    out["unbounded"] = stats.unboundedCount;
+
+    // En format compressé, l'arbre binaire n'existe plus: mémoire seule
+    if (stats.hasBinaryTree) {
+        out["nodes"] = stats.nodeCount;
+        out["leaves"] = stats.leafCount;
+        out["references"] = stats.referenceCount;
+        out["maxDepth"] = stats.maxDepth;
+        out["averageLeafDepth"] = stats.averageLeafDepth;
+        out["averageLeafSize"] = stats.leafCount > 0 ? static_cast<double>(stats.referenceCount) / stats.leafCount : 0.0;
+
+        json histogram = json::object();
+        for (int size = 0; size <= BSP_STATS_MAX_LEAF_SIZE; ++size) {
+            std::string key = std::to_string(size);
+            if (size == BSP_STATS_MAX_LEAF_SIZE) {
+                key += "+";
+            }
+            histogram[key] = stats.leafSizes[size];
+        }
+        out["leafOccupancy"] = histogram;
+        out["sahCost"] = stats.sahCost;
+        out["siblingOverlap"] = {{"average", stats.averageSiblingOverlap}, {"max", stats.maxSiblingOverlap}};
+    }
+
+    const BSPMemoryStats& memory = stats.memory;
+    out["memory"] = {
+        {"traversalNodes", memory.traversalNodeCount},
+        {"traversalNodeSize", memory.traversalNodeSize},
+        {"binaryNodeBytes", memory.binaryNodeBytes},
+        {"traversalNodeBytes", memory.traversalNodeBytes},
+        {"primIndexBytes", memory.primIndexBytes},
+        {"totalBytes", memory.totalBytes()}};
+    return out;
+}
+
+static json acceleratorStats(const Accelerator* accelerator) {
+    if (accelerator == nullptr) {
+        return nullptr;  // Pas encore construite
+    }
+
+    json out;
+    out["type"] = acceleratorName(accelerator->getType());
+    if (const BSPTree* tree = dynamic_cast<const BSPTree*>(accelerator)) {
+        out.update(bvhStats(*tree));
+    } else if (const KdTree* kd = dynamic_cast<const KdTree*>(accelerator)) {
+        out["nodes"] = kd->getNodeCount();
+        out["leaves"] = kd->getLeafCount();
+        out["references"] = kd->getReferenceCount();
+    } else if (const UniformGrid* grid = dynamic_cast<const UniformGrid*>(accelerator)) {
+        out["resolution"] = {grid->getResolution(0), grid->getResolution(1), grid->getResolution(2)};
+    }
+    return out;
+}
+
+std::string SceneStats::toJson(const Scene& scene, int indent) {
+    json out;
+    out["objects"] = scene.getObjects().size();
+    out["buildTime"] = scene.buildTime;
+    out["flattenMeshes"] = scene.flattenMeshes;
+    out["packSpheres"] = scene.packSpheres;
+    out["typedPrimitives"] = scene.typedPrimitives;
+    out["accelerator"] = acceleratorStats(scene.getAccelerator());
+    if (const SphereGroup* group = scene.getSphereGroup()) {
+        json spheres;
+        spheres["count"] = group->getSphereCount();
+        spheres["memory"] = group->getSphereMemory();
+        spheres["accelerator"] = acceleratorStats(group->getAccelerator());
+        out["spheres"] = spheres;
+    }
+    if (const ScenePrimitives* typed = scene.getTypedPrimitives()) {
+        json primitives;
+        primitives["spheres"] = typed->sphereCount();
+        primitives["triangles"] = typed->triangleCount();
+        primitives["planes"] = typed->planeCount();
+        primitives["objects"] = typed->objectCount();
+        primitives["memory"] = typed->memoryBytes();
+        out["primitives"] = primitives;
+    }
+
+    // Une entrée par géométrie, dans l'ordre de première apparition
+    std::map<const MeshGeometry*, size_t> entries;
+    json meshes = json::array();
+    for (SceneObject* object : scene.getObjects()) {
+        Mesh* mesh = dynamic_cast<Mesh*>(object);
+        if (mesh == nullptr || !mesh->getGeometry()) {
+            continue;
+        }
+        const MeshGeometry* geometry = mesh->getGeometry().get();
+        auto entry = entries.find(geometry);
+        if (entry != entries.end()) {
+            meshes[entry->second]["instances"] = meshes[entry->second]["instances"].get<size_t>() + 1;
+            continue;
+        }
+        entries[geometry] = meshes.size();
+
+        json stats;
+        stats["path"] = geometry->getPath();
+        stats["instances"] = 1;
+        stats["triangles"] = geometry->getTriangleCount();
+        stats["triangleMemory"] = geometry->getTriangleMemory();
+        stats["accelerator"] = acceleratorStats(geometry->getAccelerator());
+        meshes.push_back(stats);
+    }
+    out["meshes"] = meshes;
+    return out.dump(indent);
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <string>
+#include "Scene.hpp"
+
+/**
+ * Rapport sur les structures d'accélération d'une scène préparée
+ *
+ * Premier réflexe quand un rendu est lent: l'arbre de la scène et celui de
+ * chaque géométrie de mesh (partagée entre ses instances) sont décrits en JSON:
+ * - BVH: nœuds, feuilles, profondeurs, histogramme d'occupation des feuilles,
+ *   coût SAH, recouvrement des frères et mémoire (voir BSPTree::computeStats)
+ * - kd-tree: nœuds, feuilles et références; grille: résolution
+ * - Test linéaire: type seul
+ * Chaque géométrie indique aussi ses triangles et les octets de leur stockage
+ * indexé (triangleMemory, voir TriangleMesh).
+ * Avec packSpheres, l'entrée "spheres" décrit le groupe de sphères (nombre,
+ * octets du SphereSet et structure); avec typedPrimitives, l'entrée "primitives"
+ * donne le nombre d'objets de chaque type et les octets de leurs tableaux.
+ * Une structure de mesh pas encore construite (aucun rayon ne l'a atteinte,
+ * voir MeshGeometry::build) est décrite par null.
+ */
+class SceneStats {
+public:
+    /**
+     * @param scene Scène après prepare()
+     * @param indent Indentation du JSON (-1: une seule ligne)
+     */
+    static std::string toJson(const Scene& scene, int indent = 2);
+};
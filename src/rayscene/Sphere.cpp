@@ -104,3 +104,24 @@ bool Sphere::intersects(Ray &r, Intersection &intersection, CullingType culling)
   return true;
 }
 
+bool Sphere::occluded(Ray &r, double maxDistance)
+{
+  // Mêmes calculs que intersects(), sans position ni normale d'impact
+  Vector3 OC = center - r.GetPosition();
+  Vector3 OP = OC.projectOn(r.GetDirection());
+  if (OP.dot(r.GetDirection()) <= 0)
+  {
+    return false;
+  }
+
+  Vector3 CP = (r.GetPosition() + OP) - center;
+  double distanceSquared = CP.lengthSquared();
+  if (distanceSquared > radius * radius)
+  {
+    return false;
+  }
+
+  // Bloque la lumière si le premier point d'impact est avant elle
+  double t = OP.length() - sqrt(radius * radius - distanceSquared);
+  return t < maxDistance;
+}
@@ -14,8 +14,15 @@ public:
   Sphere(double r);
   ~Sphere();
 
+  /**
+   * Centre en espace monde (après applyTransform) et rayon
+   */
+  Vector3 getCenter() const { return center; }
+  double getRadius() const { return radius; }
+
   virtual void applyTransform() override;
   virtual void calculateBoundingBox() override;
   virtual bool intersects(Ray &r, Intersection &intersection, CullingType culling) override;
+  virtual bool occluded(Ray &r, double maxDistance) override;
   // OPTIMISATION : Suppression de l'appelle de la fonction countPrimes()
 };
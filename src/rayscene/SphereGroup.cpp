@@ -0,0 +1,78 @@
+#include "SphereGroup.hpp"
+
+SphereGroup::SphereGroup() : SceneObject()
+{
+}
+
+SphereGroup::~SphereGroup()
+{
+    // Les sphères d'origine appartiennent à la scène
+}
+
+void SphereGroup::setSpheres(const std::vector<Sphere *> &list)
+{
+    spheres = list;
+    packed.clear();
+    packed.reserve(spheres.size());
+    for (Sphere *sphere : spheres)
+    {
+        packed.add(sphere->getCenter(), sphere->getRadius(), sphere->material);
+    }
+    treeDirty = true;
+}
+
+void SphereGroup::applyTransform()
+{
+    const uint32_t count = static_cast<uint32_t>(spheres.size());
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        packed.set(i, spheres[i]->getCenter(), spheres[i]->getRadius(), spheres[i]->material);
+    }
+}
+
+void SphereGroup::calculateBoundingBox()
+{
+    if (packed.size() == 0)
+    {
+        boundingBox = AABB(Vector3(), Vector3());
+        return;
+    }
+
+    boundingBox = packed.bounds(0);
+    const uint32_t count = static_cast<uint32_t>(packed.size());
+    for (uint32_t i = 1; i < count; ++i)
+    {
+        boundingBox.subsume(packed.bounds(i));
+    }
+
+    // Même logique que Scene::prepare: refit si seules les sphères ont bougé
+    if (!accel || accel->getType() != accelerator.type)
+    {
+        accel = Accelerator::create(accelerator);
+        treeDirty = true;
+    }
+    const bool sameSettings = accel->configure(accelerator);
+    if (treeDirty || !sameSettings || !accel->refit())
+    {
+        accel->build(packed);
+        treeDirty = false;
+    }
+}
+
+bool SphereGroup::intersects(Ray &r, Intersection &intersection, CullingType culling)
+{
+    if (!accel)
+    {
+        return false;
+    }
+    return accel->closestIntersection(r, intersection, culling);
+}
+
+bool SphereGroup::occluded(Ray &r, double maxDistance)
+{
+    if (!accel)
+    {
+        return false;
+    }
+    return accel->occluded(r, maxDistance);
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "SceneObject.hpp"
+#include "Accelerator.hpp"
+#include "Sphere.hpp"
+#include "./SphereSet.hpp"
+
+/**
+ * Sphères de la scène regroupées dans un seul objet (Scene::packSpheres)
+ *
+ * Les Sphere restent dans la scène (elle en est propriétaire), le groupe n'en
+ * garde qu'une copie compacte (SphereSet) et sa propre structure d'accélération:
+ * l'arbre de la scène ne voit plus qu'une boîte, et les feuilles de l'arbre des
+ * sphères les testent quatre par quatre. Tout est en espace monde.
+ */
+class SphereGroup : public SceneObject
+{
+private:
+  std::vector<Sphere *> spheres;  // Sphères d'origine, non possédées
+  SphereSet packed;               // Copie compacte, même ordre que spheres
+  std::unique_ptr<Accelerator> accel;
+  bool treeDirty = true;          // Sphères ajoutées depuis la dernière construction
+
+public:
+  SphereGroup();
+  ~SphereGroup();
+
+  AcceleratorSettings accelerator;  // Structure des sphères et ses réglages
+
+  /**
+   * Sphères regroupées (leur transformation doit être appliquée avant applyTransform)
+   */
+  void setSpheres(const std::vector<Sphere *> &list);
+
+  size_t getSphereCount() const { return packed.size(); }
+  size_t getSphereMemory() const { return packed.memoryBytes(); }
+
+  /**
+   * Structure des sphères (nullptr avant calculateBoundingBox), à lire hors du rendu
+   */
+  const Accelerator *getAccelerator() const { return accel.get(); }
+
+  /**
+   * Recopie centres, rayons et matériaux des sphères d'origine
+   */
+  virtual void applyTransform() override;
+
+  /**
+   * Boîte du groupe, et structure des sphères: refit si elle le permet, sinon reconstruction
+   */
+  virtual void calculateBoundingBox() override;
+  virtual bool intersects(Ray &r, Intersection &intersection, CullingType culling) override;
+  virtual bool occluded(Ray &r, double maxDistance) override;
+};
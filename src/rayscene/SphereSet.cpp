@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "SphereSet.hpp"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SPHERE_SET_AVX
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SPHERE_SET_SSE
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define SPHERE_SET_NEON
+#endif
+
+void SphereSet::clear() {
+    x.clear();
+    y.clear();
+    z.clear();
+    r.clear();
+    materials.clear();
+}
+
+void SphereSet::reserve(size_t count) {
+    x.reserve(count);
+    y.reserve(count);
+    z.reserve(count);
+    r.reserve(count);
+    materials.reserve(count);
+}
+
+uint32_t SphereSet::add(const Vector3& center, double radius, Material* material) {
+    x.push_back(center.x);
+    y.push_back(center.y);
+    z.push_back(center.z);
+    r.push_back(radius);
+    materials.push_back(material);
+    return static_cast<uint32_t>(r.size() - 1);
+}
+
+void SphereSet::set(uint32_t prim, const Vector3& center, double radius, Material* material) {
+    x[prim] = center.x;
+    y[prim] = center.y;
+    z[prim] = center.z;
+    r[prim] = radius;
+    materials[prim] = material;
+}
+
+size_t SphereSet::memoryBytes() const {
+    return (x.capacity() + y.capacity() + z.capacity() + r.capacity()) * sizeof(double) +
+           materials.capacity() * sizeof(Material*);
+}
+
+AABB SphereSet::bounds(uint32_t prim) const {
+    const double radius = r[prim];
+    return AABB(Vector3(x[prim] - radius, y[prim] - radius, z[prim] - radius),
+                Vector3(x[prim] + radius, y[prim] + radius, z[prim] + radius));
+}
+
+void SphereSet::splitBounds(uint32_t prim, const AABB& box, int axis, double position,
+                            AABB& left, AABB& right) const {
+    // Comme SceneObject::splitBoundingBox: boîte de la sphère coupée par le plan
+    const AABB part = bounds(prim).intersection(box);
+    left = part.slice(axis, -std::numeric_limits<double>::infinity(), position);
+    right = part.slice(axis, position, std::numeric_limits<double>::infinity());
+}
+
+namespace {
+
+/**
+ * Quatre sphères d'une feuille rassemblées côte à côte (une valeur par voie)
+ */
+struct SphereLanes {
+    alignas(32) double x[4];
+    alignas(32) double y[4];
+    alignas(32) double z[4];
+    alignas(32) double r[4];
+};
+
+/**
+ * Rassemble les sphères prims[first .. first + 3]; au-delà de count, les voies
+ * répètent la dernière sphère (même résultat, pas de masque de fin de feuille)
+ */
+inline void gatherLanes(const uint32_t* prims, uint32_t first, uint32_t count, const double* x, const double* y,
+                        const double* z, const double* r, SphereLanes& lanes) {
+    for (uint32_t lane = 0; lane < 4; ++lane) {
+        const uint32_t prim = prims[std::min(first + lane, count - 1)];
+        lanes.x[lane] = x[prim];
+        lanes.y[lane] = y[prim];
+        lanes.z[lane] = z[prim];
+        lanes.r[lane] = r[prim];
+    }
+}
+
+/**
+ * Test rayon/sphère sur 4 sphères (direction unitaire)
+ *
+ * b = OC.d projette le centre sur le rayon, P = d * b - OC est le vecteur du
+ * centre au point le plus proche (comme CP dans Sphere::intersects: plus précis
+ * que |OC|² - b² pour une sphère lointaine), t = b - sqrt(r² - |P|²).
+ * @param t distances d'impact des 4 sphères (sans signification hors du masque)
+ * @return masque des sphères touchées (bit i = voie i)
+ */
+inline int intersectLanes(const SphereLanes& lanes, const double o[3], const double d[3], double t[4]) {
+#if defined(SPHERE_SET_AVX)
+    const __m256d ocx = _mm256_sub_pd(_mm256_load_pd(lanes.x), _mm256_set1_pd(o[0]));
+    const __m256d ocy = _mm256_sub_pd(_mm256_load_pd(lanes.y), _mm256_set1_pd(o[1]));
+    const __m256d ocz = _mm256_sub_pd(_mm256_load_pd(lanes.z), _mm256_set1_pd(o[2]));
+    const __m256d dx = _mm256_set1_pd(d[0]);
+    const __m256d dy = _mm256_set1_pd(d[1]);
+    const __m256d dz = _mm256_set1_pd(d[2]);
+    const __m256d b = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(ocx, dx), _mm256_mul_pd(ocy, dy)), _mm256_mul_pd(ocz, dz));
+    const __m256d px = _mm256_sub_pd(_mm256_mul_pd(dx, b), ocx);
+    const __m256d py = _mm256_sub_pd(_mm256_mul_pd(dy, b), ocy);
+    const __m256d pz = _mm256_sub_pd(_mm256_mul_pd(dz, b), ocz);
+    const __m256d c2 = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(px, px), _mm256_mul_pd(py, py)), _mm256_mul_pd(pz, pz));
+    const __m256d radius = _mm256_load_pd(lanes.r);
+    const __m256d disc = _mm256_sub_pd(_mm256_mul_pd(radius, radius), c2);
+    const __m256d zero = _mm256_setzero_pd();
+    _mm256_storeu_pd(t, _mm256_sub_pd(b, _mm256_sqrt_pd(_mm256_max_pd(disc, zero))));
+    const __m256d hit = _mm256_and_pd(_mm256_cmp_pd(b, zero, _CMP_GT_OQ), _mm256_cmp_pd(disc, zero, _CMP_GE_OQ));
+    return _mm256_movemask_pd(hit);
+#elif defined(SPHERE_SET_SSE)
+    int mask = 0;
+    const __m128d dx = _mm_set1_pd(d[0]);
+    const __m128d dy = _mm_set1_pd(d[1]);
+    const __m128d dz = _mm_set1_pd(d[2]);
+    const __m128d zero = _mm_setzero_pd();
+    for (int half = 0; half < 4; half += 2) {
+        const __m128d ocx = _mm_sub_pd(_mm_load_pd(&lanes.x[half]), _mm_set1_pd(o[0]));
+        const __m128d ocy = _mm_sub_pd(_mm_load_pd(&lanes.y[half]), _mm_set1_pd(o[1]));
+        const __m128d ocz = _mm_sub_pd(_mm_load_pd(&lanes.z[half]), _mm_set1_pd(o[2]));
+        const __m128d b = _mm_add_pd(_mm_add_pd(_mm_mul_pd(ocx, dx), _mm_mul_pd(ocy, dy)), _mm_mul_pd(ocz, dz));
+        const __m128d px = _mm_sub_pd(_mm_mul_pd(dx, b), ocx);
+        const __m128d py = _mm_sub_pd(_mm_mul_pd(dy, b), ocy);
+        const __m128d pz = _mm_sub_pd(_mm_mul_pd(dz, b), ocz);
+        const __m128d c2 = _mm_add_pd(_mm_add_pd(_mm_mul_pd(px, px), _mm_mul_pd(py, py)), _mm_mul_pd(pz, pz));
+        const __m128d radius = _mm_load_pd(&lanes.r[half]);
+        const __m128d disc = _mm_sub_pd(_mm_mul_pd(radius, radius), c2);
+        _mm_storeu_pd(&t[half], _mm_sub_pd(b, _mm_sqrt_pd(_mm_max_pd(disc, zero))));
+        const __m128d hit = _mm_and_pd(_mm_cmpgt_pd(b, zero), _mm_cmpge_pd(disc, zero));
+        mask |= _mm_movemask_pd(hit) << half;
+    }
+    return mask;
+#elif defined(SPHERE_SET_NEON)
+    int mask = 0;
+    const float64x2_t dx = vdupq_n_f64(d[0]);
+    const float64x2_t dy = vdupq_n_f64(d[1]);
+    const float64x2_t dz = vdupq_n_f64(d[2]);
+    const float64x2_t zero = vdupq_n_f64(0);
+    for (int half = 0; half < 4; half += 2) {
+        const float64x2_t ocx = vsubq_f64(vld1q_f64(&lanes.x[half]), vdupq_n_f64(o[0]));
+        const float64x2_t ocy = vsubq_f64(vld1q_f64(&lanes.y[half]), vdupq_n_f64(o[1]));
+        const float64x2_t ocz = vsubq_f64(vld1q_f64(&lanes.z[half]), vdupq_n_f64(o[2]));
+        const float64x2_t b = vaddq_f64(vaddq_f64(vmulq_f64(ocx, dx), vmulq_f64(ocy, dy)), vmulq_f64(ocz, dz));
+        const float64x2_t px = vsubq_f64(vmulq_f64(dx, b), ocx);
+        const float64x2_t py = vsubq_f64(vmulq_f64(dy, b), ocy);
+        const float64x2_t pz = vsubq_f64(vmulq_f64(dz, b), ocz);
+        const float64x2_t c2 = vaddq_f64(vaddq_f64(vmulq_f64(px, px), vmulq_f64(py, py)), vmulq_f64(pz, pz));
+        const float64x2_t radius = vld1q_f64(&lanes.r[half]);
+        const float64x2_t disc = vsubq_f64(vmulq_f64(radius, radius), c2);
+        vst1q_f64(&t[half], vsubq_f64(b, vsqrtq_f64(vmaxq_f64(disc, zero))));
+        const uint64x2_t hit = vandq_u64(vcgtq_f64(b, zero), vcgeq_f64(disc, zero));
+        mask |= static_cast<int>((vgetq_lane_u64(hit, 0) & 1) | ((vgetq_lane_u64(hit, 1) & 1) << 1)) << half;
+    }
+    return mask;
+#else
+    int mask = 0;
+    for (int lane = 0; lane < 4; ++lane) {
+        const double ocx = lanes.x[lane] - o[0];
+        const double ocy = lanes.y[lane] - o[1];
+        const double ocz = lanes.z[lane] - o[2];
+        const double b = ocx * d[0] + ocy * d[1] + ocz * d[2];
+        const double px = d[0] * b - ocx;
+        const double py = d[1] * b - ocy;
+        const double pz = d[2] * b - ocz;
+        const double disc = lanes.r[lane] * lanes.r[lane] - (px * px + py * py + pz * pz);
+        t[lane] = b - std::sqrt(std::max(disc, 0.0));
+        if (b > 0 && disc >= 0) {
+            mask |= 1 << lane;
+        }
+    }
+    return mask;
+#endif
+}
+
+}  // namespace
+
+/*
+ * OPTIMISATION : Sphères en SoA, testées quatre par quatre
+ *
+ * CODE AVANT :
+ *   for (...) {
+ *     SceneObject* obj = objects[indices[i]];      // Sphere allouée sur le tas
+ *     if (!obj->boundingBox.intersects(ray)) continue;
+ *     obj->intersects(ray, intersection, culling); // Appel virtuel, projectOn, deux sqrt,
+ *   }                                              // position et normale pour chaque impact
+ *
+ * CODE APRÈS :
+ *   - Un appel virtuel par feuille; les sphères sont rassemblées par 4 depuis les
+ *     tableaux SoA et testées ensemble (AVX: une instruction pour 4 doubles,
+ *     SSE2/NEON: deux de 2, boucle scalaire sinon)
+ *   - Une seule racine carrée vectorielle par groupe, pas de boîte par sphère
+ *   - Position et normale une seule fois, pour la sphère retenue
+ */
+void SphereSet::intersect(const uint32_t* prims, uint32_t count, Ray& ray, CullingType culling,
+                          Intersection& closest, double& closestDistanceSquared) const {
+    const Vector3 origin = ray.GetPosition();
+    const Vector3 direction = ray.GetDirection();
+    const double o[3] = {origin.x, origin.y, origin.z};
+    const double d[3] = {direction.x, direction.y, direction.z};
+
+    // Comme pour les autres objets, l'impact le plus proche est celui de plus petite distance au carré
+    double bestDistanceSquared = closestDistanceSquared < 0 ? std::numeric_limits<double>::infinity() : closestDistanceSquared;
+    double bestT = 0;
+    uint32_t best = count;
+    SphereLanes lanes;
+    double t[4];
+    for (uint32_t first = 0; first < count; first += 4) {
+        gatherLanes(prims, first, count, x.data(), y.data(), z.data(), r.data(), lanes);
+        const int mask = intersectLanes(lanes, o, d, t);
+        for (uint32_t lane = 0; lane < 4; ++lane) {
+            if (!((mask >> lane) & 1)) {
+                continue;
+            }
+            const double distanceSquared = t[lane] * t[lane];
+            if (distanceSquared < bestDistanceSquared) {
+                bestDistanceSquared = distanceSquared;
+                bestT = t[lane];
+                best = std::min(first + lane, count - 1);
+            }
+        }
+    }
+    if (best == count) {
+        return;
+    }
+
+    const uint32_t prim = prims[best];
+    const Vector3 position(o[0] + d[0] * bestT, o[1] + d[1] * bestT, o[2] + d[2] * bestT);
+    const double nx = position.x - x[prim];
+    const double ny = position.y - y[prim];
+    const double nz = position.z - z[prim];
+    const double length = std::sqrt(nx * nx + ny * ny + nz * nz);
+
+    Intersection intersection;
+    intersection.Position = position;
+    intersection.Normal = length > 0 ? Vector3(nx / length, ny / length, nz / length) : Vector3();
+    intersection.Mat = materials[prim];
+    intersection.Distance = bestDistanceSquared;
+    closestDistanceSquared = bestDistanceSquared;
+    closest = intersection;
+}
+
+bool SphereSet::occluded(const uint32_t* prims, uint32_t count, Ray& ray, double maxDistance) const {
+    const Vector3 origin = ray.GetPosition();
+    const Vector3 direction = ray.GetDirection();
+    const double o[3] = {origin.x, origin.y, origin.z};
+    const double d[3] = {direction.x, direction.y, direction.z};
+
+    SphereLanes lanes;
+    double t[4];
+    for (uint32_t first = 0; first < count; first += 4) {
+        gatherLanes(prims, first, count, x.data(), y.data(), z.data(), r.data(), lanes);
+        const int mask = intersectLanes(lanes, o, d, t);
+        for (uint32_t lane = 0; lane < 4; ++lane) {
+            // Comme Sphere::occluded: bloque si le premier point d'impact est avant la lumière
+            if (((mask >> lane) & 1) && t[lane] < maxDistance) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
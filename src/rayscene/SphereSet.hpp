@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "PrimitiveSet.hpp"
+#include "Material.hpp"
+#include "../raymath/Vector3.hpp"
+
+/**
+ * Sphères compactes, en espace monde
+ *
+ * Centres et rayons rangés en SoA (un tableau par coordonnée), plus le matériau
+ * de chaque sphère: 40 octets par sphère, contre plusieurs centaines pour une
+ * Sphere (SceneObject avec nom, Transform, AABB et vtable) allouée sur le tas.
+ * Les feuilles testent leurs sphères quatre par quatre (voir intersect); seule
+ * la sphère retenue calcule sa position et sa normale d'impact.
+ *
+ * Même test que Sphere::intersects: le centre doit être devant l'origine du
+ * rayon, les faces ne sont pas éliminées (culling ignoré).
+ */
+class SphereSet : public PrimitiveSet {
+public:
+    void clear();
+    void reserve(size_t count);
+
+    /**
+     * Ajoute une sphère
+     * @return Son indice
+     */
+    uint32_t add(const Vector3& center, double radius, Material* material);
+
+    /**
+     * Met à jour une sphère déjà ajoutée (transformation ou matériau modifiés)
+     */
+    void set(uint32_t prim, const Vector3& center, double radius, Material* material);
+
+    Vector3 center(uint32_t prim) const { return Vector3(x[prim], y[prim], z[prim]); }
+    double radius(uint32_t prim) const { return r[prim]; }
+
+    /**
+     * Octets occupés par les centres, rayons et matériaux
+     */
+    size_t memoryBytes() const;
+
+    size_t size() const override { return r.size(); }
+    uint32_t batchSize() const override { return 4; }
+    AABB bounds(uint32_t prim) const override;
+    void splitBounds(uint32_t prim, const AABB& box, int axis, double position,
+                     AABB& left, AABB& right) const override;
+    void intersect(const uint32_t* prims, uint32_t count, Ray& ray, CullingType culling,
+                   Intersection& closest, double& closestDistanceSquared) const override;
+    bool occluded(const uint32_t* prims, uint32_t count, Ray& ray, double maxDistance) const override;
+
+private:
+    std::vector<double> x;  // Centres, SoA
+    std::vector<double> y;
+    std::vector<double> z;
+    std::vector<double> r;  // Rayons
+    std::vector<Material*> materials;
+};
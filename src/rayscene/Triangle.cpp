@@ -1,7 +1,9 @@
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <limits>
 #include "Triangle.hpp"
+#include "TriangleKernel.hpp"
 #include "../raymath/Vector3.hpp"
 
 Triangle::Triangle(Vector3 a, Vector3 b, Vector3 c) : SceneObject(), A(a), B(b), C(c)
@@ -17,86 +19,144 @@ void Triangle::applyTransform()
   tA = this->transform.apply(A);
   tB = this->transform.apply(B);
   tC = this->transform.apply(C);
+  normal = triangleNormal(tA, tB, tC);
 }
 
 void Triangle::calculateBoundingBox()
 {
-  // Calculer les min et max pour chaque axe parmi les 3 points transform\u00e9s
+  boundingBox = cornerBounds(tA, tB, tC);
+}
+
+AABB Triangle::cornerBounds(const Vector3 &a, const Vector3 &b, const Vector3 &c)
+{
+  // Calculer les min et max pour chaque axe parmi les 3 points transformés
   Vector3 min(
-    std::min({tA.x, tB.x, tC.x}),
-    std::min({tA.y, tB.y, tC.y}),
-    std::min({tA.z, tB.z, tC.z})
+    std::min({a.x, b.x, c.x}),
+    std::min({a.y, b.y, c.y}),
+    std::min({a.z, b.z, c.z})
   );
 
   Vector3 max(
-    std::max({tA.x, tB.x, tC.x}),
-    std::max({tA.y, tB.y, tC.y}),
-    std::max({tA.z, tB.z, tC.z})
+    std::max({a.x, b.x, c.x}),
+    std::max({a.y, b.y, c.y}),
+    std::max({a.z, b.z, c.z})
   );
 
-  boundingBox = AABB(min, max);
+  return AABB(min, max);
 }
 
+/*
+ * OPTIMISATION : Test étanche, données précalculées
+ *
+ * CODE AVANT :
+ *   Vector3 normal = BA.cross(CA).normalize();  // sqrt à chaque test
+ *   float t = numer / denom;                     // Mélange float / double
+ *   BA.cross(QA).dot(normal) < 0 ...             // Trois produits vectoriels d'inclusion
+ *   // Un rayon sur une arête commune pouvait manquer les deux triangles
+ *
+ * CODE APRÈS :
+ *   - Normale unitaire calculée une fois par applyTransform (prepare)
+ *   - Test de Woop, Benthin et Wald (TriangleKernel.hpp), tout en double:
+ *     fonctions d'arête dans le repère du rayon, étanche sur les arêtes communes
+ *   - Position de l'impact calculée seulement si le triangle est touché
+ */
 bool Triangle::intersects(Ray &r, Intersection &intersection, CullingType culling)
 {
-  Vector3 BA = tB - tA;
-  Vector3 CA = tC - tA;
-  Vector3 normal = BA.cross(CA).normalize();
-
-  // Ray plane intersection
-  float denom = r.GetDirection().dot(normal);
-
-  //
-  // If denom == 0 - it is parallel to the plane
-  // If denom > 0, it means plane is behind the ray
-  if (culling == CULLING_FRONT && denom > -0.000001)
-  {
-    return false;
-  }
-  if (culling == CULLING_BACK && denom < 0.000001)
+  const Vector3 origin = r.GetPosition();
+  const Vector3 direction = r.GetDirection();
+  const TriangleRay ray(origin, direction);
+  TriangleHit hit;
+  if (!intersectTriangle(ray, tA, tB, tC, culling, std::numeric_limits<double>::infinity(), hit))
   {
     return false;
   }
 
-  float numer = (tA - r.GetPosition()).dot(normal);
-  float t = numer / denom;
+  intersection.Position = Vector3(origin.x + direction.x * hit.t, origin.y + direction.y * hit.t, origin.z + direction.z * hit.t);
+  intersection.Mat = this->material;
+  intersection.Normal = normal;
 
-  // Behind the ray
-  if (t <= 0)
-  {
-    return false;
-  }
+  return true;
+}
+
+bool Triangle::occluded(Ray &r, double maxDistance)
+{
+  // Mêmes conventions que intersects() avec CULLING_BACK, sortie au-delà de la lumière
+  const TriangleRay ray(r.GetPosition(), r.GetDirection());
+  TriangleHit hit;
+  return intersectTriangle(ray, tA, tB, tC, CULLING_BACK, maxDistance, hit);
+}
 
-  // Point on plane
-  Vector3 Q = r.GetPosition() + (r.GetDirection() * t);
+/**
+ * Découpe spatiale: chaque sommet va du côté du plan où il se trouve, chaque
+ * arête qui traverse le plan y ajoute son point de passage des deux côtés.
+ * Les boîtes obtenues sont ensuite restreintes à box (partie déjà découpée).
+ * Appelée des millions de fois par le constructeur SBVH: calculs sur des
+ * tableaux de doubles plutôt qu'avec des Vector3 temporaires.
+ */
+void Triangle::splitBoundingBox(AABB const &box, int axis, double position, AABB &left, AABB &right)
+{
+  splitCorners(tA, tB, tC, box, axis, position, left, right);
+}
 
-  // Point contained in triangle
-  Vector3 QA = Q - tA;
-  Vector3 BAxQA = BA.cross(QA);
-  if (BAxQA.dot(normal) < 0)
-  {
-    return false;
-  }
+void Triangle::splitCorners(const Vector3 &tA, const Vector3 &tB, const Vector3 &tC, AABB const &box, int axis, double position, AABB &left, AABB &right)
+{
+  const double inf = std::numeric_limits<double>::infinity();
+  const double vertices[3][3] = {{tA.x, tA.y, tA.z}, {tB.x, tB.y, tB.z}, {tC.x, tC.y, tC.z}};
+  double bounds[2][2][3] = {{{inf, inf, inf}, {-inf, -inf, -inf}}, {{inf, inf, inf}, {-inf, -inf, -inf}}};
 
-  Vector3 CB = tC - tB;
-  Vector3 QB = Q - tB;
-  Vector3 CBxQB = CB.cross(QB);
-  if (CBxQB.dot(normal) < 0)
+  auto grow = [&bounds](int side, const double *p)
   {
-    return false;
+    for (int k = 0; k < 3; k++)
+    {
+      bounds[side][0][k] = std::min(bounds[side][0][k], p[k]);
+      bounds[side][1][k] = std::max(bounds[side][1][k], p[k]);
+    }
+  };
+
+  for (int i = 0; i < 3; i++)
+  {
+    const double *v0 = vertices[i];
+    const double *v1 = vertices[(i + 1) % 3];
+    const double c0 = v0[axis];
+    const double c1 = v1[axis];
+
+    if (c0 <= position)
+    {
+      grow(0, v0);
+    }
+    if (c0 >= position)
+    {
+      grow(1, v0);
+    }
+    if ((c0 < position && c1 > position) || (c0 > position && c1 < position))
+    {
+      const double t = (position - c0) / (c1 - c0);
+      double p[3];
+      for (int k = 0; k < 3; k++)
+      {
+        p[k] = v0[k] + (v1[k] - v0[k]) * t;
+      }
+      p[axis] = position;
+      grow(0, p);
+      grow(1, p);
+    }
   }
 
-  Vector3 AC = tA - tC;
-  Vector3 QC = Q - tC;
-  Vector3 ACxQC = AC.cross(QC);
-  if (ACxQC.dot(normal) < 0)
+  // Restriction à box, côté gauche (axis <= position) puis côté droit
+  const Vector3 boxMin = box.getMin();
+  const Vector3 boxMax = box.getMax();
+  const double clip[2][3] = {{boxMin.x, boxMin.y, boxMin.z}, {boxMax.x, boxMax.y, boxMax.z}};
+  for (int side = 0; side < 2; side++)
   {
-    return false;
+    for (int k = 0; k < 3; k++)
+    {
+      bounds[side][0][k] = std::max(bounds[side][0][k], clip[0][k]);
+      bounds[side][1][k] = std::min(bounds[side][1][k], clip[1][k]);
+    }
   }
+  bounds[0][1][axis] = std::min(bounds[0][1][axis], position);
+  bounds[1][0][axis] = std::max(bounds[1][0][axis], position);
 
-  intersection.Position = Q;
-  intersection.Mat = this->material;
-  intersection.Normal = normal;
-
-  return true;
-}
\ No newline at end of file
+  left = AABB(Vector3(bounds[0][0][0], bounds[0][0][1], bounds[0][0][2]), Vector3(bounds[0][1][0], bounds[0][1][1], bounds[0][1][2]));
+  right = AABB(Vector3(bounds[1][0][0], bounds[1][0][1], bounds[1][0][2]), Vector3(bounds[1][1][0], bounds[1][1][1], bounds[1][1][2]));
+}
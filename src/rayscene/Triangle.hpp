@@ -15,6 +15,7 @@ private:
   Vector3 tA;
   Vector3 tB;
   Vector3 tC;
+  Vector3 normal;  // Normale unitaire en espace monde, calculée par applyTransform
 
 public:
   Triangle(Vector3 a, Vector3 b, Vector3 c);
@@ -22,7 +23,28 @@ public:
 
   int ID;
 
+  /**
+   * Sommets et normale en espace monde (après applyTransform)
+   */
+  void getWorldCorners(Vector3 &a, Vector3 &b, Vector3 &c) const
+  {
+    a = tA;
+    b = tB;
+    c = tC;
+  }
+  Vector3 getNormal() const { return normal; }
+
   virtual void applyTransform() override;
   virtual void calculateBoundingBox() override;
   virtual bool intersects(Ray &r, Intersection &intersection, CullingType culling) override;
+  virtual bool occluded(Ray &r, double maxDistance) override;
+  virtual void splitBoundingBox(AABB const &box, int axis, double position, AABB &left, AABB &right) override;
+
+  /**
+   * Boîte et découpe sur trois sommets quelconques, partagées avec les triangles
+   * indexés des meshes (TriangleMesh). Le test d'intersection commun est dans
+   * TriangleKernel.hpp.
+   */
+  static AABB cornerBounds(const Vector3 &a, const Vector3 &b, const Vector3 &c);
+  static void splitCorners(const Vector3 &a, const Vector3 &b, const Vector3 &c, AABB const &box, int axis, double position, AABB &left, AABB &right);
 };
@@ -0,0 +1,137 @@
+#pragma once
+#include <cmath>
+#include <utility>
+#include "../raymath/Vector3.hpp"
+#include "SceneObject.hpp"
+
+/**
+ * Test rayon/triangle étanche (Woop, Benthin et Wald, « Watertight Ray/Triangle
+ * Intersection », JCGT 2013)
+ *
+ * Le rayon est ramené, par permutation et cisaillement, sur l'axe z positif;
+ * le test d'inclusion se fait alors en 2D avec les fonctions d'arête U, V, W.
+ * Une arête commune à deux triangles donne dans chacun exactement la même
+ * valeur au signe près (produits identiques, soustraction inversée): un rayon
+ * qui passe sur l'arête touche toujours au moins l'un des deux, sans fuite
+ * entre triangles voisins. Cela suppose des produits arrondis séparément:
+ * le projet est compilé sans contraction en FMA (-ffp-contract=off, voir
+ * CMakeLists.txt), qui fusionnerait un produit d'un côté de l'arête et pas
+ * de l'autre.
+ *
+ * Le noyau ne renvoie que t et les coordonnées barycentriques, sans racine
+ * carrée ni normale: la position et la normale ne sont calculées qu'une fois,
+ * pour l'impact retenu.
+ *
+ * Tout est défini ici (inline): le noyau est au cœur de chaque feuille. Les
+ * coordonnées sont en tableaux de doubles pour que la permutation des axes
+ * (kx, ky, kz) les indexe directement.
+ */
+
+/**
+ * Rayon préparé pour le noyau, une fois par requête (ou par feuille)
+ */
+struct TriangleRay {
+    double origin[3];
+    int kx, ky, kz;     // Permutation des axes: kz = plus grande composante de la direction
+    double sx, sy, sz;  // Cisaillement qui aligne la direction sur z
+
+    TriangleRay(const Vector3& position, const Vector3& direction) {
+        origin[0] = position.x;
+        origin[1] = position.y;
+        origin[2] = position.z;
+        const double d[3] = {direction.x, direction.y, direction.z};
+        kz = std::fabs(d[0]) > std::fabs(d[1]) ? (std::fabs(d[0]) > std::fabs(d[2]) ? 0 : 2)
+                                               : (std::fabs(d[1]) > std::fabs(d[2]) ? 1 : 2);
+        kx = (kz + 1) % 3;
+        ky = (kx + 1) % 3;
+        if (d[kz] < 0) {
+            std::swap(kx, ky);  // Conserve le sens de parcours des sommets
+        }
+        sx = d[kx] / d[kz];
+        sy = d[ky] / d[kz];
+        sz = 1.0 / d[kz];
+    }
+};
+
+/**
+ * Impact: distance le long du rayon et coordonnées barycentriques
+ * (position = u * A + v * B + w * C, u + v + w = 1)
+ */
+struct TriangleHit {
+    double t;
+    double u, v, w;
+};
+
+/**
+ * Intersection d'un rayon préparé avec le triangle ABC
+ * Face avant: (B - A) x (C - A) opposée au rayon, comme Triangle::intersects
+ * (CULLING_FRONT ne garde que les faces avant, CULLING_BACK que les faces arrière).
+ * @param tMax Seuls les impacts 0 < t < tMax sont retenus
+ * @return false si le rayon manque le triangle, est parallèle à son plan ou si la face est éliminée
+ */
+inline bool intersectTriangle(const TriangleRay& ray, const Vector3& a, const Vector3& b, const Vector3& c,
+                              CullingType culling, double tMax, TriangleHit& hit) {
+    // Sommets relatifs à l'origine du rayon
+    const double A[3] = {a.x - ray.origin[0], a.y - ray.origin[1], a.z - ray.origin[2]};
+    const double B[3] = {b.x - ray.origin[0], b.y - ray.origin[1], b.z - ray.origin[2]};
+    const double C[3] = {c.x - ray.origin[0], c.y - ray.origin[1], c.z - ray.origin[2]};
+
+    // Cisaillement: le rayon devient l'axe z
+    const double ax = A[ray.kx] - ray.sx * A[ray.kz];
+    const double ay = A[ray.ky] - ray.sy * A[ray.kz];
+    const double bx = B[ray.kx] - ray.sx * B[ray.kz];
+    const double by = B[ray.ky] - ray.sy * B[ray.kz];
+    const double cx = C[ray.kx] - ray.sx * C[ray.kz];
+    const double cy = C[ray.ky] - ray.sy * C[ray.kz];
+
+    // Fonctions d'arête (aires signées opposées à A, B et C)
+    const double u = cx * by - cy * bx;
+    const double v = ax * cy - ay * cx;
+    const double w = bx * ay - by * ax;
+
+    // Tous du même signe (zéro compris): le rayon passe dans le triangle ou sur son bord.
+    // Signe positif: face avant
+    if (culling == CULLING_FRONT) {
+        if (u < 0 || v < 0 || w < 0) {
+            return false;
+        }
+    } else if (culling == CULLING_BACK) {
+        if (u > 0 || v > 0 || w > 0) {
+            return false;
+        }
+    } else if ((u < 0 || v < 0 || w < 0) && (u > 0 || v > 0 || w > 0)) {
+        return false;
+    }
+
+    const double det = u + v + w;
+    if (det == 0) {
+        return false;  // Rayon dans le plan du triangle
+    }
+
+    // Distance: profondeurs des sommets pondérées par les fonctions d'arête
+    const double az = ray.sz * A[ray.kz];
+    const double bz = ray.sz * B[ray.kz];
+    const double cz = ray.sz * C[ray.kz];
+    const double t = (u * az + v * bz + w * cz) / det;
+    if (!(t > 0 && t < tMax)) {
+        return false;
+    }
+
+    const double inverseDet = 1.0 / det;
+    hit.t = t;
+    hit.u = u * inverseDet;
+    hit.v = v * inverseDet;
+    hit.w = w * inverseDet;
+    return true;
+}
+
+/**
+ * Normale unitaire du triangle ABC, face avant ((B - A) x (C - A)), en doubles bruts
+ */
+inline Vector3 triangleNormal(const Vector3& a, const Vector3& b, const Vector3& c) {
+    const double e1[3] = {b.x - a.x, b.y - a.y, b.z - a.z};
+    const double e2[3] = {c.x - a.x, c.y - a.y, c.z - a.z};
+    const double n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+    const double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    return length > 0 ? Vector3(n[0] / length, n[1] / length, n[2] / length) : Vector3();
+}
@@ -0,0 +1,111 @@
+#include <cmath>
+#include <limits>
+#include "TriangleMesh.hpp"
+#include "Triangle.hpp"
+#include "TriangleKernel.hpp"
+
+void TriangleMesh::reserve(size_t vertexCount, size_t triangleCount) {
+    x.reserve(vertexCount);
+    y.reserve(vertexCount);
+    z.reserve(vertexCount);
+    indices.reserve(3 * triangleCount);
+}
+
+uint32_t TriangleMesh::addVertex(const Vector3& position) {
+    x.push_back(position.x);
+    y.push_back(position.y);
+    z.push_back(position.z);
+    return static_cast<uint32_t>(x.size() - 1);
+}
+
+void TriangleMesh::addTriangle(uint32_t a, uint32_t b, uint32_t c) {
+    indices.push_back(a);
+    indices.push_back(b);
+    indices.push_back(c);
+}
+
+void TriangleMesh::shrinkToFit() {
+    x.shrink_to_fit();
+    y.shrink_to_fit();
+    z.shrink_to_fit();
+    indices.shrink_to_fit();
+}
+
+size_t TriangleMesh::memoryBytes() const {
+    return (x.capacity() + y.capacity() + z.capacity()) * sizeof(double) + indices.capacity() * sizeof(uint32_t);
+}
+
+AABB TriangleMesh::bounds(uint32_t prim) const {
+    Vector3 a, b, c;
+    corners(prim, a, b, c);
+    return Triangle::cornerBounds(a, b, c);
+}
+
+void TriangleMesh::splitBounds(uint32_t prim, const AABB& box, int axis, double position,
+                               AABB& left, AABB& right) const {
+    Vector3 a, b, c;
+    corners(prim, a, b, c);
+    Triangle::splitCorners(a, b, c, box, axis, position, left, right);
+}
+
+/*
+ * OPTIMISATION : Triangles indexés dans les feuilles
+ *
+ * CODE AVANT :
+ *   for (...) {
+ *     SceneObject* obj = objects[indices[i]];      // Triangle alloué sur le tas
+ *     if (!obj->boundingBox.intersects(ray)) continue;
+ *     obj->intersects(ray, intersection, culling); // Appel virtuel, normale et position par triangle
+ *   }
+ *
+ * CODE APRÈS :
+ *   - Un appel virtuel par feuille, puis une boucle directe sur les triangles
+ *   - Les sommets sont lus dans des tableaux contigus partagés par les faces
+ *     voisines, au lieu d'objets dispersés de plusieurs centaines d'octets
+ *   - Rayon préparé une fois par feuille, noyau étanche (TriangleKernel.hpp)
+ *     borné par le meilleur impact: seuls t et les barycentriques sont calculés
+ *   - Position et normale une seule fois, pour le triangle retenu
+ */
+void TriangleMesh::intersect(const uint32_t* prims, uint32_t count, Ray& ray, CullingType culling,
+                             Intersection& closest, double& closestDistanceSquared) const {
+    const Vector3 o = ray.GetPosition();
+    const Vector3 d = ray.GetDirection();
+    const TriangleRay prepared(o, d);
+
+    // Direction unitaire (Ray la normalise): t est la distance
+    double tMax = closestDistanceSquared < 0 ? std::numeric_limits<double>::infinity() : std::sqrt(closestDistanceSquared);
+    uint32_t best = count;
+    Vector3 a, b, c;
+    TriangleHit hit;
+    for (uint32_t i = 0; i < count; ++i) {
+        corners(prims[i], a, b, c);
+        if (intersectTriangle(prepared, a, b, c, culling, tMax, hit)) {
+            tMax = hit.t;
+            best = i;
+        }
+    }
+    if (best == count) {
+        return;
+    }
+
+    corners(prims[best], a, b, c);
+    Intersection intersection;
+    intersection.Position = Vector3(o.x + d.x * tMax, o.y + d.y * tMax, o.z + d.z * tMax);
+    intersection.Normal = triangleNormal(a, b, c);
+    intersection.Distance = tMax * tMax;
+    closestDistanceSquared = tMax * tMax;
+    closest = intersection;
+}
+
+bool TriangleMesh::occluded(const uint32_t* prims, uint32_t count, Ray& ray, double maxDistance) const {
+    const TriangleRay prepared(ray.GetPosition(), ray.GetDirection());
+    Vector3 a, b, c;
+    TriangleHit hit;
+    for (uint32_t i = 0; i < count; ++i) {
+        corners(prims[i], a, b, c);
+        if (intersectTriangle(prepared, a, b, c, CULLING_BACK, maxDistance, hit)) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "PrimitiveSet.hpp"
+#include "../raymath/Vector3.hpp"
+
+/**
+ * Triangles indexés d'un mesh, en espace objet
+ *
+ * Les sommets sont partagés entre les faces et rangés en SoA (un tableau par
+ * coordonnée), chaque triangle n'est qu'un triplet d'indices 32 bits: environ
+ * 24 octets par triangle d'un mesh fermé, contre plusieurs centaines pour un
+ * Triangle (SceneObject avec nom, Transform, AABB, six sommets et vtable).
+ * Normale et boîte ne sont pas stockées, elles se recalculent à partir des
+ * sommets. Les structures d'accélération parcourent les triangles par leur
+ * indice (voir PrimitiveSet).
+ */
+class TriangleMesh : public PrimitiveSet {
+public:
+    /**
+     * Réserve la place de vertexCount sommets et triangleCount triangles
+     */
+    void reserve(size_t vertexCount, size_t triangleCount);
+
+    /**
+     * Ajoute un sommet
+     * @return Son indice
+     */
+    uint32_t addVertex(const Vector3& position);
+
+    /**
+     * Ajoute un triangle à partir de trois indices de sommets déjà ajoutés
+     */
+    void addTriangle(uint32_t a, uint32_t b, uint32_t c);
+
+    /**
+     * Libère la place réservée en trop après le chargement
+     */
+    void shrinkToFit();
+
+    size_t vertexCount() const { return x.size(); }
+    Vector3 vertex(uint32_t index) const { return Vector3(x[index], y[index], z[index]); }
+
+    /**
+     * Sommets d'un triangle, lus directement dans les tableaux des coordonnées
+     */
+    void corners(uint32_t prim, Vector3& a, Vector3& b, Vector3& c) const {
+        const uint32_t* index = &indices[3 * prim];
+        load(index[0], a);
+        load(index[1], b);
+        load(index[2], c);
+    }
+
+    /**
+     * Octets occupés par les sommets et les indices
+     */
+    size_t memoryBytes() const;
+
+    size_t size() const override { return indices.size() / 3; }
+    AABB bounds(uint32_t prim) const override;
+    void splitBounds(uint32_t prim, const AABB& box, int axis, double position,
+                     AABB& left, AABB& right) const override;
+    void intersect(const uint32_t* prims, uint32_t count, Ray& ray, CullingType culling,
+                   Intersection& closest, double& closestDistanceSquared) const override;
+    bool occluded(const uint32_t* prims, uint32_t count, Ray& ray, double maxDistance) const override;
+
+private:
+    void load(uint32_t index, Vector3& p) const {
+        p.x = x[index];
+        p.y = y[index];
+        p.z = z[index];
+    }
+
+    std::vector<double> x;           // Sommets, SoA
+    std::vector<double> y;
+    std::vector<double> z;
+    std::vector<uint32_t> indices;   // Trois sommets par triangle
+};
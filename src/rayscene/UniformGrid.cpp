@@ -0,0 +1,356 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "UniformGrid.hpp"
+#include "Parallel.hpp"
+
+// Paramètres de la grille
+static const double GRID_CELLS_PER_OBJECT = 2.0;   // Nombre de cellules visé par objet borné
+static const int GRID_MAX_RESOLUTION = 256;        // Cellules par axe au maximum
+static const size_t GRID_MAX_CELLS = 1u << 24;     // Borne de la mémoire des listes de cellules
+static const double GRID_CELL_MARGIN = 1e-6;       // Marge (en cellules) des boîtes insérées, contre les arrondis du DDA
+static const double GRID_SLAB_SCALE = 1.0 + 4 * std::numeric_limits<double>::epsilon();  // Sortie de la grille: rayon visant un coin
+
+// Boîte aux lettres: derniers objets testés par le rayon, adressés par leur indice
+static const uint32_t GRID_MAILBOX_SIZE = 64;      // Puissance de 2
+
+static double axisValue(const Vector3& v, int axis) {
+    if (axis == 0) return v.x;
+    if (axis == 1) return v.y;
+    return v.z;
+}
+
+UniformGrid::UniformGrid() {}
+
+UniformGrid::~UniformGrid() {
+    // Les objets ne sont pas détruits ici, ils appartiennent à la Scene
+}
+
+/**
+ * Construit la grille
+ *
+ * ALGORITHME:
+ * 1. Les objets non bornés sont mis à part, les autres définissent les bornes
+ * 2. Résolution: environ GRID_CELLS_PER_OBJECT * n cellules, réparties selon
+ *    l'étendue de chaque axe pour des cellules à peu près cubiques
+ * 3. Plage de cellules couverte par l'AABB de chaque objet (en parallèle)
+ * 4. Comptage par cellule, préfixe, puis remplissage des listes (tri par
+ *    dénombrement: pas d'allocation par cellule)
+ */
+void UniformGrid::build(std::vector<SceneObject*>& objects) {
+    this->objects = objects;
+    primitives = nullptr;
+    buildGrid();
+}
+
+void UniformGrid::build(const PrimitiveSet& primitives) {
+    objects.clear();
+    this->primitives = &primitives;
+    buildGrid();
+}
+
+void UniformGrid::buildGrid() {
+    cellStart.clear();
+    cellObjects.clear();
+    unboundedIndices.clear();
+    std::fill(resolution, resolution + 3, 0);
+
+    // Étape 1: objets bornés et bornes de la grille
+    std::vector<uint32_t> bounded;
+    AABB bounds;
+    const uint32_t total = static_cast<uint32_t>(primitives ? primitives->size() : objects.size());
+    for (uint32_t i = 0; i < total; ++i) {
+        const AABB box = primitiveBounds(i);
+        if (!box.isFinite()) {
+            unboundedIndices.push_back(i);
+            continue;
+        }
+        if (bounded.empty()) bounds = box; else bounds.subsume(box);
+        bounded.push_back(i);
+    }
+    if (bounded.empty()) {
+        return;
+    }
+
+    // Étape 2: résolution (les axes plats gardent une épaisseur pour le calcul du volume)
+    double extent[3];
+    double maxExtent = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        gridMin[axis] = axisValue(bounds.getMin(), axis);
+        gridMax[axis] = axisValue(bounds.getMax(), axis);
+        extent[axis] = gridMax[axis] - gridMin[axis];
+        maxExtent = std::max(maxExtent, extent[axis]);
+    }
+    if (maxExtent <= 0) {
+        maxExtent = 1;
+    }
+    for (int axis = 0; axis < 3; ++axis) {
+        extent[axis] = std::max(extent[axis], maxExtent * 1e-3);
+    }
+
+    const double volume = extent[0] * extent[1] * extent[2];
+    const double cellsPerUnit = std::cbrt(GRID_CELLS_PER_OBJECT * bounded.size() / volume);
+    size_t cellCount = 1;
+    for (int axis = 0; axis < 3; ++axis) {
+        resolution[axis] = std::max(1, std::min(GRID_MAX_RESOLUTION, static_cast<int>(std::ceil(extent[axis] * cellsPerUnit))));
+        cellCount *= resolution[axis];
+    }
+    while (cellCount > GRID_MAX_CELLS) {
+        cellCount = 1;
+        for (int axis = 0; axis < 3; ++axis) {
+            resolution[axis] = std::max(1, resolution[axis] / 2);
+            cellCount *= resolution[axis];
+        }
+    }
+    for (int axis = 0; axis < 3; ++axis) {
+        cellSize[axis] = extent[axis] / resolution[axis];
+    }
+
+    // Étape 3: plage de cellules de chaque objet
+    struct CellRange {
+        int lo[3];
+        int hi[3];
+    };
+    std::vector<CellRange> ranges(bounded.size());
+    parallelFor(0, bounded.size(), getThreadCount(), [&](size_t first, size_t last, unsigned int) {
+        for (size_t i = first; i < last; ++i) {
+            const AABB box = primitiveBounds(bounded[i]);
+            for (int axis = 0; axis < 3; ++axis) {
+                const double margin = GRID_CELL_MARGIN * cellSize[axis];
+                ranges[i].lo[axis] = cellCoordinate(axisValue(box.getMin(), axis) - margin, axis);
+                ranges[i].hi[axis] = cellCoordinate(axisValue(box.getMax(), axis) + margin, axis);
+            }
+        }
+    });
+
+    // Étape 4: comptage, préfixe, remplissage
+    auto forEachCell = [this](const CellRange& range, auto&& fn) {
+        for (int z = range.lo[2]; z <= range.hi[2]; ++z) {
+            for (int y = range.lo[1]; y <= range.hi[1]; ++y) {
+                const size_t row = (static_cast<size_t>(z) * resolution[1] + y) * resolution[0];
+                for (int x = range.lo[0]; x <= range.hi[0]; ++x) {
+                    fn(row + x);
+                }
+            }
+        }
+    };
+
+    cellStart.assign(cellCount + 1, 0);
+    for (const CellRange& range : ranges) {
+        forEachCell(range, [this](size_t cell) { cellStart[cell + 1]++; });
+    }
+    for (size_t cell = 0; cell < cellCount; ++cell) {
+        cellStart[cell + 1] += cellStart[cell];
+    }
+
+    cellObjects.resize(cellStart[cellCount]);
+    std::vector<uint32_t> fill(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < bounded.size(); ++i) {
+        const uint32_t index = bounded[i];
+        forEachCell(ranges[i], [&](size_t cell) { cellObjects[fill[cell]++] = index; });
+    }
+}
+
+int UniformGrid::cellCoordinate(double value, int axis) const {
+    const int cell = static_cast<int>(std::floor((value - gridMin[axis]) / cellSize[axis]));
+    return std::max(0, std::min(resolution[axis] - 1, cell));
+}
+
+/**
+ * Parcours 3D-DDA (Amanatides & Woo)
+ *
+ * ALGORITHME:
+ * 1. Intervalle [t0, t1] du rayon dans la boîte de la grille, borné par tMax
+ * 2. Cellule d'entrée, puis sur chaque axe: distance jusqu'au prochain plan
+ *    de cellule (tNext) et distance entre deux plans (tDelta)
+ * 3. Visiter la cellule, puis passer à la voisine sur l'axe du plus petit tNext
+ */
+template <typename Visitor>
+void UniformGrid::traverse(Ray& ray, double tMax, Visitor&& visit) const {
+    if (cellStart.empty()) {
+        return;
+    }
+
+    const Vector3 origin = ray.GetPosition();
+    const Vector3 direction = ray.GetDirection();
+    const double o[3] = {origin.x, origin.y, origin.z};
+    const double d[3] = {direction.x, direction.y, direction.z};
+
+    // Étape 1: intervalle dans la boîte de la grille
+    double t0 = 0;
+    double t1 = tMax;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (d[axis] == 0) {
+            if (o[axis] < gridMin[axis] || o[axis] > gridMax[axis]) {
+                return;
+            }
+            continue;
+        }
+        const double inv = 1.0 / d[axis];
+        double tNear = (gridMin[axis] - o[axis]) * inv;
+        double tFar = (gridMax[axis] - o[axis]) * inv;
+        if (tNear > tFar) std::swap(tNear, tFar);
+        t0 = std::max(t0, tNear);
+        t1 = std::min(t1, tFar);
+    }
+    if (t0 > t1 * GRID_SLAB_SCALE) {
+        return;
+    }
+
+    // Étape 2: cellule d'entrée et pas sur chaque axe
+    int cell[3];
+    int step[3];
+    double tNext[3];
+    double tDelta[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        cell[axis] = cellCoordinate(o[axis] + d[axis] * t0, axis);
+        if (d[axis] > 0) {
+            step[axis] = 1;
+            tNext[axis] = (gridMin[axis] + (cell[axis] + 1) * cellSize[axis] - o[axis]) / d[axis];
+            tDelta[axis] = cellSize[axis] / d[axis];
+        } else if (d[axis] < 0) {
+            step[axis] = -1;
+            tNext[axis] = (gridMin[axis] + cell[axis] * cellSize[axis] - o[axis]) / d[axis];
+            tDelta[axis] = -cellSize[axis] / d[axis];
+        } else {
+            step[axis] = 0;
+            tNext[axis] = std::numeric_limits<double>::infinity();
+            tDelta[axis] = std::numeric_limits<double>::infinity();
+        }
+    }
+
+    // Étape 3: parcours
+    while (true) {
+        const size_t index = (static_cast<size_t>(cell[2]) * resolution[1] + cell[1]) * resolution[0] + cell[0];
+        const int axis = tNext[0] < tNext[1] ? (tNext[0] < tNext[2] ? 0 : 2) : (tNext[1] < tNext[2] ? 1 : 2);
+        const double tExit = tNext[axis];
+
+        const uint32_t first = cellStart[index];
+        const uint32_t count = cellStart[index + 1] - first;
+        if (count > 0 && !visit(&cellObjects[first], count, tExit)) {
+            return;
+        }
+        if (tExit > t1) {
+            return;
+        }
+
+        cell[axis] += step[axis];
+        if (cell[axis] < 0 || cell[axis] >= resolution[axis]) {
+            return;
+        }
+        tNext[axis] += tDelta[axis];
+    }
+}
+
+/**
+ * Test d'un objet, même filtre que les feuilles du BSPTree
+ */
+static inline void intersectObject(SceneObject* obj, Ray& ray, CullingType culling, const Vector3& o,
+                                   Intersection& closestInter, double& closestDistanceSquared) {
+    Intersection intersection;
+    if (!obj->boundingBox.intersects(ray)) {
+        return;
+    }
+    if (obj->intersects(ray, intersection, culling)) {
+        intersection.Distance = (intersection.Position - o).lengthSquared();
+        if (closestDistanceSquared < 0 || intersection.Distance < closestDistanceSquared) {
+            closestDistanceSquared = intersection.Distance;
+            closestInter = intersection;
+        }
+    }
+}
+
+static inline bool occludedObject(SceneObject* obj, Ray& ray, double maxDistance) {
+    if (!obj->boundingBox.intersects(ray)) {
+        return false;
+    }
+    return obj->occluded(ray, maxDistance);
+}
+
+void UniformGrid::intersectPrimitive(uint32_t index, Ray& ray, CullingType culling, const Vector3& o,
+                                     Intersection& closestInter, double& closestDistanceSquared) const {
+    if (primitives) {
+        primitives->intersect(&index, 1, ray, culling, closestInter, closestDistanceSquared);
+    } else {
+        intersectObject(objects[index], ray, culling, o, closestInter, closestDistanceSquared);
+    }
+}
+
+bool UniformGrid::occludedPrimitive(uint32_t index, Ray& ray, double maxDistance) const {
+    return primitives ? primitives->occluded(&index, 1, ray, maxDistance) : occludedObject(objects[index], ray, maxDistance);
+}
+
+/**
+ * Recherche de l'intersection la plus proche
+ *
+ * - Les cellules sont visitées dans l'ordre du rayon: dès qu'un impact est
+ *   avant la sortie de la cellule courante, aucune cellule suivante ne peut
+ *   faire mieux
+ * - Un objet qui couvre plusieurs cellules n'est testé qu'une fois par rayon
+ *   (boîte aux lettres locale à la requête, donc sans partage entre threads).
+ *   Son impact éventuel, même situé dans une cellule plus lointaine, est déjà
+ *   retenu dans closestInter.
+ */
+bool UniformGrid::closestIntersection(Ray& ray, Intersection& closest, CullingType culling) {
+    Intersection closestInter;
+    double closestDistanceSquared = -1;
+    const Vector3 o = ray.GetPosition();
+
+    for (uint32_t index : unboundedIndices) {
+        intersectPrimitive(index, ray, culling, o, closestInter, closestDistanceSquared);
+    }
+
+    uint32_t mailbox[GRID_MAILBOX_SIZE];
+    std::fill(mailbox, mailbox + GRID_MAILBOX_SIZE, UINT32_MAX);
+
+    // Un impact hors grille (plan) borne déjà le parcours
+    const double tMax = closestDistanceSquared < 0 ? std::numeric_limits<double>::infinity()
+                                                    : std::sqrt(closestDistanceSquared);
+    traverse(ray, tMax, [&](const uint32_t* indices, uint32_t count, double tExit) {
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint32_t index = indices[i];
+            uint32_t& slot = mailbox[index & (GRID_MAILBOX_SIZE - 1)];
+            if (slot == index) {
+                continue;
+            }
+            slot = index;
+            intersectPrimitive(index, ray, culling, o, closestInter, closestDistanceSquared);
+        }
+        return closestDistanceSquared < 0 || closestDistanceSquared > tExit * tExit;
+    });
+
+    closest = closestInter;
+    return closestDistanceSquared > -1;
+}
+
+/**
+ * Requête d'ombre: cellules jusqu'à la lumière, sortie au premier objet bloquant
+ */
+bool UniformGrid::occluded(Ray& ray, double maxDistance) {
+    for (uint32_t index : unboundedIndices) {
+        if (occludedPrimitive(index, ray, maxDistance)) {
+            return true;
+        }
+    }
+
+    uint32_t mailbox[GRID_MAILBOX_SIZE];
+    std::fill(mailbox, mailbox + GRID_MAILBOX_SIZE, UINT32_MAX);
+
+    bool hit = false;
+    traverse(ray, maxDistance, [&](const uint32_t* indices, uint32_t count, double) {
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint32_t index = indices[i];
+            uint32_t& slot = mailbox[index & (GRID_MAILBOX_SIZE - 1)];
+            if (slot == index) {
+                continue;
+            }
+            slot = index;
+            if (occludedPrimitive(index, ray, maxDistance)) {
+                hit = true;
+                return false;
+            }
+        }
+        return true;
+    });
+    return hit;
+}
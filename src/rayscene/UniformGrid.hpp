@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "../raymath/AABB.hpp"
+#include "../raymath/Ray.hpp"
+#include "SceneObject.hpp"
+#include "Accelerator.hpp"
+
+/**
+ * Grille uniforme (accélérateur alternatif au BSPTree)
+ *
+ * Principe:
+ * - La boîte englobante des objets est découpée en cellules de même taille
+ * - Chaque cellule liste les objets dont l'AABB la touche
+ * - Un rayon parcourt les cellules qu'il traverse dans l'ordre (3D-DDA,
+ *   Amanatides & Woo) et s'arrête dès qu'un impact est dans la cellule courante
+ *
+ * Adaptée aux nuages d'objets de tailles voisines (particules, galaxies de
+ * sphères): construction en O(n) sans tri, parcours sans pile.
+ *
+ * Représentation mémoire:
+ * - Les listes des cellules sont concaténées dans un seul tableau
+ *   (cellStart[c] .. cellStart[c + 1]), sans allocation par cellule
+ * - Les objets non bornés (plans) restent hors de la grille, comme dans le BSPTree
+ */
+class UniformGrid : public Accelerator {
+public:
+    UniformGrid();
+    ~UniformGrid();
+
+    AcceleratorType getType() const override { return ACCELERATOR_GRID; }
+
+    /**
+     * Construit la grille; la résolution découle du nombre d'objets et des bornes
+     * (environ GRID_CELLS_PER_OBJECT cellules par objet, aussi cubiques que possible)
+     * @param objects Liste des objets de la scène (boundingBox à jour)
+     */
+    void build(std::vector<SceneObject*>& objects) override;
+    void build(const PrimitiveSet& primitives) override;
+
+    /**
+     * Trouve l'intersection la plus proche le long du rayon
+     * @param closest Intersection la plus proche (Distance = distance au carré)
+     * @return true si un objet a été touché
+     */
+    bool closestIntersection(Ray& ray, Intersection& closest, CullingType culling) override;
+
+    /**
+     * Requête d'ombre: s'arrête au premier objet qui bloque le rayon avant maxDistance
+     */
+    bool occluded(Ray& ray, double maxDistance) override;
+
+    /**
+     * Résolution de la grille sur chaque axe (0 si vide)
+     */
+    int getResolution(int axis) const { return resolution[axis]; }
+
+private:
+    std::vector<SceneObject*> objects;      // Primitives dans l'ordre fourni à build()
+    const PrimitiveSet* primitives = nullptr;  // Ou primitives compactes, objects reste vide
+    std::vector<uint32_t> cellStart;        // Début de la liste de chaque cellule, plus la fin
+    std::vector<uint32_t> cellObjects;      // Indices dans objects, regroupés par cellule
+    std::vector<uint32_t> unboundedIndices; // Objets non bornés: hors de la grille, testés à part
+
+    double gridMin[3] = {0, 0, 0};
+    double gridMax[3] = {0, 0, 0};
+    double cellSize[3] = {1, 1, 1};
+    int resolution[3] = {0, 0, 0};
+
+    /**
+     * Construction commune aux deux build(), sur objects ou primitives
+     */
+    void buildGrid();
+
+    AABB primitiveBounds(uint32_t prim) const { return primitives ? primitives->bounds(prim) : objects[prim]->boundingBox; }
+
+    /**
+     * Test d'une primitive (SceneObject ou primitive compacte)
+     */
+    void intersectPrimitive(uint32_t index, Ray& ray, CullingType culling, const Vector3& o,
+                            Intersection& closestInter, double& closestDistanceSquared) const;
+    bool occludedPrimitive(uint32_t index, Ray& ray, double maxDistance) const;
+
+    /**
+     * Cellule (sur un axe) contenant la coordonnée value, bornée à la grille
+     */
+    int cellCoordinate(double value, int axis) const;
+
+    /**
+     * Parcours 3D-DDA des cellules traversées par le rayon
+     * Visitor(indices, count, tExit) reçoit la liste d'une cellule et la distance
+     * de sortie de celle-ci; il renvoie false pour arrêter le parcours.
+     */
+    template <typename Visitor>
+    void traverse(Ray& ray, double tMax, Visitor&& visit) const;
+};
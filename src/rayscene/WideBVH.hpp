@@ -0,0 +1,340 @@
+#pragma once
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include "../raymath/Vector3.hpp"
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define WIDE_BVH_SSE
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define WIDE_BVH_NEON
+#endif
+
+/**
+ * BVH large (4 ou 8 enfants par nœud)
+ *
+ * Obtenu en aplatissant l'arbre binaire de BSPTree (voir BSPTree::collapse):
+ * chaque nœud large regroupe jusqu'à N sous-arbres, testés en une seule fois
+ * par un test de dalles vectoriel (SSE/AVX sur x86, NEON sur ARM, boucle
+ * scalaire sinon). Deux fois moins de niveaux pour un BVH4, trois fois moins
+ * pour un BVH8.
+ *
+ * Représentation mémoire (SoA):
+ * - bounds[k][i] = borne k (minX, minY, minZ, maxX, maxY, maxZ) de l'enfant i
+ * - les 4 (resp. 8) valeurs d'une même borne sont contiguës: un seul chargement vectoriel
+ * - BVH4: 128 octets (2 lignes de cache), BVH8: 256 octets
+ */
+
+// Bit de poids fort de primCount: l'enfant est une feuille (même convention que BSPNode)
+static const uint32_t WIDE_LEAF_FLAG = 0x80000000u;
+
+template <int N>
+struct alignas(64) BSPWideNode {
+    float bounds[6][N];      // Bornes des enfants, SoA
+    uint32_t child[N];       // Enfant interne: index du nœud large / feuille: premier indice de primitive
+    uint32_t primCount[N];   // Enfant interne: 0 / feuille: nombre de primitives | WIDE_LEAF_FLAG
+
+    bool isLeaf(int i) const { return (primCount[i] & WIDE_LEAF_FLAG) != 0; }
+    uint32_t count(int i) const { return primCount[i] & ~WIDE_LEAF_FLAG; }
+};
+
+static_assert(sizeof(BSPWideNode<4>) == 128, "BSPWideNode<4> doit tenir sur 2 lignes de cache");
+static_assert(sizeof(BSPWideNode<8>) == 256, "BSPWideNode<8> doit tenir sur 4 lignes de cache");
+
+/**
+ * Rayon préparé pour le test de dalles vectoriel
+ *
+ * Le signe de chaque composante de la direction désigne une fois pour toutes
+ * la borne d'entrée (near) et de sortie (far) sur chaque axe: plus de min/max
+ * par enfant, et une boîte vide (min = +inf, max = -inf) n'est jamais touchée.
+ */
+struct WideRay {
+    float origin[3];
+    float dirInv[3];
+    int nearBound[3];  // Indice dans bounds de la borne d'entrée sur chaque axe
+    int farBound[3];
+
+    WideRay(Vector3 const& o, Vector3 const& dInv) {
+        const double d[3] = {dInv.x, dInv.y, dInv.z};
+        const double p[3] = {o.x, o.y, o.z};
+        for (int axis = 0; axis < 3; ++axis) {
+            origin[axis] = static_cast<float>(p[axis]);
+            dirInv[axis] = static_cast<float>(d[axis]);
+            bool negative = std::signbit(d[axis]);
+            nearBound[axis] = negative ? axis + 3 : axis;
+            farBound[axis] = negative ? axis : axis + 3;
+        }
+    }
+};
+
+// Distances initiales: chaque axe réduit l'intervalle, sauf s'il donne NaN (voir intersectWide4)
+static const float WIDE_INFINITY = std::numeric_limits<float>::infinity();
+
+// Marges relatives sur les distances calculées en float: le test reste conservatif.
+// L'origine du rayon est elle aussi arrondie en float: avec 4 FLT_EPSILON, un rayon
+// qui visait exactement un sommet pouvait manquer la boîte du seul triangle touché
+static const float WIDE_NEAR_SCALE = 1.0f - 16 * FLT_EPSILON;
+static const float WIDE_FAR_SCALE = 1.0f + 16 * FLT_EPSILON;
+
+/**
+ * Test de dalles sur 4 enfants consécutifs à partir de first
+ *
+ * Un rayon parallèle à un axe dont l'origine est dans le plan d'une face donne
+ * 0 * inf = NaN: l'intervalle courant est alors gardé (maxps/minps renvoient
+ * leur second opérande si l'un des deux est NaN, vmaxnm/vminnm le nombre),
+ * la face ne le réduit pas et la boîte reste fermée.
+ * @param tEntry distances d'entrée des 4 enfants
+ * @return masque des enfants touchés (bit i = enfant first + i)
+ */
+template <int N>
+inline int intersectWide4(const BSPWideNode<N>& node, int first, const WideRay& ray, float* tEntry) {
+#if defined(WIDE_BVH_SSE)
+    __m128 tNear = _mm_set1_ps(-WIDE_INFINITY);
+    __m128 tFar = _mm_set1_ps(WIDE_INFINITY);
+    for (int axis = 0; axis < 3; ++axis) {
+        const __m128 o = _mm_set1_ps(ray.origin[axis]);
+        const __m128 dInv = _mm_set1_ps(ray.dirInv[axis]);
+        const __m128 tn = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(&node.bounds[ray.nearBound[axis]][first]), o), dInv);
+        const __m128 tf = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(&node.bounds[ray.farBound[axis]][first]), o), dInv);
+        tNear = _mm_max_ps(tn, tNear);
+        tFar = _mm_min_ps(tf, tFar);
+    }
+    tNear = _mm_mul_ps(tNear, _mm_set1_ps(WIDE_NEAR_SCALE));
+    tFar = _mm_mul_ps(tFar, _mm_set1_ps(WIDE_FAR_SCALE));
+    _mm_storeu_ps(tEntry, tNear);
+    const __m128 hit = _mm_and_ps(_mm_cmple_ps(tNear, tFar), _mm_cmpgt_ps(tFar, _mm_setzero_ps()));
+    return _mm_movemask_ps(hit);
+#elif defined(WIDE_BVH_NEON)
+    float32x4_t tNear = vdupq_n_f32(-WIDE_INFINITY);
+    float32x4_t tFar = vdupq_n_f32(WIDE_INFINITY);
+    for (int axis = 0; axis < 3; ++axis) {
+        const float32x4_t o = vdupq_n_f32(ray.origin[axis]);
+        const float32x4_t dInv = vdupq_n_f32(ray.dirInv[axis]);
+        const float32x4_t tn = vmulq_f32(vsubq_f32(vld1q_f32(&node.bounds[ray.nearBound[axis]][first]), o), dInv);
+        const float32x4_t tf = vmulq_f32(vsubq_f32(vld1q_f32(&node.bounds[ray.farBound[axis]][first]), o), dInv);
+        tNear = vmaxnmq_f32(tNear, tn);
+        tFar = vminnmq_f32(tFar, tf);
+    }
+    tNear = vmulq_n_f32(tNear, WIDE_NEAR_SCALE);
+    tFar = vmulq_n_f32(tFar, WIDE_FAR_SCALE);
+    vst1q_f32(tEntry, tNear);
+    const uint32x4_t hit = vandq_u32(vcleq_f32(tNear, tFar), vcgtq_f32(tFar, vdupq_n_f32(0)));
+    const uint32_t bits[4] = {1, 2, 4, 8};
+    return static_cast<int>(vaddvq_u32(vandq_u32(hit, vld1q_u32(bits))));
+#else
+    int mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        float tNear = -WIDE_INFINITY;
+        float tFar = WIDE_INFINITY;
+        for (int axis = 0; axis < 3; ++axis) {
+            float tn = (node.bounds[ray.nearBound[axis]][first + i] - ray.origin[axis]) * ray.dirInv[axis];
+            float tf = (node.bounds[ray.farBound[axis]][first + i] - ray.origin[axis]) * ray.dirInv[axis];
+            tNear = tn > tNear ? tn : tNear;
+            tFar = tf < tFar ? tf : tFar;
+        }
+        tNear *= WIDE_NEAR_SCALE;
+        tFar *= WIDE_FAR_SCALE;
+        tEntry[i] = tNear;
+        if (tNear <= tFar && tFar > 0) {
+            mask |= 1 << i;
+        }
+    }
+    return mask;
+#endif
+}
+
+/**
+ * Test de dalles sur les N enfants d'un nœud large
+ * @return masque des enfants touchés
+ */
+template <int N>
+inline int intersectWide(const BSPWideNode<N>& node, const WideRay& ray, float* tEntry) {
+    int mask = 0;
+    for (int first = 0; first < N; first += 4) {
+        mask |= intersectWide4(node, first, ray, tEntry + first) << first;
+    }
+    return mask;
+}
+
+#if defined(__AVX__)
+/**
+ * BVH8 avec AVX: les 8 enfants en un seul test sur 256 bits
+ */
+template <>
+inline int intersectWide<8>(const BSPWideNode<8>& node, const WideRay& ray, float* tEntry) {
+    __m256 tNear = _mm256_set1_ps(-WIDE_INFINITY);
+    __m256 tFar = _mm256_set1_ps(WIDE_INFINITY);
+    for (int axis = 0; axis < 3; ++axis) {
+        const __m256 o = _mm256_set1_ps(ray.origin[axis]);
+        const __m256 dInv = _mm256_set1_ps(ray.dirInv[axis]);
+        const __m256 tn = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(node.bounds[ray.nearBound[axis]]), o), dInv);
+        const __m256 tf = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(node.bounds[ray.farBound[axis]]), o), dInv);
+        tNear = _mm256_max_ps(tn, tNear);
+        tFar = _mm256_min_ps(tf, tFar);
+    }
+    tNear = _mm256_mul_ps(tNear, _mm256_set1_ps(WIDE_NEAR_SCALE));
+    tFar = _mm256_mul_ps(tFar, _mm256_set1_ps(WIDE_FAR_SCALE));
+    _mm256_storeu_ps(tEntry, tNear);
+    const __m256 hit = _mm256_and_ps(_mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ),
+                                     _mm256_cmp_ps(tFar, _mm256_setzero_ps(), _CMP_GT_OQ));
+    return _mm256_movemask_ps(hit);
+}
+#endif
+
+/**
+ * Nœud large compressé: bornes des enfants quantifiées sur 8 ou 16 bits (Q)
+ *
+ * Les bornes sont relatives à la boîte du nœud (union des enfants):
+ *   borne = origin[axe] + q * 2^exponent[axe]
+ * L'échelle étant une puissance de deux, q * 2^e est exact en float et le
+ * décodage ne fait qu'un arrondi, reproduit à l'encodage pour garantir que
+ * chaque boîte décodée englobe la boîte d'origine (min arrondi vers le bas,
+ * max vers le haut).
+ *
+ * Tailles: BVH4 72 octets (8 bits) / 96 (16 bits), BVH8 128 / 176,
+ * contre 128 et 256 octets pour les nœuds float.
+ */
+
+// Exposant réservé: axe non borné (plans), décodé en [-inf, +inf]
+static const int8_t QUANT_UNBOUNDED = -128;
+
+/**
+ * 2^e en float, construit directement par ses bits (e dans [-126, 127])
+ */
+inline float exp2Float(int e) {
+    uint32_t bits = static_cast<uint32_t>(e + 127) << 23;
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+template <int N, typename Q>
+struct BSPQuantizedNode {
+    float origin[3];         // Coin min de la boîte du nœud
+    int8_t exponent[3];      // Pas de quantification 2^exponent par axe
+    uint8_t padding;
+    Q qBounds[6][N];         // Bornes quantifiées des enfants, SoA (même ordre que BSPWideNode)
+    uint32_t child[N];
+    uint32_t primCount[N];
+
+    static const uint32_t Q_MAX = static_cast<Q>(~Q(0));
+
+    bool isLeaf(int i) const { return (primCount[i] & WIDE_LEAF_FLAG) != 0; }
+    uint32_t count(int i) const { return primCount[i] & ~WIDE_LEAF_FLAG; }
+
+    static float dequantize(float origin, uint32_t q, float scale) {
+        return origin + static_cast<float>(q) * scale;
+    }
+
+    /**
+     * Encode un nœud float (les enfants vides gardent une boîte inversée)
+     */
+    void encode(const BSPWideNode<N>& node) {
+        for (int axis = 0; axis < 3; ++axis) {
+            // Boîte du nœud = union des enfants non vides
+            float lo = std::numeric_limits<float>::infinity();
+            float hi = -std::numeric_limits<float>::infinity();
+            for (int i = 0; i < N; ++i) {
+                if (node.bounds[axis][i] <= node.bounds[axis + 3][i]) {
+                    lo = std::min(lo, node.bounds[axis][i]);
+                    hi = std::max(hi, node.bounds[axis + 3][i]);
+                }
+            }
+
+            if (!std::isfinite(lo) || !std::isfinite(hi)) {
+                origin[axis] = 0;
+                exponent[axis] = QUANT_UNBOUNDED;
+                for (int i = 0; i < N; ++i) {
+                    qBounds[axis][i] = 0;
+                    qBounds[axis + 3][i] = 0;
+                }
+                continue;
+            }
+
+            // Plus petit pas 2^e tel que Q_MAX pas couvrent la boîte
+            int e;
+            std::frexp((static_cast<double>(hi) - lo) / Q_MAX, &e);
+            e = std::max(e, -125);
+            while (dequantize(lo, Q_MAX, exp2Float(e)) < hi) {
+                ++e;
+            }
+            const float scale = exp2Float(e);
+            origin[axis] = lo;
+            exponent[axis] = static_cast<int8_t>(e);
+
+            for (int i = 0; i < N; ++i) {
+                const float childMin = node.bounds[axis][i];
+                const float childMax = node.bounds[axis + 3][i];
+                if (childMin > childMax) {
+                    // Enfant vide: boîte inversée
+                    qBounds[axis][i] = static_cast<Q>(Q_MAX);
+                    qBounds[axis + 3][i] = 0;
+                    continue;
+                }
+                double qMin = std::floor((static_cast<double>(childMin) - lo) / scale);
+                double qMax = std::ceil((static_cast<double>(childMax) - lo) / scale);
+                uint32_t qLo = static_cast<uint32_t>(std::min<double>(std::max(qMin, 0.0), Q_MAX));
+                uint32_t qHi = static_cast<uint32_t>(std::min<double>(std::max(qMax, 0.0), Q_MAX));
+                // Arrondi conservatif vérifié avec le calcul exact du décodage
+                while (qLo > 0 && dequantize(lo, qLo, scale) > childMin) {
+                    --qLo;
+                }
+                while (qHi < Q_MAX && dequantize(lo, qHi, scale) < childMax) {
+                    ++qHi;
+                }
+                qBounds[axis][i] = static_cast<Q>(qLo);
+                qBounds[axis + 3][i] = static_cast<Q>(qHi);
+            }
+        }
+        padding = 0;
+        for (int i = 0; i < N; ++i) {
+            child[i] = node.child[i];
+            primCount[i] = node.primCount[i];
+        }
+    }
+
+    /**
+     * Décode les bornes pour le test de dalles vectoriel
+     */
+    void decode(BSPWideNode<N>& node) const {
+        for (int axis = 0; axis < 3; ++axis) {
+            if (exponent[axis] == QUANT_UNBOUNDED) {
+                for (int i = 0; i < N; ++i) {
+                    node.bounds[axis][i] = -std::numeric_limits<float>::infinity();
+                    node.bounds[axis + 3][i] = std::numeric_limits<float>::infinity();
+                }
+                continue;
+            }
+            // Copies locales: Q = uint8_t peut pointer n'importe où (aliasing),
+            // ce qui empêcherait la vectorisation des boucles suivantes
+            const float base = origin[axis];
+            const float scale = exp2Float(exponent[axis]);
+            Q qMin[N];
+            Q qMax[N];
+            std::memcpy(qMin, qBounds[axis], sizeof(qMin));
+            std::memcpy(qMax, qBounds[axis + 3], sizeof(qMax));
+            float decodedMin[N];
+            float decodedMax[N];
+            for (int i = 0; i < N; ++i) {
+                decodedMin[i] = dequantize(base, qMin[i], scale);
+                decodedMax[i] = dequantize(base, qMax[i], scale);
+            }
+            std::memcpy(node.bounds[axis], decodedMin, sizeof(decodedMin));
+            std::memcpy(node.bounds[axis + 3], decodedMax, sizeof(decodedMax));
+        }
+        for (int i = 0; i < N; ++i) {
+            node.child[i] = child[i];
+            node.primCount[i] = primCount[i];
+        }
+    }
+};
+
+static_assert(sizeof(BSPQuantizedNode<4, uint8_t>) == 72, "BSPQuantizedNode<4, uint8_t> doit faire 72 octets");
+static_assert(sizeof(BSPQuantizedNode<4, uint16_t>) == 96, "BSPQuantizedNode<4, uint16_t> doit faire 96 octets");
+static_assert(sizeof(BSPQuantizedNode<8, uint8_t>) == 128, "BSPQuantizedNode<8, uint8_t> doit faire 128 octets");
+static_assert(sizeof(BSPQuantizedNode<8, uint16_t>) == 176, "BSPQuantizedNode<8, uint16_t> doit faire 176 octets");
@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "AcceleratorChecker.hpp"
+#include "BSPTree.hpp"
+#include "Scene.hpp"
+
+/*
+ * TEST: Modifications incrémentales du BVH (insert / remove / refit)
+ * Suite aléatoire d'insertions et de suppressions (plans compris) sur des arbres
+ * de largeur 2, 4 et 8: après chaque lot, puis après le refit du prepare()
+ * suivant, les impacts et les ombres doivent être ceux du test linéaire sur
+ * les objets présents. Une population constante ne doit pas faire grossir
+ * les indices des feuilles (emplacements libérés réutilisés).
+ * Dans une Scene, de petits déplacements se rattrapent par un refit; des objets
+ * échangés d'un bout à l'autre de la scène dégradent le coût SAH au-delà de
+ * BSP_REFIT_MAX_DEGRADATION et prepare() doit alors reconstruire l'arbre.
+ */
+
+static const int BATCHES = 12;
+static const int EDITS_PER_BATCH = 300;
+
+static bool checkWidth(const TestStructure& structure, std::vector<SceneObject*>& pool, double extent, unsigned int seed) {
+    std::mt19937 rng(seed);
+    const std::string name = structure.name;
+    bool passed = true;
+
+    // Moitié des objets dans l'arbre au départ, l'autre moitié en réserve
+    std::vector<SceneObject*> live(pool.begin(), pool.begin() + pool.size() / 2);
+    std::vector<SceneObject*> spare(pool.begin() + pool.size() / 2, pool.end());
+    std::unique_ptr<Accelerator> tree = AcceleratorChecker::create(structure);
+    tree->build(live);
+
+    size_t refused = 0;
+    size_t indexBytes = 0;
+    for (int batch = 0; batch < BATCHES; batch++) {
+        for (int edit = 0; edit < EDITS_PER_BATCH; edit++) {
+            // Retrait et ajout en alternance aléatoire, population autour de la moitié du réservoir
+            const bool insert = !spare.empty() && (live.empty() || (rng() % (live.size() + spare.size())) < spare.size());
+            std::vector<SceneObject*>& from = insert ? spare : live;
+            std::vector<SceneObject*>& to = insert ? live : spare;
+            const size_t pick = rng() % from.size();
+            SceneObject* object = from[pick];
+            const bool applied = insert ? tree->insert(object) : tree->remove(object);
+            from[pick] = from.back();
+            from.pop_back();
+            to.push_back(object);
+            if (!applied) {
+                // Même repli que Scene: reconstruction au prochain prepare()
+                refused++;
+                tree->build(live);
+            }
+        }
+
+        LinearAccelerator linear(false);
+        linear.build(live);
+        const std::string label = name + " lot " + std::to_string(batch) + " (" + std::to_string(live.size()) + " objets)";
+        passed &= AcceleratorChecker::report(label + " vs linear",
+                                             AcceleratorChecker::compare(*tree, linear, extent, 2000, seed + batch));
+        if (!tree->refit()) {
+            tree->build(live);
+        }
+        passed &= AcceleratorChecker::report(label + " après refit",
+                                             AcceleratorChecker::compare(*tree, linear, extent, 2000, seed + 100 + batch));
+
+        // Indices des feuilles: mesurés après le premier lot, bornés ensuite
+        const size_t bytes = static_cast<BSPTree&>(*tree).getMemoryStats().primIndexBytes;
+        if (batch == 0) {
+            indexBytes = bytes;
+        } else if (bytes > 2 * indexBytes) {
+            std::cerr << "❌ " << name << ": indices des feuilles " << indexBytes << " -> " << bytes
+                      << " octets à population constante" << std::endl;
+            passed = false;
+        }
+    }
+    std::cout << name << ": " << BATCHES * EDITS_PER_BATCH << " modifications, " << refused << " refusées" << std::endl;
+    return passed;
+}
+
+/**
+ * Échange au hasard les positions des objets (même graine, même échange pour
+ * deux scènes remplies de la même façon)
+ */
+static void swapPositions(Scene& scene, unsigned int seed) {
+    std::vector<SceneObject*> objects = scene.getObjects();
+    std::vector<Vector3> positions;
+    for (SceneObject* object : objects) {
+        positions.push_back(object->transform.getPosition());
+    }
+    std::shuffle(positions.begin(), positions.end(), std::mt19937(seed));
+    for (size_t i = 0; i < objects.size(); i++) {
+        objects[i]->transform.setPosition(positions[i]);
+    }
+}
+
+static bool checkDegradation(const TestStructure& structure, const RandomSceneSpec& spec, unsigned int seed) {
+    const std::string name = structure.name;
+    Material material;
+    Scene scene;
+    scene.accelerator = structure.settings();
+    AcceleratorChecker::fillScene(scene, spec, seed, &material);
+    Scene reference;
+    reference.accelerator.type = ACCELERATOR_NONE;
+    AcceleratorChecker::fillScene(reference, spec, seed, &material);
+    scene.prepare();
+    reference.prepare();
+
+    // Arbre témoin sur les mêmes objets, pour lire le coût SAH après refit
+    std::vector<SceneObject*> objects = scene.getObjects();
+    std::unique_ptr<Accelerator> probe = AcceleratorChecker::create(structure);
+    probe->build(objects);
+    BSPTree& probeTree = static_cast<BSPTree&>(*probe);
+    const double builtCost = probeTree.computeSAHCost();
+    bool passed = true;
+
+    // Petits déplacements (au plus 0.2 par axe): refit
+    AcceleratorChecker::moveObjects(scene, 1.0, seed + 1, false);
+    AcceleratorChecker::moveObjects(reference, 1.0, seed + 1, false);
+    scene.prepare();
+    reference.prepare();
+    if (!scene.refitted) {
+        std::cerr << "❌ " << name << ": reconstruit après de petits déplacements" << std::endl;
+        passed = false;
+    }
+    passed &= AcceleratorChecker::report(name + " petits déplacements (refit)",
+                                         AcceleratorChecker::compare(scene, reference, spec.extent, 4000, seed + 2));
+
+    // Positions échangées: les feuilles couvrent toute la scène, reconstruction
+    swapPositions(scene, seed + 3);
+    swapPositions(reference, seed + 3);
+    scene.prepare();
+    reference.prepare();
+    const bool probeRefitted = probe->refit();
+    const double refitCost = probeTree.computeSAHCost();
+    std::cout << name << ": coût SAH " << builtCost << " à la construction, " << refitCost
+              << " après refit des positions échangées" << std::endl;
+    if (probeRefitted || refitCost <= builtCost * BSP_REFIT_MAX_DEGRADATION) {
+        std::cerr << "❌ " << name << ": coût après refit sous BSP_REFIT_MAX_DEGRADATION" << std::endl;
+        passed = false;
+    }
+    if (scene.refitted) {
+        std::cerr << "❌ " << name << ": refit gardé malgré la dégradation du coût SAH" << std::endl;
+        passed = false;
+    }
+    passed &= AcceleratorChecker::report(name + " positions échangées (reconstruit)",
+                                         AcceleratorChecker::compare(scene, reference, spec.extent, 4000, seed + 4));
+    return passed;
+}
+
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "=== Test: BVH insert / remove / refit   ===" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    bool all_passed = true;
+    Material material;
+
+    RandomSceneSpec spec;
+    spec.spheres = 500;
+    spec.triangles = 500;
+    spec.planes = 3;
+    std::vector<SceneObject*> pool = AcceleratorChecker::createObjects(spec, 40, &material);
+    std::shuffle(pool.begin(), pool.end(), std::mt19937(41));
+
+    for (const TestStructure& structure : AcceleratorChecker::structures({"bvh2", "bvh4", "bvh8"})) {
+        all_passed &= checkWidth(structure, pool, spec.extent, 50 + structure.width);
+    }
+
+    for (SceneObject* object : pool) {
+        delete object;
+    }
+
+    RandomSceneSpec sceneSpec;
+    sceneSpec.spheres = 400;
+    sceneSpec.triangles = 400;
+    for (const TestStructure& structure : AcceleratorChecker::structures({"bvh2", "bvh4"})) {
+        all_passed &= checkDegradation(structure, sceneSpec, 60 + structure.width);
+    }
+
+    std::cout << "============================================" << std::endl;
+    if (all_passed) {
+        std::cout << "✅ BVH modifié identique au test linéaire" << std::endl;
+        std::cout << "============================================" << std::endl;
+        return 0;
+    }
+    std::cerr << "❌ BVH modifié différent du test linéaire" << std::endl;
+    std::cout << "============================================" << std::endl;
+    return 1;
+}
@@ -0,0 +1,108 @@
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "AcceleratorChecker.hpp"
+#include "Mesh.hpp"
+#include "MeshGeometry.hpp"
+#include "Scene.hpp"
+
+/*
+ * TEST: Meshes aplatis dans la structure de la scène (flattenMeshes)
+ * Instances d'une même géométrie, tournées et en partie imbriquées, au milieu
+ * de sphères et de triangles: la scène aplatie (un seul niveau, triangles en
+ * espace monde) doit donner les mêmes impacts et les mêmes ombres que la scène
+ * à un arbre par mesh, pour chaque structure; puis après déplacement des
+ * instances (refit). La structure des triangles des meshes aplatis n'est
+ * jamais construite.
+ */
+
+static const std::vector<TestStructure> STRUCTURES = AcceleratorChecker::structures(
+    {"bvh2", "bvh4", "bvh8-q16", "lbvh", "sbvh", "grid", "kdtree"});
+
+static const char* OBJ_PATH = "tests/scenes/objects/icosphere.obj";
+static const int INSTANCES = 12;
+static const int RAYS = 8000;
+
+/**
+ * Ajoute les instances de la géométrie, placées et tournées selon la graine
+ */
+static void addInstances(Scene& scene, std::shared_ptr<MeshGeometry> geometry, double extent, unsigned int seed,
+                         Material* material) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coordinate(-0.3 * extent, 0.3 * extent);
+    std::uniform_real_distribution<double> angle(0.0, 360.0);
+    for (int i = 0; i < INSTANCES; i++) {
+        Mesh* mesh = new Mesh();
+        mesh->setGeometry(geometry);
+        mesh->transform.setPosition(Vector3(coordinate(rng), coordinate(rng), coordinate(rng)));
+        mesh->transform.setRotation(Vector3(angle(rng), angle(rng), angle(rng)));
+        mesh->material = material;
+        scene.add(mesh);
+    }
+}
+
+static bool checkStructure(const TestStructure& structure, const RandomSceneSpec& spec, unsigned int seed) {
+    Material material;
+    std::shared_ptr<MeshGeometry> flatGeometry = std::make_shared<MeshGeometry>();
+    flatGeometry->loadFromObj(OBJ_PATH);
+    std::shared_ptr<MeshGeometry> nestedGeometry = std::make_shared<MeshGeometry>();
+    nestedGeometry->loadFromObj(OBJ_PATH);
+
+    Scene flat;
+    flat.flattenMeshes = true;
+    flat.accelerator = structure.settings();
+    AcceleratorChecker::fillScene(flat, spec, seed, &material);
+    addInstances(flat, flatGeometry, spec.extent, seed + 1, &material);
+    Scene nested;
+    nested.accelerator = structure.settings();
+    AcceleratorChecker::fillScene(nested, spec, seed, &material);
+    addInstances(nested, nestedGeometry, spec.extent, seed + 1, &material);
+
+    flat.prepare();
+    nested.prepare();
+    const std::string label = std::string("flattenMeshes ") + structure.name;
+    bool passed = AcceleratorChecker::report(label + " vs arbres par mesh",
+                                             AcceleratorChecker::compare(flat, nested, spec.extent, RAYS, seed + 2));
+
+    AcceleratorChecker::moveObjects(flat, spec.extent, seed + 3, false);
+    AcceleratorChecker::moveObjects(nested, spec.extent, seed + 3, false);
+    flat.prepare();
+    nested.prepare();
+    passed &= AcceleratorChecker::report(label + " déplacés",
+                                         AcceleratorChecker::compare(flat, nested, spec.extent, RAYS, seed + 4));
+
+    if (flatGeometry->getBuildCount() != 0 || nestedGeometry->getBuildCount() != 1) {
+        std::cerr << "❌ " << structure.name << ": structure des triangles construite " << flatGeometry->getBuildCount()
+                  << " fois (aplatis), " << nestedGeometry->getBuildCount() << " fois (arbres par mesh)" << std::endl;
+        passed = false;
+    }
+    return passed;
+}
+
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "=== Test: Meshes aplatis                ===" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    bool all_passed = true;
+
+    RandomSceneSpec spec;
+    spec.spheres = 200;
+    spec.triangles = 200;
+    spec.planes = 1;
+    for (const TestStructure& structure : STRUCTURES) {
+        all_passed &= checkStructure(structure, spec, 140);
+    }
+
+    std::cout << "============================================" << std::endl;
+    if (all_passed) {
+        std::cout << "✅ Meshes aplatis identiques aux arbres par mesh" << std::endl;
+        std::cout << "============================================" << std::endl;
+        return 0;
+    }
+    std::cerr << "❌ Meshes aplatis différents des arbres par mesh" << std::endl;
+    std::cout << "============================================" << std::endl;
+    return 1;
+}
@@ -0,0 +1,80 @@
+#include <iostream>
+#include <vector>
+#include "AcceleratorChecker.hpp"
+#include "KdTree.hpp"
+
+/*
+ * TEST: Kd-tree
+ * 1. Impacts et ombres identiques au test linéaire sur des scènes aléatoires
+ *    (plans hors de l'arbre, objets de scène et mesh indexé)
+ * 2. Fuites par les plans de coupe: un cube maillé sur une grille régulière
+ *    place les plans de coupe exactement sur les arêtes; les rayons tirés de
+ *    l'intérieur le long de ces plans (direction parallèle aux axes) et vers
+ *    les sommets et les arêtes doivent tous toucher le cube (de même pour
+ *    une icosphère)
+ */
+
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "=== Test: Kd-tree                       ===" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    const int rays = 20000;
+    bool all_passed = true;
+    Material material;
+
+    // 1. Scènes aléatoires
+    RandomSceneSpec spec;
+    spec.spheres = 800;
+    spec.triangles = 800;
+    spec.planes = 2;
+    std::vector<SceneObject*> objects = AcceleratorChecker::createObjects(spec, 30, &material);
+    LinearAccelerator linear(false);
+    linear.build(objects);
+    KdTree tree;
+    tree.build(objects);
+    std::cout << "Objets: " << tree.getNodeCount() << " nœuds, " << tree.getReferenceCount() << " références" << std::endl;
+    all_passed &= AcceleratorChecker::report("objets kdtree vs linear",
+                                             AcceleratorChecker::compare(tree, linear, spec.extent, rays, 31));
+    for (SceneObject* object : objects) {
+        delete object;
+    }
+
+    TriangleMesh sphere;
+    AcceleratorChecker::addIcosphere(sphere, 3, 5.0);
+    LinearAccelerator sphereLinear(false);
+    sphereLinear.build(sphere);
+    KdTree sphereTree;
+    sphereTree.build(sphere);
+    all_passed &= AcceleratorChecker::report("mesh kdtree vs linear",
+                                             AcceleratorChecker::compare(sphereTree, sphereLinear, 10.0, rays, 32));
+
+    // 2. Rayons le long des plans de coupe
+    TriangleMesh cube;
+    AcceleratorChecker::addTessellatedCube(cube, 8, 1.0);
+    KdTree cubeTree;
+    cubeTree.build(cube);
+    std::vector<Ray> cubeRays = AcceleratorChecker::gridAxisRays(8, 1.0);
+    const Vector3 origins[3] = {Vector3(0, 0, 0), Vector3(0.25, -0.5, 0.125), Vector3(0.1, 0.2, 0.3)};
+    for (const Vector3& origin : origins) {
+        std::vector<Ray> edge = AcceleratorChecker::edgeRays(cube, origin, 4);
+        cubeRays.insert(cubeRays.end(), edge.begin(), edge.end());
+    }
+    all_passed &= AcceleratorChecker::report("cube kdtree, plans de coupe",
+                                             AcceleratorChecker::countLeaks(cubeTree, cubeRays, 10.0));
+
+    // Icosphère: rayons du centre vers les sommets et les arêtes
+    std::vector<Ray> sphereRays = AcceleratorChecker::edgeRays(sphere, Vector3(0.1, -0.2, 0.3), 8);
+    all_passed &= AcceleratorChecker::report("icosphère kdtree, sommets et arêtes",
+                                             AcceleratorChecker::countLeaks(sphereTree, sphereRays, 20.0));
+
+    std::cout << "============================================" << std::endl;
+    if (all_passed) {
+        std::cout << "✅ Kd-tree identique au test linéaire, sans fuite" << std::endl;
+        std::cout << "============================================" << std::endl;
+        return 0;
+    }
+    std::cerr << "❌ Kd-tree: différences ou fuites" << std::endl;
+    std::cout << "============================================" << std::endl;
+    return 1;
+}
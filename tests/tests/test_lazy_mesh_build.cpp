@@ -0,0 +1,101 @@
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include "Intersection.hpp"
+#include "Mesh.hpp"
+#include "MeshGeometry.hpp"
+#include "Parallel.hpp"
+#include "Scene.hpp"
+
+/*
+ * TEST: Construction paresseuse des structures des meshes
+ * La structure des triangles n'est construite qu'au premier rayon, et une seule
+ * fois quand plusieurs threads (parallelFor, comme le rendu) atteignent en même
+ * temps la même géométrie, directement ou par deux instances qui la partagent
+ */
+
+static const char* OBJ_PATH = "tests/scenes/objects/icosphere.obj";
+static const unsigned int THREADS = 8;
+static const int ROUNDS = 20;
+
+/**
+ * Tous les threads partent ensemble et lancent leurs rayons sur la scène
+ * @return nombre de rayons qui ont manqué la sphère
+ */
+static int fireTogether(Scene& scene) {
+    std::atomic<unsigned int> ready{0};
+    std::atomic<int> misses{0};
+    parallelFor(0, THREADS, THREADS, [&](size_t first, size_t last, unsigned int) {
+        ready++;
+        while (ready.load() < THREADS) {
+            std::this_thread::yield();
+        }
+        for (size_t i = first; i < last; i++) {
+            // Vers le centre de l'une ou l'autre instance (x = -2 et x = 2)
+            const double x = i % 2 == 0 ? -2.0 : 2.0;
+            Ray ray(Vector3(x, 0.1 * i, -10), Vector3(0, 0, 1));
+            Intersection hit;
+            if (!scene.closestIntersection(ray, hit, CULLING_BOTH) || !scene.occluded(ray, 20.0)) {
+                misses++;
+            }
+        }
+    });
+    return misses.load();
+}
+
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "=== Test: Construction paresseuse       ===" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    bool all_passed = true;
+    Material material;
+    std::shared_ptr<MeshGeometry> geometry = std::make_shared<MeshGeometry>();
+    geometry->loadFromObj(OBJ_PATH);
+    if (geometry->getTriangleCount() == 0) {
+        std::cerr << "❌ " << OBJ_PATH << " introuvable ou vide" << std::endl;
+        return 1;
+    }
+
+    // Deux instances de la même géométrie
+    Scene scene;
+    for (double x : {-2.0, 2.0}) {
+        Mesh* mesh = new Mesh();
+        mesh->setGeometry(geometry);
+        mesh->transform.setPosition(Vector3(x, 0, 0));
+        mesh->material = &material;
+        scene.add(mesh);
+    }
+    scene.prepare();
+    if (geometry->getBuildCount() != 0) {
+        std::cerr << "❌ Structure construite par prepare(), avant tout rayon" << std::endl;
+        all_passed = false;
+    }
+
+    // Chaque tour oublie la structure: la course à la construction recommence
+    for (int round = 0; round < ROUNDS; round++) {
+        if (round > 0) {
+            geometry->invalidate();
+        }
+        const int misses = fireTogether(scene);
+        const unsigned int builds = geometry->getBuildCount();
+        if (misses != 0 || builds != static_cast<unsigned int>(round + 1)) {
+            std::cerr << "❌ Tour " << round << ": " << misses << " rayons perdus, "
+                      << builds << " constructions au total (attendu " << round + 1 << ")" << std::endl;
+            all_passed = false;
+        }
+    }
+    std::cout << THREADS << " threads, " << ROUNDS << " tours: " << geometry->getBuildCount()
+              << " constructions" << std::endl;
+
+    std::cout << "============================================" << std::endl;
+    if (all_passed) {
+        std::cout << "✅ Une seule construction par géométrie" << std::endl;
+        std::cout << "============================================" << std::endl;
+        return 0;
+    }
+    std::cerr << "❌ Construction paresseuse incorrecte" << std::endl;
+    std::cout << "============================================" << std::endl;
+    return 1;
+}
@@ -0,0 +1,161 @@
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "AcceleratorChecker.hpp"
+#include "BSPTree.hpp"
+#include "Sphere.hpp"
+#include "Triangle.hpp"
+#include "TriangleMesh.hpp"
+
+/*
+ * TEST: Constructeur LBVH (codes de Morton)
+ * Comparé directement au test linéaire, en largeur 2 et 4:
+ * 1. Scène aléatoire (sphères et triangles)
+ * 2. Codes de Morton identiques: sphères concentriques, triangles de même
+ *    centre et amas plus petit qu'une cellule de la grille de Morton
+ * 3. Tous les centres confondus (boîte des centres réduite à un point)
+ * 4. Une seule primitive (objet et TriangleMesh)
+ */
+
+static const int RAYS = 6000;
+
+static Sphere* createSphere(const Vector3& center, double radius, Material* material) {
+    Sphere* sphere = new Sphere(radius);
+    sphere->transform.setPosition(center);
+    sphere->material = material;
+    sphere->applyTransform();
+    sphere->calculateBoundingBox();
+    return sphere;
+}
+
+/**
+ * Triangles de centre exactement center, orientations aléatoires
+ */
+static void addCenteredTriangles(TriangleMesh& mesh, const Vector3& center, int count, double size, std::mt19937& rng) {
+    std::uniform_real_distribution<double> offset(-size, size);
+    for (int i = 0; i < count; i++) {
+        const Vector3 u(offset(rng), offset(rng), offset(rng));
+        const Vector3 v(offset(rng), offset(rng), offset(rng));
+        const uint32_t first = mesh.addVertex(center + u);
+        mesh.addVertex(center + v);
+        mesh.addVertex(center - u - v);
+        mesh.addTriangle(first, first + 1, first + 2);
+    }
+}
+
+/**
+ * Compare le LBVH au test linéaire sur les objets puis sur le mesh
+ */
+static bool check(const TestStructure& structure, const std::string& label, std::vector<SceneObject*>& objects,
+                  const TriangleMesh& mesh, double extent, unsigned int seed) {
+    bool passed = true;
+    const std::string name = label + " " + structure.name + " w" + std::to_string(structure.width);
+    if (!objects.empty()) {
+        std::unique_ptr<Accelerator> lbvh = AcceleratorChecker::create(structure);
+        lbvh->build(objects);
+        if (static_cast<BSPTree&>(*lbvh).getBuildStrategy() != BUILD_LBVH) {
+            std::cerr << "❌ " << name << ": arbre construit sans LBVH" << std::endl;
+            passed = false;
+        }
+        LinearAccelerator linear(false);
+        linear.build(objects);
+        passed &= AcceleratorChecker::report(name + " objets vs linear",
+                                             AcceleratorChecker::compare(*lbvh, linear, extent, RAYS, seed));
+    }
+    if (mesh.size() > 0) {
+        std::unique_ptr<Accelerator> lbvh = AcceleratorChecker::create(structure);
+        lbvh->build(mesh);
+        LinearAccelerator linear(false);
+        linear.build(mesh);
+        passed &= AcceleratorChecker::report(name + " mesh vs linear",
+                                             AcceleratorChecker::compare(*lbvh, linear, extent, RAYS, seed + 1));
+    }
+    return passed;
+}
+
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "=== Test: LBVH                          ===" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    bool all_passed = true;
+    Material material;
+    const double extent = 10.0;
+
+    // 1. Scène aléatoire
+    RandomSceneSpec spec;
+    spec.spheres = 1500;
+    spec.triangles = 1500;
+    std::vector<SceneObject*> scattered = AcceleratorChecker::createObjects(spec, 120, &material);
+    TriangleMesh sphereMesh;
+    AcceleratorChecker::addIcosphere(sphereMesh, 4, 0.8 * extent);
+
+    // 2. Codes de Morton identiques, à côté d'objets dispersés
+    std::mt19937 rng(121);
+    std::vector<SceneObject*> duplicates;
+    for (int i = 0; i < 200; i++) {
+        duplicates.push_back(createSphere(Vector3(-4, 3, 2), 0.2 + 0.01 * i, &material));
+    }
+    std::uniform_real_distribution<double> jitter(-1e-4, 1e-4);
+    for (int i = 0; i < 200; i++) {
+        duplicates.push_back(createSphere(Vector3(5 + jitter(rng), -5 + jitter(rng), 5 + jitter(rng)), 0.5, &material));
+    }
+    TriangleMesh centeredMesh;
+    addCenteredTriangles(centeredMesh, Vector3(3, 3, -3), 300, 2.0, rng);
+    for (uint32_t i = 0; i < centeredMesh.size(); i++) {
+        Vector3 a, b, c;
+        centeredMesh.corners(i, a, b, c);
+        Triangle* triangle = new Triangle(a, b, c);
+        triangle->material = &material;
+        triangle->applyTransform();
+        triangle->calculateBoundingBox();
+        duplicates.push_back(triangle);
+    }
+    RandomSceneSpec fewSpec;
+    fewSpec.spheres = 50;
+    fewSpec.triangles = 50;
+    std::vector<SceneObject*> few = AcceleratorChecker::createObjects(fewSpec, 122, &material);
+    duplicates.insert(duplicates.end(), few.begin(), few.end());
+    addCenteredTriangles(centeredMesh, Vector3(-6, -2, 4), 300, 1.0, rng);
+    addCenteredTriangles(centeredMesh, Vector3(0, 7, 0), 100, 3.0, rng);
+
+    // 3. Un seul centre pour tous
+    std::vector<SceneObject*> concentric;
+    for (int i = 0; i < 300; i++) {
+        concentric.push_back(createSphere(Vector3(0, 0, 0), 0.5 + 0.025 * i, &material));
+    }
+    TriangleMesh pointMesh;
+    addCenteredTriangles(pointMesh, Vector3(1, -1, 1), 500, 5.0, rng);
+
+    // 4. Une seule primitive
+    std::vector<SceneObject*> single = {createSphere(Vector3(1, 2, 3), 2.0, &material)};
+    TriangleMesh singleMesh;
+    addCenteredTriangles(singleMesh, Vector3(-1, 0, 2), 1, 4.0, rng);
+
+    TestStructure structure = AcceleratorChecker::structure("lbvh");
+    for (int width : {2, 4}) {
+        structure.width = width;
+        all_passed &= check(structure, "aléatoire", scattered, sphereMesh, extent, 130);
+        all_passed &= check(structure, "codes identiques", duplicates, centeredMesh, extent, 132);
+        all_passed &= check(structure, "centre unique", concentric, pointMesh, extent, 134);
+        all_passed &= check(structure, "une primitive", single, singleMesh, extent, 136);
+    }
+
+    for (std::vector<SceneObject*>* objects : {&scattered, &duplicates, &concentric, &single}) {
+        for (SceneObject* object : *objects) {
+            delete object;
+        }
+    }
+
+    std::cout << "============================================" << std::endl;
+    if (all_passed) {
+        std::cout << "✅ LBVH identique au test linéaire" << std::endl;
+        std::cout << "============================================" << std::endl;
+        return 0;
+    }
+    std::cerr << "❌ LBVH différent du test linéaire" << std::endl;
+    std::cout << "============================================" << std::endl;
+    return 1;
+}
@@ -0,0 +1,115 @@
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "Camera.hpp"
+#include "Image.hpp"
+#include "Intersection.hpp"
+#include "Mesh.hpp"
+#include "MeshGeometry.hpp"
+#include "Scene.hpp"
+#include "SceneLoader.hpp"
+
+/*
+ * TEST: Instances d'une même géométrie (MeshGeometry partagée)
+ * Trois meshes du même fichier obj (l'un par un chemin non normalisé), placés
+ * et tournés différemment: le chargeur ne lit le fichier qu'une fois (une seule
+ * MeshGeometry), la structure des triangles n'est construite qu'une fois, et
+ * chaque instance est touchée à sa place (icosphère de rayon 1).
+ */
+
+static const char* SCENE_PATH = "tests/scenes/instanced-icospheres.json";
+static const size_t INSTANCES = 3;
+
+/**
+ * Rayons vers le centre de l'instance depuis six directions: impact sur la face
+ * tournée vers l'origine du rayon, entre la sphère inscrite et le rayon 1
+ */
+static bool checkInstance(Scene& scene, const Vector3& center, size_t index) {
+    bool passed = true;
+    const Vector3 directions[] = {Vector3(1, 0, 0), Vector3(-1, 0, 0), Vector3(0, 1, 0),
+                                  Vector3(0, -1, 0), Vector3(0, 0, 1), Vector3(0, 0, -1)};
+    for (const Vector3& direction : directions) {
+        // Départ à 1.4 du centre: aucune autre instance sur le trajet
+        const Vector3 origin = center - direction * 1.4;
+        Ray ray(origin, direction);
+        Intersection hit;
+        if (!scene.closestIntersection(ray, hit, CULLING_FRONT)) {
+            std::cerr << "❌ Instance " << index << ": rayon manqué" << std::endl;
+            passed = false;
+            continue;
+        }
+        const double radius = (hit.Position - center).length();
+        const double facing = (hit.Position - center).dot(direction);
+        if (radius < 0.9 || radius > 1.0 + 1e-6 || facing >= 0) {
+            std::cerr << "❌ Instance " << index << ": impact à " << radius << " du centre" << std::endl;
+            passed = false;
+        }
+        // Les ombres ignorent les faces tournées vers le rayon: la face de sortie compte
+        if (!scene.occluded(ray, 3.0)) {
+            std::cerr << "❌ Instance " << index << ": ombre manquée" << std::endl;
+            passed = false;
+        }
+    }
+    // À côté de l'instance: rien
+    Ray miss(center + Vector3(0, 0, -1.4), Vector3(1, 0, 0));
+    Intersection hit;
+    if (scene.closestIntersection(miss, hit, CULLING_FRONT) && hit.Distance < 1.5) {
+        std::cerr << "❌ Instance " << index << ": impact hors de la sphère" << std::endl;
+        passed = false;
+    }
+    return passed;
+}
+
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "=== Test: Instances de meshes           ===" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    bool all_passed = true;
+    auto [scene, camera, image] = SceneLoader::Load(SCENE_PATH);
+    scene->prepare();
+
+    std::vector<Mesh*> meshes;
+    for (SceneObject* object : scene->getObjects()) {
+        if (Mesh* mesh = dynamic_cast<Mesh*>(object)) {
+            meshes.push_back(mesh);
+        }
+    }
+    if (meshes.size() != INSTANCES) {
+        std::cerr << "❌ " << meshes.size() << " meshes chargés, attendu " << INSTANCES << std::endl;
+        return 1;
+    }
+
+    // Un seul chargement du fichier obj pour les trois instances
+    MeshGeometry* geometry = meshes[0]->getGeometry().get();
+    for (Mesh* mesh : meshes) {
+        if (mesh->getGeometry().get() != geometry) {
+            std::cerr << "❌ Géométrie chargée plusieurs fois (cache du chargeur)" << std::endl;
+            all_passed = false;
+        }
+    }
+    std::cout << INSTANCES << " instances, " << geometry->getTriangleCount() << " triangles partagés" << std::endl;
+
+    for (size_t i = 0; i < meshes.size(); i++) {
+        all_passed &= checkInstance(*scene, meshes[i]->transform.getPosition(), i);
+    }
+    if (geometry->getBuildCount() != 1) {
+        std::cerr << "❌ Structure des triangles construite " << geometry->getBuildCount() << " fois" << std::endl;
+        all_passed = false;
+    }
+
+    delete scene;
+    delete camera;
+    delete image;
+
+    std::cout << "============================================" << std::endl;
+    if (all_passed) {
+        std::cout << "✅ Instances partagées et bien placées" << std::endl;
+        std::cout << "============================================" << std::endl;
+        return 0;
+    }
+    std::cerr << "❌ Instances de meshes incorrectes" << std::endl;
+    std::cout << "============================================" << std::endl;
+    return 1;
+}
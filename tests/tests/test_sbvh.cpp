@@ -0,0 +1,95 @@
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include "AcceleratorChecker.hpp"
+#include "BSPTree.hpp"
+#include "TriangleMesh.hpp"
+
+/*
+ * TEST: Constructeur SBVH (découpes spatiales)
+ * Petits triangles traversés par de longs triangles fins en diagonale, dont
+ * les boîtes recouvrent toute la scène: le SBVH doit découper des triangles
+ * (plus de références que de primitives) sans dépasser le budget de
+ * duplication, obtenir un coût SAH plus bas que le SAH seul, et donner les
+ * mêmes impacts que le test linéaire
+ */
+
+static const int SMALL_TRIANGLES = 2800;
+static const int NEEDLES = 200;
+static const int TRIANGLES = SMALL_TRIANGLES + NEEDLES;
+
+static void addTriangle(TriangleMesh& mesh, const Vector3& a, const Vector3& b, const Vector3& c) {
+    const uint32_t first = mesh.addVertex(a);
+    mesh.addVertex(b);
+    mesh.addVertex(c);
+    mesh.addTriangle(first, first + 1, first + 2);
+}
+
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "=== Test: SBVH                          ===" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    bool all_passed = true;
+    const double extent = 10.0;
+
+    TriangleMesh mesh;
+    std::mt19937 rng(110);
+    std::uniform_real_distribution<double> coordinate(-extent, extent);
+    std::uniform_real_distribution<double> offset(-0.2, 0.2);
+    std::uniform_real_distribution<double> width(0.01, 0.05);
+    for (int i = 0; i < SMALL_TRIANGLES; i++) {
+        const Vector3 a(coordinate(rng), coordinate(rng), coordinate(rng));
+        addTriangle(mesh, a, a + Vector3(offset(rng), offset(rng), offset(rng)),
+                    a + Vector3(offset(rng), offset(rng), offset(rng)));
+    }
+    // Aiguilles: d'un coin à l'autre de la scène, larges de 0.01 à 0.05
+    for (int i = 0; i < NEEDLES; i++) {
+        const double sx = i % 2 == 0 ? 1.0 : -1.0;
+        const double sy = i % 4 < 2 ? 1.0 : -1.0;
+        const Vector3 a(-sx * extent, -sy * extent, coordinate(rng));
+        const Vector3 b(sx * extent, sy * extent, coordinate(rng));
+        addTriangle(mesh, a, b, a + Vector3(width(rng), width(rng), width(rng)));
+    }
+
+    std::unique_ptr<Accelerator> sah = AcceleratorChecker::create(AcceleratorChecker::structure("bvh2"));
+    sah->build(mesh);
+    std::unique_ptr<Accelerator> sbvh = AcceleratorChecker::create(AcceleratorChecker::structure("sbvh"));
+    sbvh->build(mesh);
+    const BSPTreeStats sahStats = static_cast<BSPTree&>(*sah).computeStats();
+    const BSPTreeStats sbvhStats = static_cast<BSPTree&>(*sbvh).computeStats();
+    const size_t budget = static_cast<size_t>(TRIANGLES * SBVH_DUPLICATION_BUDGET);
+
+    std::cout << "SAH:  coût " << sahStats.sahCost << ", " << sahStats.referenceCount << " références" << std::endl;
+    std::cout << "SBVH: coût " << sbvhStats.sahCost << ", " << sbvhStats.referenceCount << " références (budget "
+              << TRIANGLES + budget << ")" << std::endl;
+
+    if (sbvhStats.referenceCount <= static_cast<size_t>(TRIANGLES)) {
+        std::cerr << "❌ Aucune découpe spatiale" << std::endl;
+        all_passed = false;
+    }
+    if (sbvhStats.referenceCount > TRIANGLES + budget) {
+        std::cerr << "❌ Budget de duplication dépassé" << std::endl;
+        all_passed = false;
+    }
+    if (!(sbvhStats.sahCost < sahStats.sahCost)) {
+        std::cerr << "❌ Coût SAH du SBVH pas meilleur que celui du SAH" << std::endl;
+        all_passed = false;
+    }
+
+    LinearAccelerator linear(false);
+    linear.build(mesh);
+    all_passed &= AcceleratorChecker::report("aiguilles sbvh vs linear",
+                                             AcceleratorChecker::compare(*sbvh, linear, extent, 10000, 111));
+
+    std::cout << "============================================" << std::endl;
+    if (all_passed) {
+        std::cout << "✅ SBVH dans le budget, meilleur que le SAH" << std::endl;
+        std::cout << "============================================" << std::endl;
+        return 0;
+    }
+    std::cerr << "❌ SBVH incorrect" << std::endl;
+    std::cout << "============================================" << std::endl;
+    return 1;
+}
@@ -0,0 +1,83 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AcceleratorChecker.hpp"
+#include "Scene.hpp"
+#include "ScenePrimitives.hpp"
+
+/*
+ * TEST: Primitives rangées par type (ScenePrimitives)
+ * Scènes avec typedPrimitives (sphères, triangles et plans) comparées à la même
+ * scène en objets virtuels sans structure, pour chaque structure; avec
+ * packSpheres en plus, le groupe de sphères passe par la plage des autres
+ * objets (appels virtuels). Puis après déplacement des objets (update + refit).
+ */
+
+static const std::vector<TestStructure> STRUCTURES = AcceleratorChecker::structures(
+    {"none", "aabb", "bvh2", "bvh4", "bvh8", "bvh8-q16", "lbvh", "sbvh", "grid", "kdtree"});
+
+static const int RAYS = 6000;
+
+static bool checkScene(const TestStructure& structure, bool packSpheres, const RandomSceneSpec& spec, unsigned int seed) {
+    Material material;
+    Scene typed;
+    typed.typedPrimitives = true;
+    typed.packSpheres = packSpheres;
+    typed.accelerator = structure.settings();
+    AcceleratorChecker::fillScene(typed, spec, seed, &material);
+    Scene reference;
+    reference.accelerator.type = ACCELERATOR_NONE;
+    AcceleratorChecker::fillScene(reference, spec, seed, &material);
+
+    typed.prepare();
+    reference.prepare();
+    const ScenePrimitives* primitives = typed.getTypedPrimitives();
+    const size_t expectedSpheres = packSpheres ? 0 : spec.spheres;
+    const size_t expectedObjects = packSpheres ? 1 : 0;
+    if (primitives == nullptr || primitives->sphereCount() != expectedSpheres ||
+        primitives->triangleCount() != static_cast<size_t>(spec.triangles) ||
+        primitives->planeCount() != static_cast<size_t>(spec.planes) || primitives->objectCount() != expectedObjects) {
+        std::cerr << "❌ " << structure.name << ": objets mal rangés par type" << std::endl;
+        return false;
+    }
+
+    const std::string label = std::string("typedPrimitives ") + (packSpheres ? "+ packSpheres " : "") + structure.name;
+    bool passed = AcceleratorChecker::report(label + " vs linear",
+                                             AcceleratorChecker::compare(typed, reference, spec.extent, RAYS, seed + 1));
+
+    AcceleratorChecker::moveObjects(typed, spec.extent, seed + 2, false);
+    AcceleratorChecker::moveObjects(reference, spec.extent, seed + 2, false);
+    typed.prepare();
+    reference.prepare();
+    passed &= AcceleratorChecker::report(label + " déplacés",
+                                         AcceleratorChecker::compare(typed, reference, spec.extent, RAYS, seed + 3));
+    return passed;
+}
+
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "=== Test: Primitives par type           ===" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    bool all_passed = true;
+
+    RandomSceneSpec spec;
+    spec.spheres = 400;
+    spec.triangles = 400;
+    spec.planes = 2;
+    for (const TestStructure& structure : STRUCTURES) {
+        all_passed &= checkScene(structure, false, spec, 80);
+    }
+    all_passed &= checkScene(AcceleratorChecker::structure("bvh4"), true, spec, 90);
+    all_passed &= checkScene(AcceleratorChecker::structure("grid"), true, spec, 90);
+
+    std::cout << "============================================" << std::endl;
+    if (all_passed) {
+        std::cout << "✅ Primitives par type identiques au test linéaire" << std::endl;
+        std::cout << "============================================" << std::endl;
+        return 0;
+    }
+    std::cerr << "❌ Primitives par type différentes du test linéaire" << std::endl;
+    std::cout << "============================================" << std::endl;
+    return 1;
+}
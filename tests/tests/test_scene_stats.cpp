@@ -0,0 +1,218 @@
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "AcceleratorChecker.hpp"
+#include "BSPTree.hpp"
+#include "Camera.hpp"
+#include "Image.hpp"
+#include "Intersection.hpp"
+#include "KdTree.hpp"
+#include "Mesh.hpp"
+#include "MeshGeometry.hpp"
+#include "Scene.hpp"
+#include "SceneLoader.hpp"
+#include "SceneStats.hpp"
+#include "Sphere.hpp"
+#include "json.hpp"
+
+/*
+ * TEST: Rapport JSON des structures (SceneStats::toJson, commande stats)
+ * 1. Clés du rapport selon les options (packSpheres, typedPrimitives, meshes)
+ * 2. Nœuds, feuilles et références identiques à ceux de la structure, sur une
+ *    sphère seule (valeurs connues) et sur des scènes aléatoires
+ * 3. Meshes: une entrée par géométrie partagée, structure null avant le premier rayon
+ */
+
+using json = nlohmann::json;
+
+static bool expect(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "❌ " << message << std::endl;
+    }
+    return condition;
+}
+
+static bool hasKeys(const json& object, const std::vector<std::string>& keys, const std::string& where) {
+    bool passed = true;
+    for (const std::string& key : keys) {
+        passed &= expect(object.is_object() && object.contains(key), where + ": clé \"" + key + "\" absente");
+    }
+    return passed;
+}
+
+/**
+ * Entrée "accelerator" d'un BVH comparée à BSPTree::computeStats
+ */
+static bool checkTree(const json& entry, const Accelerator* accelerator, const std::string& where) {
+    const BSPTree* tree = dynamic_cast<const BSPTree*>(accelerator);
+    if (!expect(tree != nullptr, where + ": pas de BVH")) {
+        return false;
+    }
+    const BSPTreeStats stats = tree->computeStats();
+    bool passed = hasKeys(entry, {"type", "builder", "width", "quantizationBits", "primitives", "unbounded", "nodes",
+                                  "leaves", "references", "maxDepth", "averageLeafDepth", "averageLeafSize",
+                                  "leafOccupancy", "sahCost", "siblingOverlap", "memory"}, where);
+    if (!passed) {
+        return false;
+    }
+    passed &= expect(entry["nodes"] == stats.nodeCount && entry["leaves"] == stats.leafCount &&
+                         entry["references"] == stats.referenceCount && entry["maxDepth"] == stats.maxDepth,
+                     where + ": nœuds, feuilles ou références différents de computeStats");
+    passed &= expect(entry["width"] == tree->getWidth(), where + ": largeur");
+
+    // Histogramme: un casier par taille jusqu'à BSP_STATS_MAX_LEAF_SIZE+, qui totalise les feuilles
+    const json& histogram = entry["leafOccupancy"];
+    size_t leaves = 0;
+    for (const auto& bin : histogram.items()) {
+        leaves += bin.value().get<size_t>();
+    }
+    passed &= expect(histogram.size() == BSP_STATS_MAX_LEAF_SIZE + 1 &&
+                         histogram.contains(std::to_string(BSP_STATS_MAX_LEAF_SIZE) + "+") && leaves == stats.leafCount,
+                     where + ": histogramme des feuilles");
+    return passed;
+}
+
+static bool checkSingleSphere() {
+    Scene scene;
+    scene.accelerator = AcceleratorChecker::structure("bvh2").settings();
+    Sphere* sphere = new Sphere(1.0);
+    scene.add(sphere);
+    scene.prepare();
+
+    const json stats = json::parse(SceneStats::toJson(scene));
+    bool passed = hasKeys(stats, {"objects", "buildTime", "flattenMeshes", "packSpheres", "typedPrimitives",
+                                  "accelerator", "meshes"}, "sphère seule");
+    passed &= expect(!stats.contains("spheres") && !stats.contains("primitives"), "sphère seule: entrées d'options inactives");
+    if (!passed) {
+        return false;
+    }
+    const json& tree = stats["accelerator"];
+    passed &= checkTree(tree, scene.getAccelerator(), "sphère seule");
+    passed &= expect(stats["objects"] == 1 && tree["primitives"] == 1 && tree["nodes"] == 1 && tree["leaves"] == 1 &&
+                         tree["references"] == 1 && tree["maxDepth"] == 0 && tree["leafOccupancy"]["1"] == 1,
+                     "sphère seule: attendu 1 nœud, 1 feuille, 1 référence");
+    passed &= expect(stats["meshes"].is_array() && stats["meshes"].empty(), "sphère seule: meshes");
+    return passed;
+}
+
+static bool checkRandomScene(const TestStructure& structure, bool packSpheres, bool typedPrimitives) {
+    const std::string where = std::string(structure.name) + (packSpheres ? " packSpheres" : "") +
+                              (typedPrimitives ? " typedPrimitives" : "");
+    Material material;
+    RandomSceneSpec spec;
+    spec.spheres = 300;
+    spec.triangles = 300;
+    spec.planes = 1;
+    Scene scene;
+    scene.accelerator = structure.settings();
+    scene.packSpheres = packSpheres;
+    scene.typedPrimitives = typedPrimitives;
+    AcceleratorChecker::fillScene(scene, spec, 150, &material);
+    scene.prepare();
+
+    const json stats = json::parse(SceneStats::toJson(scene));
+    bool passed = expect(stats["objects"] == spec.spheres + spec.triangles + spec.planes, where + ": objets");
+    passed &= expect(stats["packSpheres"] == packSpheres && stats["typedPrimitives"] == typedPrimitives, where + ": options");
+    const json& tree = stats["accelerator"];
+    passed &= expect(tree["type"] == acceleratorName(structure.type), where + ": type");
+
+    if (structure.type == ACCELERATOR_BVH) {
+        passed &= checkTree(tree, scene.getAccelerator(), where);
+        // Sans découpe spatiale, une référence par primitive bornée
+        const size_t bounded = tree["primitives"].get<size_t>() - tree["unbounded"].get<size_t>();
+        passed &= expect(structure.builder == BUILD_SBVH || tree["references"] == bounded,
+                         where + ": références != primitives bornées");
+    } else if (structure.type == ACCELERATOR_KDTREE) {
+        const KdTree* kd = dynamic_cast<const KdTree*>(scene.getAccelerator());
+        passed &= expect(kd != nullptr && tree["nodes"] == kd->getNodeCount() && tree["leaves"] == kd->getLeafCount() &&
+                             tree["references"] == kd->getReferenceCount(),
+                         where + ": nœuds, feuilles ou références différents du kd-tree");
+    } else if (structure.type == ACCELERATOR_GRID) {
+        passed &= expect(tree["resolution"].is_array() && tree["resolution"].size() == 3, where + ": résolution");
+    }
+
+    if (packSpheres) {
+        passed &= hasKeys(stats, {"spheres"}, where) && hasKeys(stats["spheres"], {"count", "memory", "accelerator"}, where);
+        passed &= expect(stats["spheres"]["count"] == spec.spheres, where + ": sphères regroupées");
+    } else {
+        passed &= expect(!stats.contains("spheres"), where + ": entrée spheres sans packSpheres");
+    }
+    if (typedPrimitives) {
+        passed &= hasKeys(stats, {"primitives"}, where) &&
+                  hasKeys(stats["primitives"], {"spheres", "triangles", "planes", "objects", "memory"}, where);
+        passed &= expect(stats["primitives"]["triangles"] == spec.triangles && stats["primitives"]["planes"] == spec.planes,
+                         where + ": primitives par type");
+    } else {
+        passed &= expect(!stats.contains("primitives"), where + ": entrée primitives sans typedPrimitives");
+    }
+    if (passed) {
+        std::cout << "✅ " << where << ": clés et comptes cohérents" << std::endl;
+    }
+    return passed;
+}
+
+static bool checkMeshes() {
+    auto [scene, camera, image] = SceneLoader::Load("tests/scenes/instanced-icospheres.json");
+    scene->prepare();
+    json stats = json::parse(SceneStats::toJson(*scene));
+    bool passed = expect(stats["meshes"].is_array() && stats["meshes"].size() == 1, "meshes: une entrée par géométrie");
+    if (passed) {
+        const json& mesh = stats["meshes"][0];
+        passed &= hasKeys(mesh, {"path", "instances", "triangles", "triangleMemory", "accelerator"}, "meshes");
+        passed &= expect(mesh["instances"] == 3 && mesh["triangles"] == 320, "meshes: 3 instances de 320 triangles");
+        passed &= expect(mesh["accelerator"].is_null(), "meshes: structure décrite avant le premier rayon");
+    }
+
+    // Premier rayon: la structure des triangles existe et se décrit comme celle de la scène
+    Ray ray(Vector3(-3, 0, 0), Vector3(0, 0, 1));
+    Intersection hit;
+    scene->closestIntersection(ray, hit, CULLING_FRONT);
+    stats = json::parse(SceneStats::toJson(*scene));
+    if (passed) {
+        const json& tree = stats["meshes"][0]["accelerator"];
+        passed &= expect(!tree.is_null(), "meshes: structure absente après le premier rayon");
+        if (passed && tree["type"] == acceleratorName(ACCELERATOR_BVH)) {
+            const Mesh* mesh = dynamic_cast<const Mesh*>(scene->getObjects()[0]);
+            passed &= checkTree(tree, mesh->getGeometry()->getAccelerator(), "meshes");
+            passed &= expect(tree["primitives"] == 320, "meshes: triangles de la structure");
+        }
+    }
+    if (passed) {
+        std::cout << "✅ meshes: 1 géométrie, 3 instances, structure décrite après le premier rayon" << std::endl;
+    }
+    delete scene;
+    delete camera;
+    delete image;
+    return passed;
+}
+
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "=== Test: Rapport stats                 ===" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    bool all_passed = true;
+
+    if (checkSingleSphere()) {
+        std::cout << "✅ sphère seule: 1 nœud, 1 feuille, 1 référence" << std::endl;
+    } else {
+        all_passed = false;
+    }
+    for (const TestStructure& structure : AcceleratorChecker::structures({"bvh2", "bvh4", "sbvh", "grid", "kdtree"})) {
+        all_passed &= checkRandomScene(structure, false, false);
+    }
+    all_passed &= checkRandomScene(AcceleratorChecker::structure("bvh4"), true, false);
+    all_passed &= checkRandomScene(AcceleratorChecker::structure("bvh4"), false, true);
+    all_passed &= checkMeshes();
+
+    std::cout << "============================================" << std::endl;
+    if (all_passed) {
+        std::cout << "✅ Rapport stats cohérent avec les structures" << std::endl;
+        std::cout << "============================================" << std::endl;
+        return 0;
+    }
+    std::cerr << "❌ Rapport stats incorrect" << std::endl;
+    std::cout << "============================================" << std::endl;
+    return 1;
+}
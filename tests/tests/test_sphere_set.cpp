@@ -0,0 +1,96 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AcceleratorChecker.hpp"
+#include "Scene.hpp"
+#include "Sphere.hpp"
+#include "SphereGroup.hpp"
+#include "SphereSet.hpp"
+
+/*
+ * TEST: Sphères regroupées (SphereSet / SphereGroup)
+ * 1. Test 4 par 4 du SphereSet comparé au test linéaire des objets Sphere
+ * 2. Scènes avec packSpheres (sphères, triangles et plans) comparées à la même
+ *    scène sans regroupement ni structure, pour chaque structure des sphères;
+ *    puis après déplacement des sphères (refit de l'arbre du groupe)
+ */
+
+static const std::vector<TestStructure> STRUCTURES = AcceleratorChecker::structures(
+    {"aabb", "bvh2", "bvh4", "bvh8", "bvh4-q8", "sbvh", "grid", "kdtree"});
+
+static const int RAYS = 10000;
+
+static bool checkScene(const TestStructure& structure, const RandomSceneSpec& spec, unsigned int seed) {
+    Material material;
+    Scene packed;
+    packed.packSpheres = true;
+    packed.accelerator = structure.settings();
+    AcceleratorChecker::fillScene(packed, spec, seed, &material);
+    Scene reference;
+    reference.accelerator.type = ACCELERATOR_NONE;
+    AcceleratorChecker::fillScene(reference, spec, seed, &material);
+
+    packed.prepare();
+    reference.prepare();
+    if (packed.getSphereGroup() == nullptr || packed.getSphereGroup()->getSphereCount() != static_cast<size_t>(spec.spheres)) {
+        std::cerr << "❌ " << structure.name << ": sphères non regroupées" << std::endl;
+        return false;
+    }
+    bool passed = AcceleratorChecker::report(std::string("packSpheres ") + structure.name + " vs linear",
+                                             AcceleratorChecker::compare(packed, reference, spec.extent, RAYS, seed + 1));
+
+    AcceleratorChecker::moveObjects(packed, spec.extent, seed + 2, true);
+    AcceleratorChecker::moveObjects(reference, spec.extent, seed + 2, true);
+    packed.prepare();
+    reference.prepare();
+    passed &= AcceleratorChecker::report(std::string("packSpheres ") + structure.name + " déplacées",
+                                         AcceleratorChecker::compare(packed, reference, spec.extent, RAYS, seed + 3));
+    return passed;
+}
+
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "=== Test: Sphères regroupées            ===" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    bool all_passed = true;
+    Material material;
+
+    // 1. Kernel du SphereSet seul: lots de 4 incomplets compris (1001 sphères)
+    RandomSceneSpec sphereSpec;
+    sphereSpec.spheres = 1001;
+    std::vector<SceneObject*> spheres = AcceleratorChecker::createObjects(sphereSpec, 60, &material);
+    SphereSet set;
+    for (SceneObject* object : spheres) {
+        Sphere* sphere = static_cast<Sphere*>(object);
+        set.add(sphere->getCenter(), sphere->getRadius(), sphere->material);
+    }
+    LinearAccelerator objectLinear(false);
+    objectLinear.build(spheres);
+    LinearAccelerator setLinear(false);
+    setLinear.build(set);
+    all_passed &= AcceleratorChecker::report("SphereSet vs Sphere",
+                                             AcceleratorChecker::compare(setLinear, objectLinear, sphereSpec.extent, RAYS, 61));
+    for (SceneObject* object : spheres) {
+        delete object;
+    }
+
+    // 2. Scènes mixtes, sphères regroupées dans chaque structure
+    RandomSceneSpec sceneSpec;
+    sceneSpec.spheres = 600;
+    sceneSpec.triangles = 150;
+    sceneSpec.planes = 2;
+    for (const TestStructure& structure : STRUCTURES) {
+        all_passed &= checkScene(structure, sceneSpec, 70);
+    }
+
+    std::cout << "============================================" << std::endl;
+    if (all_passed) {
+        std::cout << "✅ Sphères regroupées identiques au test linéaire" << std::endl;
+        std::cout << "============================================" << std::endl;
+        return 0;
+    }
+    std::cerr << "❌ Sphères regroupées différentes du test linéaire" << std::endl;
+    std::cout << "============================================" << std::endl;
+    return 1;
+}
@@ -0,0 +1,57 @@
+#include <iostream>
+#include <vector>
+#include "AcceleratorChecker.hpp"
+#include "UniformGrid.hpp"
+
+/*
+ * TEST: Grille uniforme
+ * Compare les impacts les plus proches et les requêtes d'ombre de la grille
+ * avec le test linéaire, sur des scènes aléatoires avec plans (hors de la grille)
+ */
+
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "=== Test: Grille uniforme               ===" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    const int rays = 20000;
+    bool all_passed = true;
+    Material material;
+
+    // Nuage dense, scène clairsemée, et triangles seuls (grandes cellules vides)
+    RandomSceneSpec specs[3];
+    specs[0].spheres = 2000;
+    specs[0].planes = 2;
+    specs[1].spheres = 100;
+    specs[1].triangles = 100;
+    specs[1].planes = 1;
+    specs[1].extent = 50.0;
+    specs[2].triangles = 1500;
+    specs[2].planes = 3;
+
+    for (int i = 0; i < 3; i++) {
+        std::vector<SceneObject*> objects = AcceleratorChecker::createObjects(specs[i], 20 + i, &material);
+        LinearAccelerator linear(false);
+        linear.build(objects);
+        UniformGrid grid;
+        grid.build(objects);
+
+        std::cout << "Scène " << i << ": " << objects.size() << " objets, grille "
+                  << grid.getResolution(0) << "x" << grid.getResolution(1) << "x" << grid.getResolution(2) << std::endl;
+        all_passed &= AcceleratorChecker::report("grid vs linear",
+                                                 AcceleratorChecker::compare(grid, linear, specs[i].extent, rays, 5 + i));
+        for (SceneObject* object : objects) {
+            delete object;
+        }
+    }
+
+    std::cout << "============================================" << std::endl;
+    if (all_passed) {
+        std::cout << "✅ Grille identique au test linéaire" << std::endl;
+        std::cout << "============================================" << std::endl;
+        return 0;
+    }
+    std::cerr << "❌ Grille différente du test linéaire" << std::endl;
+    std::cout << "============================================" << std::endl;
+    return 1;
+}
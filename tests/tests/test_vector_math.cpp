@@ -0,0 +1,227 @@
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include "Vector3.hpp"
+#include "Color.hpp"
+
+/*
+ * TEST: Équivalence Vector3 / Color
+ * Compare les versions inline (en-têtes) avec l'ancienne implémentation
+ * hors ligne (Vector3.cpp / Color.cpp, recopiée ci-dessous) sur des valeurs
+ * aléatoires et des cas limites: les résultats doivent être identiques bit à bit
+ */
+
+namespace reference {
+
+// Ancien Vector3.cpp, fonctions non inlinables (comme un appel hors de raymath)
+struct Vector3 {
+    double x = 0;
+    double y = 0;
+    double z = 0;
+};
+
+__attribute__((noinline)) Vector3 add(Vector3 const& a, Vector3 const& b) {
+    return {a.x + b.x, a.y + b.y, a.z + b.z};
+}
+
+__attribute__((noinline)) Vector3 sub(Vector3 const& a, Vector3 const& b) {
+    return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+__attribute__((noinline)) Vector3 mul(Vector3 const& a, double const& f) {
+    return {a.x * f, a.y * f, a.z * f};
+}
+
+__attribute__((noinline)) Vector3 div(Vector3 const& a, double const& f) {
+    double inv = 1.0 / f;
+    return {a.x * inv, a.y * inv, a.z * inv};
+}
+
+__attribute__((noinline)) double lengthSquared(Vector3 const& a) {
+    return (a.x * a.x + a.y * a.y + a.z * a.z);
+}
+
+__attribute__((noinline)) double length(Vector3 const& a) {
+    return std::sqrt(lengthSquared(a));
+}
+
+__attribute__((noinline)) Vector3 normalize(Vector3 const& a) {
+    double lengthSq = lengthSquared(a);
+    if (lengthSq == 0) {
+        return Vector3();
+    }
+    double invLength = 1.0 / std::sqrt(lengthSq);
+    return mul(a, invLength);
+}
+
+__attribute__((noinline)) double dot(Vector3 const& a, Vector3 const& b) {
+    return (a.x * b.x + a.y * b.y + a.z * b.z);
+}
+
+__attribute__((noinline)) Vector3 projectOn(Vector3 const& a, Vector3 const& b) {
+    return mul(b, dot(a, b));
+}
+
+__attribute__((noinline)) Vector3 reflect(Vector3 const& a, Vector3 const& normal) {
+    Vector3 proj = mul(projectOn(a, normal), -2);
+    return add(proj, a);
+}
+
+__attribute__((noinline)) Vector3 cross(Vector3 const& a, Vector3 const& b) {
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+__attribute__((noinline)) Vector3 inverse(Vector3 const& a) {
+    return {1.0 / a.x, 1.0 / a.y, 1.0 / a.z};
+}
+
+// Ancien Color.cpp
+struct Color {
+    float r = 0;
+    float g = 0;
+    float b = 0;
+};
+
+__attribute__((noinline)) Color add(Color const& a, Color const& c) {
+    return {std::max(std::min(a.r + c.r, 1.0f), 0.0f),
+            std::max(std::min(a.g + c.g, 1.0f), 0.0f),
+            std::max(std::min(a.b + c.b, 1.0f), 0.0f)};
+}
+
+__attribute__((noinline)) Color mul(Color const& a, float const& f) {
+    return {std::max(std::min(a.r * f, 1.0f), 0.0f),
+            std::max(std::min(a.g * f, 1.0f), 0.0f),
+            std::max(std::min(a.b * f, 1.0f), 0.0f)};
+}
+
+__attribute__((noinline)) Color mul(Color const& a, Color const& c) {
+    return {std::max(std::min(a.r * c.r, 1.0f), 0.0f),
+            std::max(std::min(a.g * c.g, 1.0f), 0.0f),
+            std::max(std::min(a.b * c.b, 1.0f), 0.0f)};
+}
+
+__attribute__((noinline)) Color div(Color const& a, float const& f) {
+    return {std::max(std::min(a.r / f, 1.0f), 0.0f),
+            std::max(std::min(a.g / f, 1.0f), 0.0f),
+            std::max(std::min(a.b / f, 1.0f), 0.0f)};
+}
+
+}  // namespace reference
+
+// Types trivialement copiables, opérations utilisables dans une expression constante
+static_assert(std::is_trivially_copyable<Vector3>::value, "Vector3 must be trivially copyable");
+static_assert(std::is_trivially_copyable<Color>::value, "Color must be trivially copyable");
+static_assert(Vector3(1, 2, 3).cross(Vector3(4, 5, 6)).y == 6, "constexpr cross");
+static_assert((Vector3(1, 2, 3) + Vector3(1, 1, 1) * 2).dot(Vector3(1, 0, 0)) == 3, "constexpr arithmetic");
+static_assert((Vector3(2, 4, 8) / 2).z == 4, "constexpr division");
+static_assert((Color(0.5f, 0.25f, 0.0f) * 4.0f).g == 1.0f, "constexpr color clamp");
+
+static int failures = 0;
+
+static bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0 || (std::isnan(a) && std::isnan(b));
+}
+
+static bool sameBits(float a, float b) {
+    return std::memcmp(&a, &b, sizeof(float)) == 0 || (std::isnan(a) && std::isnan(b));
+}
+
+static void check(const char* name, const Vector3& actual, const reference::Vector3& expected) {
+    if (!sameBits(actual.x, expected.x) || !sameBits(actual.y, expected.y) || !sameBits(actual.z, expected.z)) {
+        if (failures < 10) {
+            std::cerr << "❌ " << name << ": " << actual << " != ("
+                      << expected.x << "," << expected.y << "," << expected.z << ")" << std::endl;
+        }
+        failures++;
+    }
+}
+
+static void check(const char* name, double actual, double expected) {
+    if (!sameBits(actual, expected)) {
+        if (failures < 10) {
+            std::cerr << "❌ " << name << ": " << actual << " != " << expected << std::endl;
+        }
+        failures++;
+    }
+}
+
+static void check(const char* name, const Color& actual, const reference::Color& expected) {
+    if (!sameBits(actual.r, expected.r) || !sameBits(actual.g, expected.g) || !sameBits(actual.b, expected.b)) {
+        if (failures < 10) {
+            std::cerr << "❌ " << name << ": " << actual << " != ("
+                      << expected.r << "," << expected.g << "," << expected.b << ")" << std::endl;
+        }
+        failures++;
+    }
+}
+
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "=== Test: Équivalence Vector3 / Color   ===" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> coordinate(-1000.0, 1000.0);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+    std::uniform_real_distribution<float> channel(-0.5f, 1.5f);
+    const double special[] = {0.0, -0.0, 1.0, -2.0, 1e-300, 1e300, COMPARE_ERROR_CONSTANT};
+
+    const int samples = 100000;
+    for (int i = 0; i < samples; i++) {
+        // Quelques échantillons utilisent des valeurs limites (zéros, très petites, très grandes)
+        auto pick = [&](std::uniform_real_distribution<double>& dist) {
+            return (i % 16 == 0) ? special[rng() % (sizeof(special) / sizeof(special[0]))] : dist(rng);
+        };
+        const reference::Vector3 ra = {pick(coordinate), pick(coordinate), pick(coordinate)};
+        const reference::Vector3 rb = {pick(unit), pick(unit), pick(unit)};
+        const double f = pick(coordinate);
+        const Vector3 a(ra.x, ra.y, ra.z);
+        const Vector3 b(rb.x, rb.y, rb.z);
+
+        check("operator+", a + b, reference::add(ra, rb));
+        check("operator-", a - b, reference::sub(ra, rb));
+        check("operator*", a * f, reference::mul(ra, f));
+        check("operator/", a / f, reference::div(ra, f));
+        check("length", a.length(), reference::length(ra));
+        check("lengthSquared", a.lengthSquared(), reference::lengthSquared(ra));
+        check("normalize", a.normalize(), reference::normalize(ra));
+        check("dot", a.dot(b), reference::dot(ra, rb));
+        check("projectOn", a.projectOn(b), reference::projectOn(ra, rb));
+        check("reflect", a.reflect(b.normalize()), reference::reflect(ra, reference::normalize(rb)));
+        check("cross", a.cross(b), reference::cross(ra, rb));
+        check("inverse", a.inverse(), reference::inverse(ra));
+
+        const reference::Color rc = {channel(rng), channel(rng), channel(rng)};
+        const reference::Color rd = {channel(rng), channel(rng), channel(rng)};
+        const float g = static_cast<float>(unit(rng)) * 4.0f;
+        const Color c(rc.r, rc.g, rc.b);
+        const Color d(rd.r, rd.g, rd.b);
+
+        check("Color operator+", c + d, reference::add(rc, rd));
+        check("Color operator*(float)", c * g, reference::mul(rc, g));
+        check("Color operator*(Color)", c * d, reference::mul(rc, rd));
+        check("Color operator/", c / g, reference::div(rc, g));
+    }
+
+    // Affichage inchangé
+    std::ostringstream stream;
+    stream << Vector3(1, -2.5, 3) << " " << Color(0.5f, 0.25f, 1.0f);
+    if (stream.str() != "(1,-2.5,3) (0.5,0.25,1)") {
+        std::cerr << "❌ operator<<: " << stream.str() << std::endl;
+        failures++;
+    }
+
+    std::cout << "============================================" << std::endl;
+    if (failures == 0) {
+        std::cout << "✅ " << samples << " échantillons identiques bit à bit" << std::endl;
+        std::cout << "============================================" << std::endl;
+        return 0;
+    }
+    std::cerr << "❌ " << failures << " résultats différents" << std::endl;
+    std::cout << "============================================" << std::endl;
+    return 1;
+}
@@ -0,0 +1,101 @@
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AcceleratorChecker.hpp"
+
+/*
+ * TEST: Intersection étanche (arêtes et sommets partagés)
+ * Un rayon qui passe exactement par une arête ou un sommet partagé doit toucher
+ * au moins un des triangles, quelle que soit la structure:
+ * 1. Deux triangles partageant l'arête x = 0 (comme scenes/two-triangles-on-plane.json):
+ *    rayons de direction x = 0 depuis une origine x = 0, donc dans le plan des
+ *    faces des AABB (0 * inf = NaN dans le test de dalles)
+ * 2. Cube maillé sur une grille régulière: rayons parallèles aux axes le long des
+ *    arêtes, et rayons vers les sommets et les arêtes
+ * 3. Icosphère (5120 triangles): rayons du centre vers chaque sommet et le long
+ *    de chaque arête (environ 28 000 fuites sur 122 880 rayons avec l'ancien test
+ *    de Möller-Trumbore)
+ * Chaque cas est testé sur le mesh indexé et sur des objets Triangle
+ */
+
+static const std::vector<TestStructure> STRUCTURES = AcceleratorChecker::structures(
+    {"none", "aabb", "bvh2", "bvh4", "bvh8", "bvh4-q8", "bvh8-q16", "sbvh", "grid", "kdtree"});
+
+/**
+ * Tous les rayons sur le mesh indexé puis sur les objets Triangle, pour chaque structure
+ * @param linear false pour sauter none et aabb (trop lents sur un gros mesh)
+ */
+static bool checkMesh(const std::string& label, const TriangleMesh& mesh, std::vector<Ray>& rays,
+                      double maxDistance, bool linear) {
+    Material material;
+    std::vector<SceneObject*> objects = AcceleratorChecker::createTriangles(mesh, &material);
+    bool passed = true;
+    for (const TestStructure& structure : STRUCTURES) {
+        if (!linear && (structure.type == ACCELERATOR_NONE || structure.type == ACCELERATOR_AABB)) {
+            continue;
+        }
+        std::unique_ptr<Accelerator> meshStructure = AcceleratorChecker::create(structure);
+        meshStructure->build(mesh);
+        passed &= AcceleratorChecker::report(label + " mesh " + structure.name,
+                                             AcceleratorChecker::countLeaks(*meshStructure, rays, maxDistance));
+        std::unique_ptr<Accelerator> objectStructure = AcceleratorChecker::create(structure);
+        objectStructure->build(objects);
+        passed &= AcceleratorChecker::report(label + " objets " + structure.name,
+                                             AcceleratorChecker::countLeaks(*objectStructure, rays, maxDistance));
+    }
+    for (SceneObject* object : objects) {
+        delete object;
+    }
+    return passed;
+}
+
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "=== Test: Intersection étanche          ===" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    bool all_passed = true;
+
+    // 1. Arête partagée dans le plan x = 0, faces orientées vers +z (vues de dos depuis z = 0)
+    TriangleMesh pair;
+    const uint32_t top = pair.addVertex(Vector3(0, 0.5, 5));
+    const uint32_t bottom = pair.addVertex(Vector3(0, -0.5, 5));
+    const uint32_t left = pair.addVertex(Vector3(-0.866, -0.5, 5.5));
+    const uint32_t right = pair.addVertex(Vector3(0.866, 0.5, 4.5));
+    pair.addTriangle(top, left, bottom);
+    pair.addTriangle(top, bottom, right);
+    std::vector<Ray> pairRays;
+    const int samples = 1000;
+    for (int i = 0; i < samples; i++) {
+        const double y = -0.5 + (i + 0.5) / samples;
+        pairRays.push_back(Ray(Vector3(0, 0, 0), Vector3(0, y, 5).normalize()));  // Caméra à l'origine, colonne x = 0
+        pairRays.push_back(Ray(Vector3(0, y, 0), Vector3(0, 0, 1)));               // Parallèle à l'axe z
+    }
+    all_passed &= checkMesh("arête x = 0", pair, pairRays, 10.0, true);
+
+    // 2. Cube: arêtes et sommets alignés sur les axes
+    TriangleMesh cube;
+    AcceleratorChecker::addTessellatedCube(cube, 8, 1.0);
+    std::vector<Ray> cubeRays = AcceleratorChecker::gridAxisRays(8, 1.0);
+    std::vector<Ray> cubeEdges = AcceleratorChecker::edgeRays(cube, Vector3(0.25, -0.5, 0.125), 4);
+    cubeRays.insert(cubeRays.end(), cubeEdges.begin(), cubeEdges.end());
+    all_passed &= checkMesh("cube", cube, cubeRays, 10.0, true);
+
+    // 3. Icosphère subdivisée 4 fois
+    TriangleMesh sphere;
+    AcceleratorChecker::addIcosphere(sphere, 4, 5.0);
+    std::vector<Ray> sphereRays = AcceleratorChecker::edgeRays(sphere, Vector3(0.1, -0.2, 0.3), 8);
+    std::cout << "Icosphère: " << sphere.size() << " triangles, " << sphereRays.size() << " rayons" << std::endl;
+    all_passed &= checkMesh("icosphère", sphere, sphereRays, 20.0, false);
+
+    std::cout << "============================================" << std::endl;
+    if (all_passed) {
+        std::cout << "✅ Aucune fuite par les arêtes et les sommets" << std::endl;
+        std::cout << "============================================" << std::endl;
+        return 0;
+    }
+    std::cerr << "❌ Fuites par les arêtes ou les sommets" << std::endl;
+    std::cout << "============================================" << std::endl;
+    return 1;
+}
@@ -0,0 +1,99 @@
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "AcceleratorChecker.hpp"
+#include "BSPTree.hpp"
+#include "TriangleMesh.hpp"
+
+/*
+ * TEST: Parcours des BVH larges (BVH4 / BVH8)
+ * Compare les parcours larges (float et compressés) avec le parcours binaire
+ * et le test linéaire. Le test de dalles vectoriel compilé est celui de la
+ * machine: SSE sur x86, AVX pour le BVH8 avec USE_NATIVE_ARCH, NEON sur ARM.
+ */
+
+static const std::vector<TestStructure> LAYOUTS = AcceleratorChecker::structures(
+    {"bvh4", "bvh4-q8", "bvh4-q16", "bvh8", "bvh8-q8", "bvh8-q16"});
+
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "=== Test: Parcours BVH4 / BVH8          ===" << std::endl;
+    std::cout << "============================================" << std::endl;
+#if defined(__AVX__)
+    std::cout << "Test de dalles: AVX (BVH8), SSE (BVH4)" << std::endl;
+#elif defined(WIDE_BVH_SSE)
+    std::cout << "Test de dalles: SSE" << std::endl;
+#elif defined(WIDE_BVH_NEON)
+    std::cout << "Test de dalles: NEON" << std::endl;
+#else
+    std::cout << "Test de dalles: scalaire" << std::endl;
+#endif
+
+    const int rays = 20000;
+    bool all_passed = true;
+    Material material;
+
+    // Objets de scène: sphères, triangles et plans (hors de l'arbre)
+    RandomSceneSpec spec;
+    spec.spheres = 600;
+    spec.triangles = 600;
+    spec.planes = 2;
+    std::vector<SceneObject*> objects = AcceleratorChecker::createObjects(spec, 1, &material);
+
+    LinearAccelerator linear(false);
+    linear.build(objects);
+    std::unique_ptr<Accelerator> binary = AcceleratorChecker::create(AcceleratorChecker::structure("bvh2"));
+    binary->build(objects);
+    all_passed &= AcceleratorChecker::report("objets binary vs linear",
+                                             AcceleratorChecker::compare(*binary, linear, spec.extent, rays, 7));
+    for (const TestStructure& layout : LAYOUTS) {
+        std::unique_ptr<Accelerator> wide = AcceleratorChecker::create(layout);
+        wide->build(objects);
+        all_passed &= AcceleratorChecker::report(std::string("objets ") + layout.name + " vs binary",
+                                                 AcceleratorChecker::compare(*wide, *binary, spec.extent, rays, 7));
+        all_passed &= AcceleratorChecker::report(std::string("objets ") + layout.name + " vs linear",
+                                                 AcceleratorChecker::compare(*wide, linear, spec.extent, rays, 11));
+    }
+
+    // Primitives compactes: soupe de triangles indexés
+    TriangleMesh mesh;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> coordinate(-spec.extent, spec.extent);
+    std::uniform_real_distribution<double> offset(-0.5, 0.5);
+    for (int i = 0; i < 2000; i++) {
+        const Vector3 center(coordinate(rng), coordinate(rng), coordinate(rng));
+        uint32_t first = mesh.addVertex(center + Vector3(offset(rng), offset(rng), offset(rng)));
+        mesh.addVertex(center + Vector3(offset(rng), offset(rng), offset(rng)));
+        mesh.addVertex(center + Vector3(offset(rng), offset(rng), offset(rng)));
+        mesh.addTriangle(first, first + 1, first + 2);
+    }
+
+    LinearAccelerator meshLinear(false);
+    meshLinear.build(mesh);
+    std::unique_ptr<Accelerator> meshBinary = AcceleratorChecker::create(AcceleratorChecker::structure("bvh2"));
+    meshBinary->build(mesh);
+    all_passed &= AcceleratorChecker::report("mesh binary vs linear",
+                                             AcceleratorChecker::compare(*meshBinary, meshLinear, spec.extent, rays, 13));
+    for (const TestStructure& layout : LAYOUTS) {
+        std::unique_ptr<Accelerator> wide = AcceleratorChecker::create(layout);
+        wide->build(mesh);
+        all_passed &= AcceleratorChecker::report(std::string("mesh ") + layout.name + " vs binary",
+                                                 AcceleratorChecker::compare(*wide, *meshBinary, spec.extent, rays, 13));
+    }
+
+    for (SceneObject* object : objects) {
+        delete object;
+    }
+
+    std::cout << "============================================" << std::endl;
+    if (all_passed) {
+        std::cout << "✅ Parcours larges identiques au parcours binaire" << std::endl;
+        std::cout << "============================================" << std::endl;
+        return 0;
+    }
+    std::cerr << "❌ Parcours larges différents" << std::endl;
+    std::cout << "============================================" << std::endl;
+    return 1;
+}
@@ -0,0 +1,407 @@
+#include "AcceleratorChecker.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <utility>
+#include "Intersection.hpp"
+#include "Plane.hpp"
+#include "Scene.hpp"
+#include "Sphere.hpp"
+#include "Triangle.hpp"
+
+std::vector<SceneObject*> AcceleratorChecker::createObjects(const RandomSceneSpec& spec, unsigned int seed, Material* material) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coordinate(-spec.extent, spec.extent);
+    std::uniform_real_distribution<double> offset(-1.0, 1.0);
+    std::uniform_real_distribution<double> size(0.02 * spec.extent, 0.1 * spec.extent);
+    std::vector<SceneObject*> objects;
+
+    for (int i = 0; i < spec.spheres; i++) {
+        Sphere* sphere = new Sphere(size(rng));
+        sphere->transform.setPosition(Vector3(coordinate(rng), coordinate(rng), coordinate(rng)));
+        objects.push_back(sphere);
+    }
+    for (int i = 0; i < spec.triangles; i++) {
+        // Petits triangles autour d'un centre aléatoire, orientation aléatoire
+        const Vector3 center(coordinate(rng), coordinate(rng), coordinate(rng));
+        const double scale = size(rng);
+        Vector3 corners[3];
+        for (Vector3& corner : corners) {
+            corner = center + Vector3(offset(rng), offset(rng), offset(rng)) * scale;
+        }
+        objects.push_back(new Triangle(corners[0], corners[1], corners[2]));
+    }
+    for (int i = 0; i < spec.planes; i++) {
+        // Sous toute la scène, tournés vers le haut: les rayons n'en voient que la face avant
+        const Vector3 normal = Vector3(0.2 * offset(rng), 1.0, 0.2 * offset(rng)).normalize();
+        objects.push_back(new Plane(Vector3(0, -1.5 * spec.extent - i, 0), normal));
+    }
+
+    for (SceneObject* object : objects) {
+        object->material = material;
+        object->applyTransform();
+        object->calculateBoundingBox();
+    }
+    return objects;
+}
+
+namespace {
+
+Ray randomRay(std::mt19937& rng, int index, double extent) {
+    std::uniform_real_distribution<double> coordinate(-1.2 * extent, 1.2 * extent);
+    std::normal_distribution<double> gaussian(0.0, 1.0);
+    const Vector3 origin(coordinate(rng), coordinate(rng), coordinate(rng));
+
+    Vector3 direction;
+    switch (index % 8) {
+        case 0: {
+            // Le long d'un axe: deux composantes nulles
+            const double sign = (rng() & 1) ? 1.0 : -1.0;
+            const int axis = static_cast<int>(rng() % 3);
+            direction = Vector3(axis == 0 ? sign : 0, axis == 1 ? sign : 0, axis == 2 ? sign : 0);
+            break;
+        }
+        case 1: {
+            // Dans un plan des axes: une composante nulle
+            const int axis = static_cast<int>(rng() % 3);
+            direction = Vector3(axis == 0 ? 0 : gaussian(rng), axis == 1 ? 0 : gaussian(rng), axis == 2 ? 0 : gaussian(rng));
+            break;
+        }
+        default:
+            direction = Vector3(gaussian(rng), gaussian(rng), gaussian(rng));
+            break;
+    }
+    return Ray(origin, direction.normalize());
+}
+
+bool sameDistance(double a, double b) {
+    return std::fabs(a - b) <= 1e-9 * std::max(1.0, std::fabs(b));
+}
+
+template <typename Closest, typename Occluded>
+CheckResult compareQueries(Closest closest, Occluded occluded, double extent, int rays, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> shadowLength(0.0, 3.0 * extent);
+    const CullingType cullings[3] = {CULLING_BOTH, CULLING_FRONT, CULLING_BACK};
+    CheckResult result;
+    result.rays = rays;
+
+    for (int i = 0; i < rays; i++) {
+        Ray ray = randomRay(rng, i, extent);
+        const CullingType culling = cullings[(i / 8) % 3];
+
+        Intersection tested;
+        Intersection expected;
+        const bool testedHit = closest(0, ray, tested, culling);
+        const bool expectedHit = closest(1, ray, expected, culling);
+        if (expectedHit) {
+            result.hits++;
+        }
+        if (testedHit != expectedHit || (expectedHit && !sameDistance(tested.Distance, expected.Distance))) {
+            if (result.closestMismatches < 3) {
+                std::cerr << "  closest mismatch: ray " << ray.GetPosition() << " -> " << ray.GetDirection()
+                          << " hit " << testedHit << "/" << expectedHit
+                          << " distance^2 " << tested.Distance << "/" << expected.Distance << std::endl;
+            }
+            result.closestMismatches++;
+        }
+
+        const double maxDistance = shadowLength(rng);
+        const bool testedBlocked = occluded(0, ray, maxDistance);
+        const bool expectedBlocked = occluded(1, ray, maxDistance);
+        if (testedBlocked != expectedBlocked) {
+            if (result.occludedMismatches < 3) {
+                std::cerr << "  occluded mismatch: ray " << ray.GetPosition() << " -> " << ray.GetDirection()
+                          << " max " << maxDistance << " blocked " << testedBlocked << "/" << expectedBlocked << std::endl;
+            }
+            result.occludedMismatches++;
+        }
+    }
+    return result;
+}
+
+}  // namespace
+
+CheckResult AcceleratorChecker::compare(Accelerator& tested, Accelerator& reference, double extent, int rays, unsigned int seed) {
+    Accelerator* structures[2] = {&tested, &reference};
+    return compareQueries(
+        [&](int which, Ray& ray, Intersection& hit, CullingType culling) {
+            return structures[which]->closestIntersection(ray, hit, culling);
+        },
+        [&](int which, Ray& ray, double maxDistance) {
+            return structures[which]->occluded(ray, maxDistance);
+        },
+        extent, rays, seed);
+}
+
+CheckResult AcceleratorChecker::compare(Scene& tested, Scene& reference, double extent, int rays, unsigned int seed) {
+    Scene* scenes[2] = {&tested, &reference};
+    return compareQueries(
+        [&](int which, Ray& ray, Intersection& hit, CullingType culling) {
+            return scenes[which]->closestIntersection(ray, hit, culling);
+        },
+        [&](int which, Ray& ray, double maxDistance) {
+            return scenes[which]->occluded(ray, maxDistance);
+        },
+        extent, rays, seed);
+}
+
+AcceleratorSettings TestStructure::settings() const {
+    AcceleratorSettings settings;
+    settings.type = type;
+    settings.builder = builder;
+    settings.bvhWidth = width;
+    settings.bvhQuantization = quantization_bits;
+    return settings;
+}
+
+const std::vector<TestStructure>& AcceleratorChecker::structures() {
+    static const std::vector<TestStructure> table = {
+        {"none", ACCELERATOR_NONE, BUILD_SAH, 2, 0},
+        {"aabb", ACCELERATOR_AABB, BUILD_SAH, 2, 0},
+        {"bvh2", ACCELERATOR_BVH, BUILD_SAH, 2, 0},
+        {"bvh4", ACCELERATOR_BVH, BUILD_SAH, 4, 0},
+        {"bvh8", ACCELERATOR_BVH, BUILD_SAH, 8, 0},
+        {"bvh4-q8", ACCELERATOR_BVH, BUILD_SAH, 4, 8},
+        {"bvh4-q16", ACCELERATOR_BVH, BUILD_SAH, 4, 16},
+        {"bvh8-q8", ACCELERATOR_BVH, BUILD_SAH, 8, 8},
+        {"bvh8-q16", ACCELERATOR_BVH, BUILD_SAH, 8, 16},
+        {"median", ACCELERATOR_BVH, BUILD_MEDIAN, 4, 0},
+        {"lbvh", ACCELERATOR_BVH, BUILD_LBVH, 4, 0},
+        {"sbvh", ACCELERATOR_BVH, BUILD_SBVH, 2, 0},
+        {"grid", ACCELERATOR_GRID, BUILD_SAH, 2, 0},
+        {"kdtree", ACCELERATOR_KDTREE, BUILD_SAH, 2, 0},
+    };
+    return table;
+}
+
+const TestStructure& AcceleratorChecker::structure(const std::string& name) {
+    for (const TestStructure& entry : structures()) {
+        if (name == entry.name) {
+            return entry;
+        }
+    }
+    std::cerr << "❌ Structure de test inconnue: " << name << std::endl;
+    std::exit(1);
+}
+
+std::vector<TestStructure> AcceleratorChecker::structures(std::initializer_list<const char*> names) {
+    std::vector<TestStructure> out;
+    for (const char* name : names) {
+        out.push_back(structure(name));
+    }
+    return out;
+}
+
+std::unique_ptr<Accelerator> AcceleratorChecker::create(const TestStructure& structure) {
+    return Accelerator::create(structure.settings());
+}
+
+void AcceleratorChecker::fillScene(Scene& scene, const RandomSceneSpec& spec, unsigned int seed, Material* material) {
+    for (SceneObject* object : createObjects(spec, seed, material)) {
+        scene.add(object);
+    }
+}
+
+void AcceleratorChecker::moveObjects(Scene& scene, double extent, unsigned int seed, bool spheresOnly) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> offset(-0.2 * extent, 0.2 * extent);
+    for (SceneObject* object : scene.getObjects()) {
+        if (!spheresOnly || dynamic_cast<Sphere*>(object) != nullptr) {
+            const Vector3 position = object->transform.getPosition();
+            object->transform.setPosition(position + Vector3(offset(rng), offset(rng), offset(rng)));
+        }
+    }
+}
+
+namespace {
+
+// Ajoute le triangle abc, retourné si besoin pour que sa face avant ne regarde pas vers center
+void addOutwardTriangle(TriangleMesh& mesh, uint32_t a, uint32_t b, uint32_t c, const Vector3& center) {
+    const Vector3 pa = mesh.vertex(a);
+    const Vector3 normal = (mesh.vertex(b) - pa).cross(mesh.vertex(c) - pa);
+    if (normal.dot(pa - center) < 0) {
+        std::swap(b, c);
+    }
+    mesh.addTriangle(a, b, c);
+}
+
+}  // namespace
+
+void AcceleratorChecker::addTessellatedCube(TriangleMesh& mesh, int divisions, double half) {
+    const double step = 2.0 * half / divisions;
+    for (int axis = 0; axis < 3; axis++) {
+        for (int side = 0; side < 2; side++) {
+            // Face axis = +/-half, sommets sur la grille régulière des deux autres axes
+            const int u = (axis + 1) % 3;
+            const int v = (axis + 2) % 3;
+            const uint32_t first = static_cast<uint32_t>(mesh.vertexCount());
+            for (int i = 0; i <= divisions; i++) {
+                for (int j = 0; j <= divisions; j++) {
+                    double p[3];
+                    p[axis] = side == 0 ? -half : half;
+                    p[u] = -half + i * step;
+                    p[v] = -half + j * step;
+                    mesh.addVertex(Vector3(p[0], p[1], p[2]));
+                }
+            }
+            auto index = [&](int i, int j) { return first + static_cast<uint32_t>(i * (divisions + 1) + j); };
+            for (int i = 0; i < divisions; i++) {
+                for (int j = 0; j < divisions; j++) {
+                    addOutwardTriangle(mesh, index(i, j), index(i + 1, j), index(i + 1, j + 1), Vector3());
+                    addOutwardTriangle(mesh, index(i, j), index(i + 1, j + 1), index(i, j + 1), Vector3());
+                }
+            }
+        }
+    }
+}
+
+void AcceleratorChecker::addIcosphere(TriangleMesh& mesh, int subdivisions, double radius) {
+    // Icosaèdre, puis chaque triangle coupé en quatre, nouveaux sommets ramenés sur la sphère
+    const double phi = (1.0 + std::sqrt(5.0)) / 2.0;
+    const double corners[12][3] = {{-1, phi, 0}, {1, phi, 0}, {-1, -phi, 0}, {1, -phi, 0},
+                                   {0, -1, phi}, {0, 1, phi}, {0, -1, -phi}, {0, 1, -phi},
+                                   {phi, 0, -1}, {phi, 0, 1}, {-phi, 0, -1}, {-phi, 0, 1}};
+    std::vector<Vector3> vertices;
+    for (const auto& corner : corners) {
+        vertices.push_back(Vector3(corner[0], corner[1], corner[2]).normalize() * radius);
+    }
+    std::vector<uint32_t> faces = {0, 11, 5, 0, 5, 1, 0, 1, 7, 0, 7, 10, 0, 10, 11, 1, 5, 9, 5, 11, 4,
+                                   11, 10, 2, 10, 7, 6, 7, 1, 8, 3, 9, 4, 3, 4, 2, 3, 2, 6, 3, 6, 8,
+                                   3, 8, 9, 4, 9, 5, 2, 4, 11, 6, 2, 10, 8, 6, 7, 9, 8, 1};
+
+    for (int level = 0; level < subdivisions; level++) {
+        std::map<std::pair<uint32_t, uint32_t>, uint32_t> midpoints;
+        auto midpoint = [&](uint32_t a, uint32_t b) {
+            const std::pair<uint32_t, uint32_t> key(std::min(a, b), std::max(a, b));
+            auto found = midpoints.find(key);
+            if (found != midpoints.end()) {
+                return found->second;
+            }
+            vertices.push_back(((vertices[a] + vertices[b]) * 0.5).normalize() * radius);
+            const uint32_t index = static_cast<uint32_t>(vertices.size() - 1);
+            midpoints[key] = index;
+            return index;
+        };
+        std::vector<uint32_t> next;
+        for (size_t f = 0; f < faces.size(); f += 3) {
+            const uint32_t a = faces[f];
+            const uint32_t b = faces[f + 1];
+            const uint32_t c = faces[f + 2];
+            const uint32_t ab = midpoint(a, b);
+            const uint32_t bc = midpoint(b, c);
+            const uint32_t ca = midpoint(c, a);
+            const uint32_t split[12] = {a, ab, ca, b, bc, ab, c, ca, bc, ab, bc, ca};
+            next.insert(next.end(), split, split + 12);
+        }
+        faces.swap(next);
+    }
+
+    const uint32_t first = static_cast<uint32_t>(mesh.vertexCount());
+    for (const Vector3& vertex : vertices) {
+        mesh.addVertex(vertex);
+    }
+    for (size_t f = 0; f < faces.size(); f += 3) {
+        addOutwardTriangle(mesh, first + faces[f], first + faces[f + 1], first + faces[f + 2], Vector3());
+    }
+}
+
+std::vector<SceneObject*> AcceleratorChecker::createTriangles(const TriangleMesh& mesh, Material* material) {
+    std::vector<SceneObject*> objects;
+    for (uint32_t prim = 0; prim < mesh.size(); prim++) {
+        Vector3 a, b, c;
+        mesh.corners(prim, a, b, c);
+        Triangle* triangle = new Triangle(a, b, c);
+        triangle->material = material;
+        triangle->applyTransform();
+        triangle->calculateBoundingBox();
+        objects.push_back(triangle);
+    }
+    return objects;
+}
+
+std::vector<Ray> AcceleratorChecker::edgeRays(const TriangleMesh& mesh, const Vector3& origin, int samplesPerEdge) {
+    std::vector<Ray> rays;
+    for (uint32_t prim = 0; prim < mesh.size(); prim++) {
+        Vector3 corners[3];
+        mesh.corners(prim, corners[0], corners[1], corners[2]);
+        for (int edge = 0; edge < 3; edge++) {
+            const Vector3& from = corners[edge];
+            const Vector3& to = corners[(edge + 1) % 3];
+            for (int k = 0; k < samplesPerEdge; k++) {
+                const double t = static_cast<double>(k) / samplesPerEdge;
+                const Vector3 target = from + (to - from) * t;
+                rays.push_back(Ray(origin, (target - origin).normalize()));
+            }
+        }
+    }
+    return rays;
+}
+
+std::vector<Ray> AcceleratorChecker::gridAxisRays(int divisions, double half) {
+    std::vector<Ray> rays;
+    const double step = 2.0 * half / divisions;
+    for (int axis = 0; axis < 3; axis++) {
+        const int u = (axis + 1) % 3;
+        const int v = (axis + 2) % 3;
+        for (int i = 1; i < divisions; i++) {
+            for (int j = 1; j < divisions; j++) {
+                for (int sign = -1; sign <= 1; sign += 2) {
+                    double p[3];
+                    double d[3] = {0, 0, 0};
+                    p[axis] = 0;
+                    p[u] = -half + i * step;
+                    p[v] = -half + j * step;
+                    d[axis] = sign;
+                    rays.push_back(Ray(Vector3(p[0], p[1], p[2]), Vector3(d[0], d[1], d[2])));
+                }
+            }
+        }
+    }
+    return rays;
+}
+
+LeakResult AcceleratorChecker::countLeaks(Accelerator& accelerator, std::vector<Ray>& rays, double maxDistance) {
+    LeakResult result;
+    result.rays = rays.size();
+    for (Ray& ray : rays) {
+        Intersection hit;
+        const bool closest = accelerator.closestIntersection(ray, hit, CULLING_BOTH) &&
+                             accelerator.closestIntersection(ray, hit, CULLING_BACK);
+        if (!closest) {
+            if (result.closestLeaks < 3) {
+                std::cerr << "  leak: ray " << ray.GetPosition() << " -> " << ray.GetDirection() << std::endl;
+            }
+            result.closestLeaks++;
+        }
+        if (!accelerator.occluded(ray, maxDistance)) {
+            if (result.occludedLeaks < 3) {
+                std::cerr << "  shadow leak: ray " << ray.GetPosition() << " -> " << ray.GetDirection() << std::endl;
+            }
+            result.occludedLeaks++;
+        }
+    }
+    return result;
+}
+
+bool AcceleratorChecker::report(const std::string& label, const CheckResult& result) {
+    if (result.passed()) {
+        std::cout << "✅ " << label << ": " << result.rays << " rays (" << result.hits << " hits) identical" << std::endl;
+    } else {
+        std::cerr << "❌ " << label << ": " << result.closestMismatches << " closest and "
+                  << result.occludedMismatches << " shadow mismatches out of " << result.rays << " rays" << std::endl;
+    }
+    return result.passed();
+}
+
+bool AcceleratorChecker::report(const std::string& label, const LeakResult& result) {
+    if (result.passed()) {
+        std::cout << "✅ " << label << ": " << result.rays << " rays, no leak" << std::endl;
+    } else {
+        std::cerr << "❌ " << label << ": " << result.closestLeaks << " rays and " << result.occludedLeaks
+                  << " shadow rays leaked out of " << result.rays << std::endl;
+    }
+    return result.passed();
+}
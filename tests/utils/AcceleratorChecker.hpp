@@ -0,0 +1,149 @@
+#pragma once
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Accelerator.hpp"
+#include "Material.hpp"
+#include "SceneObject.hpp"
+#include "TriangleMesh.hpp"
+
+class Scene;
+
+/**
+ * Scènes et rayons aléatoires pour comparer une structure au test linéaire
+ *
+ * Chaque requête de la structure testée doit donner la même réponse qu'une
+ * simple boucle sur toutes les primitives: même impact ou non, même distance,
+ * même occultation. Les rayons partent en position quelconque et le long des
+ * axes (composantes nulles, inverse infini), point faible habituel des tests
+ * de tranches (slab).
+ */
+
+struct RandomSceneSpec {
+    int spheres = 0;
+    int triangles = 0;
+    int planes = 0;          // Plans formant un sol sous tous les autres objets
+    double extent = 10.0;    // Objets contenus dans [-extent, extent]^3
+};
+
+struct CheckResult {
+    size_t rays = 0;
+    size_t hits = 0;                 // Rayons qui touchent un objet (référence)
+    size_t closestMismatches = 0;
+    size_t occludedMismatches = 0;
+
+    bool passed() const { return closestMismatches == 0 && occludedMismatches == 0; }
+};
+
+struct LeakResult {
+    size_t rays = 0;
+    size_t closestLeaks = 0;   // Rayons partis de l'intérieur qui ont manqué le mesh fermé
+    size_t occludedLeaks = 0;  // Rayons d'ombre qui l'ont traversé
+
+    bool passed() const { return closestLeaks == 0 && occludedLeaks == 0; }
+};
+
+/**
+ * Structure testée: nom affiché et réglages (table partagée, voir AcceleratorChecker::structures)
+ */
+struct TestStructure {
+    const char* name;
+    AcceleratorType type;
+    BSPBuildStrategy builder;
+    int width;
+    int quantization_bits;
+
+    AcceleratorSettings settings() const;
+};
+
+class AcceleratorChecker {
+public:
+    /**
+     * Toutes les structures testées: none, aabb, bvh2, bvh4, bvh8, leurs variantes
+     * compressées (bvh4-q8, bvh4-q16, bvh8-q8, bvh8-q16), median, lbvh, sbvh, grid, kdtree
+     */
+    static const std::vector<TestStructure>& structures();
+
+    /**
+     * Entrées de la table choisies par nom (le test s'arrête sur un nom inconnu)
+     */
+    static const TestStructure& structure(const std::string& name);
+    static std::vector<TestStructure> structures(std::initializer_list<const char*> names);
+
+    /**
+     * Structure vide, configurée avec les réglages de l'entrée
+     */
+    static std::unique_ptr<Accelerator> create(const TestStructure& structure);
+
+    /**
+     * Ajoute à la scène (qui en devient propriétaire) les objets de createObjects
+     */
+    static void fillScene(Scene& scene, const RandomSceneSpec& spec, unsigned int seed, Material* material);
+
+    /**
+     * Déplace au hasard les objets de la scène (au plus 0.2 * extent par axe). Une même
+     * graine donne les mêmes déplacements à deux scènes remplies de la même façon.
+     * @param spheresOnly Ne déplacer que les sphères
+     */
+    static void moveObjects(Scene& scene, double extent, unsigned int seed, bool spheresOnly);
+
+    /**
+     * Crée des objets prêts (transformation appliquée, boîte englobante calculée).
+     * L'appelant en devient propriétaire; une même graine donne les mêmes objets.
+     */
+    static std::vector<SceneObject*> createObjects(const RandomSceneSpec& spec, unsigned int seed, Material* material);
+
+    /**
+     * Lance des rayons aléatoires dans les deux structures (déjà construites) et
+     * compare impacts les plus proches et requêtes d'ombre. Les rayons partent de
+     * la région de la scène.
+     */
+    static CheckResult compare(Accelerator& tested, Accelerator& reference, double extent, int rays, unsigned int seed);
+
+    /**
+     * Même comparaison par les requêtes de Scene (deux scènes après prepare())
+     */
+    static CheckResult compare(Scene& tested, Scene& reference, double extent, int rays, unsigned int seed);
+
+    /**
+     * Meshes fermés aux triangles tournés vers l'extérieur: tout rayon parti de
+     * l'intérieur doit les toucher. Le cube a divisions x divisions quadrilatères
+     * par face, sur une grille régulière (coordonnées des sommets exactes en
+     * binaire quand divisions est une puissance de deux).
+     */
+    static void addTessellatedCube(TriangleMesh& mesh, int divisions, double half);
+    static void addIcosphere(TriangleMesh& mesh, int subdivisions, double radius);
+
+    /**
+     * Objets Triangle aux mêmes sommets que le mesh (l'appelant en devient propriétaire)
+     */
+    static std::vector<SceneObject*> createTriangles(const TriangleMesh& mesh, Material* material);
+
+    /**
+     * Rayons partis de origin, visant exactement chaque sommet du mesh et
+     * samplesPerEdge points le long de chaque arête (sommets compris)
+     */
+    static std::vector<Ray> edgeRays(const TriangleMesh& mesh, const Vector3& origin, int samplesPerEdge);
+
+    /**
+     * Rayons parallèles aux axes (deux sens par axe) partis du plan médian d'un cube
+     * aligné sur la grille, sur chaque ligne intérieure de la grille: ils suivent
+     * exactement les plans de coupe et touchent arêtes et sommets partagés
+     */
+    static std::vector<Ray> gridAxisRays(int divisions, double half);
+
+    /**
+     * Lance des rayons qui doivent tous toucher un mesh fermé (impact le plus proche,
+     * avec les deux cullings qui gardent la face intérieure, et ombre jusqu'à maxDistance)
+     */
+    static LeakResult countLeaks(Accelerator& accelerator, std::vector<Ray>& rays, double maxDistance);
+
+    /**
+     * Affiche une ligne pour le résultat
+     * @return result.passed()
+     */
+    static bool report(const std::string& label, const CheckResult& result);
+    static bool report(const std::string& label, const LeakResult& result);
+};
@@ -97,6 +97,91 @@ BenchmarkMetrics BenchmarkRunner::runBenchmark(
     return metrics;
 }
 
+BuilderMetrics BenchmarkRunner::runBuilderBenchmark(
+    const std::string& scene_path,
+    const std::string& builder,
+    int iterations) {
+    
+    BuilderMetrics metrics;
+    metrics.builder = builder;
+    metrics.passed = false;
+    
+    try {
+        auto [scene, camera, image] = SceneLoader::Load(scene_path, builder);
+        
+        if (!scene || !camera || !image) {
+            metrics.error_message = "Failed to load scene";
+            return metrics;
+        }
+        
+        measureBuildAndRender(*scene, *camera, *image, iterations, metrics);
+        
+        delete scene;
+        delete camera;
+        delete image;
+        
+    } catch (const std::exception& e) {
+        metrics.error_message = std::string("Exception: ") + e.what();
+        std::cerr << "Error during benchmark: " << metrics.error_message << std::endl;
+    }
+    
+    return metrics;
+}
+
+BuilderMetrics BenchmarkRunner::runSettingsBenchmark(
+    const std::string& scene_path,
+    const std::string& label,
+    const std::map<std::string, std::string>& overrides,
+    int iterations) {
+    
+    BuilderMetrics metrics;
+    metrics.builder = label;
+    metrics.passed = false;
+    
+    try {
+        auto [scene, camera, image] = SceneLoader::Load(scene_path, overrides);
+        
+        if (!scene || !camera || !image) {
+            metrics.error_message = "Failed to load scene";
+            return metrics;
+        }
+        
+        measureBuildAndRender(*scene, *camera, *image, iterations, metrics);
+        
+        delete scene;
+        delete camera;
+        delete image;
+        
+    } catch (const std::exception& e) {
+        metrics.error_message = std::string("Exception: ") + e.what();
+        std::cerr << "Error during benchmark: " << metrics.error_message << std::endl;
+    }
+    
+    return metrics;
+}
+
+void BenchmarkRunner::measureBuildAndRender(Scene& scene, Camera& camera, Image& image,
+                                            int iterations, BuilderMetrics& metrics) {
+    // Mesh trees are only built by the first Scene::prepare, so the build
+    // time is taken from the first iteration; render time is averaged
+    double first_build = 0.0;
+    double total_render = 0.0;
+    for (int i = 0; i < iterations; i++) {
+        auto begin = std::chrono::high_resolution_clock::now();
+        camera.render(image, scene);
+        auto end = std::chrono::high_resolution_clock::now();
+        
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin);
+        if (i == 0) first_build = scene.buildTime;
+        total_render += elapsed.count() * 1e-9 - scene.buildTime;
+    }
+    
+    metrics.build_ms = first_build * 1000.0;
+    metrics.avg_render_seconds = total_render / iterations;
+    metrics.samples_per_second = (double)image.width * image.height * iterations / total_render;
+    metrics.passed = true;
+}
+
 void BenchmarkRunner::saveMetrics(const BenchmarkMetrics& metrics,
                                  const std::string& output_path) {
     json j;
@@ -1,4 +1,5 @@
 #pragma once
+#include <map>
 #include <string>
 #include <vector>
 #include <chrono>
@@ -18,6 +19,16 @@ struct BenchmarkMetrics {
     std::string error_message;
 };
 
+// Build cost vs. traversal cost of one tree builder on one scene
+struct BuilderMetrics {
+    std::string builder;       // "median", "sah", "lbvh", "sbvh", "grid" (uniform grid), "kdtree", or a settings label
+    double build_ms;           // First Scene::prepare (bounds + scene and mesh trees)
+    double avg_render_seconds; // Rendering only: traversal + shading
+    double samples_per_second;
+    bool passed;
+    std::string error_message;
+};
+
 class BenchmarkRunner {
 public:
     // Execute a rendering test with multiple iterations
@@ -28,6 +39,21 @@ public:
         int iterations = 3
     );
     
+    // Render a scene with the given tree builder, timing build and render separately
+    static BuilderMetrics runBuilderBenchmark(
+        const std::string& scene_path,
+        const std::string& builder,
+        int iterations = 3
+    );
+    
+    // Same measurement with scene keys overridden (e.g. "typedPrimitives"), reported under label
+    static BuilderMetrics runSettingsBenchmark(
+        const std::string& scene_path,
+        const std::string& label,
+        const std::map<std::string, std::string>& overrides,
+        int iterations = 3
+    );
+    
     // Save metrics to JSON file
     static void saveMetrics(const BenchmarkMetrics& metrics,
                           const std::string& output_path);
@@ -38,4 +64,8 @@ public:
     
 private:
     static double computeStdDev(const std::vector<double>& times, double avg);
+    
+    // Renders a loaded scene iterations times and fills the build / render timings
+    static void measureBuildAndRender(Scene& scene, Camera& camera, Image& image,
+                                      int iterations, BuilderMetrics& metrics);
 };
@@ -0,0 +1,66 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "BenchmarkRunner.hpp"
+
+// Compare the tree builders (and the uniform grid / kd-tree) on the same scenes: build time vs. traversal (render) time
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0] << " <scene.json> [more scenes...] [--iterations N]" << std::endl;
+        return 1;
+    }
+    
+    int iterations = 3;
+    std::vector<std::string> scenes;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--iterations" && i + 1 < argc) {
+            iterations = std::stoi(argv[++i]);
+        } else {
+            scenes.push_back(arg);
+        }
+    }
+    
+    const std::vector<std::string> builders = {"median", "sah", "lbvh", "sbvh", "grid", "kdtree"};
+    bool all_passed = true;
+    
+    for (const auto& scene_path : scenes) {
+        std::vector<BuilderMetrics> results;
+        for (const auto& builder : builders) {
+            results.push_back(BenchmarkRunner::runBuilderBenchmark(scene_path, builder, iterations));
+        }
+        
+        // Traversal cost is reported relative to the SAH tree
+        double sah_render = results[1].passed ? results[1].avg_render_seconds : 0.0;
+        
+        std::cout << "\n" << std::string(70, '=') << std::endl;
+        std::cout << "Builders: " << scene_path << " (" << iterations << " iterations)" << std::endl;
+        std::cout << std::string(70, '=') << std::endl;
+        std::cout << std::left << std::setw(10) << "Builder"
+                  << std::right << std::setw(14) << "Build (ms)"
+                  << std::setw(14) << "Render (s)"
+                  << std::setw(16) << "Samples/sec"
+                  << std::setw(14) << "vs. SAH" << std::endl;
+        std::cout << std::string(70, '-') << std::endl;
+        
+        for (const auto& m : results) {
+            std::cout << std::left << std::setw(10) << m.builder << std::right;
+            if (!m.passed) {
+                std::cout << "  FAILED: " << m.error_message << std::endl;
+                all_passed = false;
+                continue;
+            }
+            std::cout << std::setw(14) << std::fixed << std::setprecision(2) << m.build_ms
+                      << std::setw(14) << std::setprecision(3) << m.avg_render_seconds
+                      << std::setw(16) << std::setprecision(0) << m.samples_per_second;
+            if (sah_render > 0) {
+                std::cout << std::setw(13) << std::setprecision(2) << m.avg_render_seconds / sah_render << "x";
+            }
+            std::cout << std::endl;
+        }
+        std::cout << std::string(70, '=') << std::endl;
+    }
+    
+    return all_passed ? 0 : 1;
+}
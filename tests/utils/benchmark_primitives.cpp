@@ -0,0 +1,78 @@
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <string>
+#include <vector>
+#include "BenchmarkRunner.hpp"
+
+// Compare virtual SceneObject leaves with per-type primitive storage (typedPrimitives),
+// with and without flattened meshes, on mixed scenes (default: scenes/all.json)
+int main(int argc, char* argv[]) {
+    int iterations = 3;
+    std::vector<std::string> scenes;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--iterations" && i + 1 < argc) {
+            iterations = std::stoi(argv[++i]);
+        } else if (arg == "--help") {
+            std::cout << "Usage: " << argv[0] << " [scene.json...] [--iterations N]" << std::endl;
+            return 0;
+        } else {
+            scenes.push_back(arg);
+        }
+    }
+    if (scenes.empty()) {
+        scenes.push_back("scenes/all.json");
+    }
+
+    struct Variant {
+        std::string label;
+        std::map<std::string, std::string> overrides;
+        int reference;  // Index of the variant it is compared with
+    };
+    const std::vector<Variant> variants = {
+        {"virtual", {}, 0},
+        {"typed", {{"typedPrimitives", "true"}}, 0},
+        {"flat", {{"flattenMeshes", "true"}}, 2},
+        {"flat+typed", {{"flattenMeshes", "true"}, {"typedPrimitives", "true"}}, 2}};
+    bool all_passed = true;
+
+    for (const auto& scene_path : scenes) {
+        std::vector<BuilderMetrics> results;
+        for (const auto& variant : variants) {
+            results.push_back(BenchmarkRunner::runSettingsBenchmark(scene_path, variant.label, variant.overrides, iterations));
+        }
+
+        std::cout << "\n" << std::string(72, '=') << std::endl;
+        std::cout << "Primitive storage: " << scene_path << " (" << iterations << " iterations)" << std::endl;
+        std::cout << std::string(72, '=') << std::endl;
+        std::cout << std::left << std::setw(12) << "Storage"
+                  << std::right << std::setw(14) << "Build (ms)"
+                  << std::setw(14) << "Render (s)"
+                  << std::setw(16) << "Samples/sec"
+                  << std::setw(16) << "Speedup" << std::endl;
+        std::cout << std::string(72, '-') << std::endl;
+
+        for (size_t i = 0; i < results.size(); i++) {
+            const BuilderMetrics& m = results[i];
+            std::cout << std::left << std::setw(12) << m.builder << std::right;
+            if (!m.passed) {
+                std::cout << "  FAILED: " << m.error_message << std::endl;
+                all_passed = false;
+                continue;
+            }
+            std::cout << std::setw(14) << std::fixed << std::setprecision(2) << m.build_ms
+                      << std::setw(14) << std::setprecision(3) << m.avg_render_seconds
+                      << std::setw(16) << std::setprecision(0) << m.samples_per_second;
+            const BuilderMetrics& reference = results[variants[i].reference];
+            if (variants[i].reference != static_cast<int>(i) && reference.passed && m.avg_render_seconds > 0) {
+                std::cout << std::setw(9) << std::setprecision(2) << reference.avg_render_seconds / m.avg_render_seconds
+                          << "x vs. " << reference.builder;
+            }
+            std::cout << std::endl;
+        }
+        std::cout << std::string(72, '=') << std::endl;
+    }
+
+    return all_passed ? 0 : 1;
+}
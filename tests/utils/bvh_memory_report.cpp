@@ -0,0 +1,111 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "MeshGeometry.hpp"
+#include "Triangle.hpp"
+
+// Node layout of the original pointer-based tree, kept here for comparison only
+struct PointerBSPNode {
+    AABB boundingBox;
+    PointerBSPNode* left = nullptr;
+    PointerBSPNode* right = nullptr;
+    std::vector<SceneObject*> objects;
+    bool isLeaf = false;
+};
+
+struct Layout {
+    const char* name;
+    int width;
+    int quantization_bits;
+};
+
+// Memory used by the triangle tree of each mesh, for every traversal layout
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0] << " <mesh.obj> [more meshes...]" << std::endl;
+        return 1;
+    }
+    
+    const std::vector<Layout> layouts = {
+        {"binary", 2, 0},
+        {"bvh4", 4, 0},
+        {"bvh4-q16", 4, 16},
+        {"bvh4-q8", 4, 8},
+        {"bvh8", 8, 0},
+        {"bvh8-q16", 8, 16},
+        {"bvh8-q8", 8, 8},
+    };
+    
+    for (int i = 1; i < argc; i++) {
+        MeshGeometry geometry;
+        AcceleratorSettings bvh;
+        bvh.type = ACCELERATOR_BVH;  // Whatever the build's default accelerator is
+        geometry.setAcceleratorSettings(bvh);
+        geometry.loadFromObj(argv[i]);
+        geometry.prepare();
+        geometry.build();  // Built lazily by the first ray otherwise
+        
+        const size_t triangles = geometry.getTriangleCount();
+        if (triangles == 0) {
+            std::cerr << "No triangles loaded from: " << argv[i] << std::endl;
+            continue;
+        }
+        
+        std::cout << "\n" << std::string(94, '=') << std::endl;
+        std::cout << "BVH memory: " << argv[i] << " (" << triangles << " triangles)" << std::endl;
+        std::cout << std::string(94, '=') << std::endl;
+        std::cout << std::left << std::setw(16) << "Layout"
+                  << std::right << std::setw(10) << "Nodes"
+                  << std::setw(12) << "Bytes/node"
+                  << std::setw(14) << "Tree (KiB)"
+                  << std::setw(14) << "Bytes/tri"
+                  << std::setw(12) << "vs. ptr"
+                  << std::setw(16) << "Resident (KiB)" << std::endl;
+        std::cout << std::string(94, '-') << std::endl;
+        
+        // The pointer-based tree had one heap node per binary node, plus the leaf vectors
+        geometry.setLayout(2, 0);
+        const BSPMemoryStats binary = geometry.getMemoryStats();
+        const double pointer_bytes = binary.binaryNodeCount * sizeof(PointerBSPNode) +
+                                     triangles * sizeof(SceneObject*);
+        
+        std::cout << std::fixed << std::left << std::setw(16) << "pointer (orig.)" << std::right
+                  << std::setw(10) << binary.binaryNodeCount
+                  << std::setw(12) << sizeof(PointerBSPNode)
+                  << std::setw(14) << std::setprecision(1) << pointer_bytes / 1024.0
+                  << std::setw(14) << std::setprecision(1) << pointer_bytes / triangles
+                  << std::setw(11) << std::setprecision(2) << 1.0 << "x"
+                  << std::setw(16) << std::setprecision(1) << pointer_bytes / 1024.0 << std::endl;
+        
+        for (const auto& layout : layouts) {
+            geometry.setLayout(layout.width, layout.quantization_bits);
+            const BSPMemoryStats stats = geometry.getMemoryStats();
+            
+            // Bytes touched by traversal: the traversal nodes and the primitive indices
+            const double tree_bytes = stats.traversalNodeCount * stats.traversalNodeSize + stats.primIndexBytes;
+            std::cout << std::left << std::setw(16) << layout.name << std::right
+                      << std::setw(10) << stats.traversalNodeCount
+                      << std::setw(12) << stats.traversalNodeSize
+                      << std::setw(14) << std::setprecision(1) << tree_bytes / 1024.0
+                      << std::setw(14) << std::setprecision(1) << tree_bytes / triangles
+                      << std::setw(11) << std::setprecision(2) << pointer_bytes / tree_bytes << "x"
+                      << std::setw(16) << std::setprecision(1) << stats.totalBytes() / 1024.0 << std::endl;
+        }
+        std::cout << std::string(94, '=') << std::endl;
+        std::cout << "Resident includes the binary nodes kept for refit (released by quantized layouts)." << std::endl;
+
+        // Triangle storage: one heap Triangle (a full SceneObject) per face before indexed meshes
+        const double object_bytes = triangles * (sizeof(Triangle) + sizeof(Triangle*));
+        const double indexed_bytes = geometry.getTriangleMemory();
+        std::cout << std::fixed << std::setprecision(1)
+                  << "Triangles: " << indexed_bytes / 1024.0 << " KiB indexed ("
+                  << indexed_bytes / triangles << " bytes/tri, "
+                  << geometry.getTriangles().vertexCount() << " shared vertices) vs. "
+                  << object_bytes / 1024.0 << " KiB as Triangle objects ("
+                  << object_bytes / triangles << " bytes/tri, " << std::setprecision(2)
+                  << object_bytes / indexed_bytes << "x)" << std::endl;
+    }
+    
+    return 0;
+}